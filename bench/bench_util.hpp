@@ -0,0 +1,26 @@
+#pragma once
+
+// Allocation counting shared by the benchmark executables. Each executable is
+// a single translation unit, which is the only one to include this file, so
+// the replacement operator new/delete below are defined once per program.
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Every allocation of the process, from any thread
+static std::atomic<size_t> allocations{0};
+
+void* operator new(size_t bytes) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* p = std::malloc(bytes ? bytes : 1)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void* operator new[](size_t bytes) { return operator new(bytes); }
+void  operator delete(void* p) noexcept { std::free(p); }
+void  operator delete[](void* p) noexcept { std::free(p); }
+void  operator delete(void* p, size_t) noexcept { std::free(p); }
+void  operator delete[](void* p, size_t) noexcept { std::free(p); }
@@ -0,0 +1,274 @@
+// Synthetic stress scenes for the simulation systems. Each scene fills a room
+// with a given number of fish packs, sharks, crates and urchin needles, then
+// times AI, physics and collisions over a fixed number of frames and counts
+// the heap allocations each of them makes. Runs headless, like
+// `bermuda --headless`.
+//
+//   bermuda_bench [--frames N] [--seed S] [entity counts...]
+//
+// With no counts the scenes hold 100, 1000 and 10000 entities. Afterwards a
+// pack of fish is spawned into a fresh room, and the bench fails if that
+// spawn allocates.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <vector>
+
+#include "ai_system.hpp"
+#include "bench_util.hpp"
+#include "collision_system.hpp"
+#include "command_line.hpp"
+#include "ecs_command_buffer.hpp"
+#include "enemy_factories.hpp"
+#include "jobs.hpp"
+#include "level_builder.hpp"
+#include "level_system.hpp"
+#include "map_factories.hpp"
+#include "physics_system.hpp"
+#include "random.hpp"
+#include "render_system.hpp"
+#include "room_builder.hpp"
+#include "saving_system.hpp"
+#include "spawning.hpp"
+#include "tiny_ecs_registry.hpp"
+#include "world_system.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+// Shares of a scene's entities, the rest are fish
+#define BENCH_SHARK_SHARE 0.1f
+#define BENCH_CRATE_SHARE 0.1f
+#define BENCH_NEEDLE_SHARE 0.3f
+#define BENCH_FISH_PACK_SIZE 8
+#define BENCH_WARMUP_FRAMES 30
+
+// The pack spawned after a room change, and the packs of the busy room before
+#define BENCH_CHECK_PACK_SIZE 10
+#define BENCH_CHECK_BUSY_PACKS 100
+
+// Time and allocations spent in one system over a scene
+struct SystemCost {
+  const char* name;
+  long long   ns     = 0;
+  size_t      allocs = 0;
+};
+
+template <class Step>
+static void measure(SystemCost& cost, const Step& step) {
+  size_t            allocs_before = allocations.load();
+  Clock::time_point start         = Clock::now();
+  step();
+  cost.ns += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                 Clock::now() - start)
+                 .count();
+  cost.allocs += allocations.load() - allocs_before;
+}
+
+static bool by_id(Entity a, Entity b) {
+  return (unsigned int)a < (unsigned int)b;
+}
+
+// Every entity with a component in any container, sorted by id
+static std::vector<Entity> all_entities() {
+  std::vector<Entity> entities;
+  registry.for_each_container([&entities](auto& container) {
+    entities.insert(entities.end(), container.entities.begin(),
+                    container.entities.end());
+  });
+  std::sort(entities.begin(), entities.end(), by_id);
+  entities.erase(std::unique(entities.begin(), entities.end()),
+                 entities.end());
+  return entities;
+}
+
+// The entities created since 'before', which all_entities() returned
+static std::vector<Entity> entities_since(const std::vector<Entity>& before) {
+  std::vector<Entity> after = all_entities();
+  std::vector<Entity> created;
+  std::set_difference(after.begin(), after.end(), before.begin(), before.end(),
+                      std::back_inserter(created), by_id);
+  return created;
+}
+
+// Destroys the entities created since 'before' the way remove_all_entities()
+// does on a room change. The start room has no packs, so the room arena can be
+// handed back.
+static void change_room(const std::vector<Entity>& before) {
+  registry.destroy_batch(entities_since(before), ROOM_SHRINK_WATERMARK);
+  release_room_memory();
+}
+
+// A pack of fish steered together, like execute_pack_spawning() makes but
+// without its spawn collision checks, which fail in crowded scenes
+static void spawn_fish_pack(RenderSystem& renderer, RoomBuilder& arena,
+                            unsigned int size) {
+  Entity group  = create_pack_group(size);
+  vec2   center = arena.get_random_position();
+  for (unsigned int i = 0; i < size; i++) {
+    vec2 offset = {randomFloat(-50.f, 50.f), randomFloat(-50.f, 50.f)};
+    join_pack(group, createFishPos(&renderer, center + offset, false));
+  }
+}
+
+// Walls of a room the size of the largest generated ones, built and
+// activated the way the level system does for the room the player is in
+static RoomBuilder build_arena() {
+  RoomBuilder arena;
+  arena.up(Y_10U).right(X_20U).down(Y_10U).left(X_20U);
+  for (Entity wall : registry.spaces.get(arena.entity).walls) {
+    registry.activeWalls.emplace(wall);
+  }
+  return arena;
+}
+
+static void spawn_scene(RenderSystem& renderer, RoomBuilder& arena,
+                        unsigned int count) {
+  unsigned int sharks  = (unsigned int)(count * BENCH_SHARK_SHARE);
+  unsigned int crates  = (unsigned int)(count * BENCH_CRATE_SHARE);
+  unsigned int needles = (unsigned int)(count * BENCH_NEEDLE_SHARE);
+  unsigned int fish    = count - sharks - crates - needles;
+
+  for (unsigned int i = 0; i < sharks; i++) {
+    createSharkPos(&renderer, arena.get_random_position(), false);
+  }
+  for (unsigned int i = 0; i < crates; i++) {
+    createCratePos(&renderer, arena.get_random_position(), false);
+  }
+  for (unsigned int i = 0; i < needles; i++) {
+    launchUrchinNeedle(&renderer, arena.get_random_position(),
+                       randomFloat(0.f, 2.f * M_PI));
+  }
+  for (unsigned int i = 0; i < fish; i += BENCH_FISH_PACK_SIZE) {
+    spawn_fish_pack(renderer, arena,
+                    std::min(fish - i, (unsigned int)BENCH_FISH_PACK_SIZE));
+  }
+}
+
+// Heap allocations made spawning a pack of fish into a room that follows a busy
+// one. The busy room grows every container a fish uses, the room change
+// shrinks them but leaves room for the next room. The pack's member list goes
+// to the room arena.
+static size_t pack_spawn_allocations(RenderSystem& renderer) {
+  std::vector<Entity> start  = all_entities();
+  RoomBuilder         arena  = build_arena();
+  std::vector<Entity> before = all_entities();
+
+  for (unsigned int i = 0; i < BENCH_CHECK_BUSY_PACKS; i++) {
+    spawn_fish_pack(renderer, arena, BENCH_CHECK_PACK_SIZE);
+  }
+  change_room(before);
+
+  size_t allocs_before = allocations.load();
+  spawn_fish_pack(renderer, arena, BENCH_CHECK_PACK_SIZE);
+  size_t allocs = allocations.load() - allocs_before;
+
+  change_room(before);
+  registry.destroy_batch(entities_since(start));
+  return allocs;
+}
+
+int main(int argc, char* argv[]) {
+  unsigned int              frames = 300;
+  unsigned int              seed   = 1;
+  std::vector<unsigned int> counts;
+  for (int i = 1; i < argc; i++) {
+    unsigned int count;
+    if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+      if (!parse_uint(argv[++i], frames) || frames == 0) {
+        fprintf(stderr, "--frames expects a number of frames\n");
+        return EXIT_FAILURE;
+      }
+    } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+      if (!parse_uint(argv[++i], seed)) {
+        fprintf(stderr, "--seed expects a number\n");
+        return EXIT_FAILURE;
+      }
+    } else if (parse_uint(argv[i], count) && count > 0) {
+      counts.push_back(count);
+    } else {
+      fprintf(stderr, "usage: %s [--frames N] [--seed S] [counts...]\n",
+              argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+  if (counts.empty()) {
+    counts = {100, 1000, 10000};
+  }
+
+  WorldSystem     world;
+  RenderSystem    renderer;
+  AISystem        ai;
+  PhysicsSystem   physics;
+  CollisionSystem collisions;
+  LevelSystem     level;
+
+  renderer.init_headless();
+  setGlobalSeed(seed);
+  LevelBuilder level_builder = LevelBuilder();
+  level_builder.generate_random_level();
+  init_save_system(&level_builder, &level, &renderer);
+  level.init(&renderer, &level_builder);
+  collisions.init(&renderer, &level);
+  world.init(&renderer, &level);
+  ai.init(&renderer);
+
+  const float tick_ms = 1000.f / SIM_TICK_RATE;
+  printf("bermuda_bench: seed %u, %u frames per scene, %u threads\n", seed,
+         frames, jobs().thread_count());
+  printf("%9s  %-10s  %10s  %9s  %12s\n", "entities", "system", "ns/entity",
+         "ms/frame", "allocs/frame");
+
+  for (unsigned int count : counts) {
+    // the scene goes away afterwards, the room the game started in stays
+    std::vector<Entity> before = all_entities();
+    RoomBuilder         arena  = build_arena();
+    spawn_scene(renderer, arena, count);
+    size_t entities = registry.motions.size();
+
+    SystemCost costs[] = {{"ai"}, {"physics"}, {"collisions"}};
+    for (unsigned int frame = 0; frame < BENCH_WARMUP_FRAMES + frames;
+         frame++) {
+      // the warm-up frames fill the caches and grow the containers
+      if (frame == BENCH_WARMUP_FRAMES) {
+        for (SystemCost& cost : costs) cost = SystemCost{cost.name};
+      }
+      registry.advance_frame();
+      measure(costs[0], [&] { ai.step(tick_ms); });
+      measure(costs[1], [&] {
+        physics.step(tick_ms);
+        registry_commands.flush();
+      });
+      measure(costs[2], [&] {
+        collisions.step(tick_ms);
+        registry_commands.flush();
+      });
+    }
+
+    SystemCost total{"total"};
+    for (const SystemCost& cost : costs) {
+      total.ns += cost.ns;
+      total.allocs += cost.allocs;
+    }
+    for (const SystemCost* cost : {&costs[0], &costs[1], &costs[2], &total}) {
+      printf("%9zu  %-10s  %10.1f  %9.3f  %12.1f\n", entities, cost->name,
+             (double)cost->ns / frames / entities, cost->ns / 1e6 / frames,
+             (double)cost->allocs / frames);
+    }
+
+    registry.destroy_batch(entities_since(before));
+  }
+
+  size_t pack_allocs = pack_spawn_allocations(renderer);
+  printf("%d fish pack after a room change: %zu allocations\n",
+         BENCH_CHECK_PACK_SIZE, pack_allocs);
+  if (pack_allocs > 0) {
+    fprintf(stderr, "spawning a pack should not allocate\n");
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,326 @@
+// Microbenchmarks and golden results of the collision primitives in
+// collision_util.cpp. Every primitive is run over the same randomized inputs,
+// and its results must hash to the value recorded below: a rewrite (batched,
+// SIMD, allocation free) has to keep today's answers bit for bit, including
+// the ones on the edges. Then each primitive is timed. The hashes were
+// recorded with GCC on x86-64. mesh_collides() rotates through the C
+// library's sin() and cos(), so its hash may differ on other platforms.
+//
+//   collision_bench [--iterations N]
+//
+// Exits with a failure if any result differs from the recorded ones.
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "bench_util.hpp"
+#include "collision_util.hpp"
+#include "command_line.hpp"
+#include "components.hpp"
+#include "tiny_ecs_registry.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+// Randomized inputs per primitive
+#define BENCH_CASES 4096
+
+// Hashes of the results over the randomized inputs, see check_digest()
+#define GOLDEN_BOX_COLLIDES 0x9724f6dcu
+#define GOLDEN_CIRCLE_COLLIDES 0x2614f0b8u
+#define GOLDEN_CIRCLE_BOX_COLLIDES 0xf2de5ca2u
+#define GOLDEN_MESH_COLLIDES 0xc57e6277u
+#define GOLDEN_FIND_CLOSEST_POINT 0x669440e6u
+
+// xorshift32, unlike the standard distributions it gives the same numbers
+// with every standard library
+class BenchRandom {
+  uint32_t state;
+
+public:
+  explicit BenchRandom(uint32_t seed) : state(seed) {}
+
+  uint32_t next() {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+  }
+
+  // Multiples of 1/16, exact in a float. Rounding never comes up, so how the
+  // compiler orders or fuses the arithmetic can't change the inputs.
+  float uniform(float min, float max) {
+    return min + (float)(next() % (uint32_t)((max - min) * 16.f)) / 16.f;
+  }
+};
+
+// FNV-1a over the results of a primitive
+class Digest {
+  uint32_t hash = 2166136261u;
+
+public:
+  void add(const void* data, size_t bytes) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < bytes; i++) {
+      hash = (hash ^ p[i]) * 16777619u;
+    }
+  }
+  void add(bool value) {
+    unsigned char byte = value;
+    add(&byte, 1);
+  }
+  void add(vec2 value) { add(&value, sizeof(value)); }
+
+  uint32_t value() const { return hash; }
+};
+
+static int failures = 0;
+
+static void expect(bool ok, const char* what) {
+  if (!ok) {
+    printf("FAILED %s\n", what);
+    failures++;
+  }
+}
+
+static void check_digest(const char* primitive, const Digest& digest,
+                         uint32_t golden) {
+  if (digest.value() != golden) {
+    printf("FAILED %s: results hash to %08x, recorded %08x\n", primitive,
+           digest.value(), golden);
+    failures++;
+  }
+}
+
+static Position make_position(vec2 position, vec2 scale, float angle = 0.f) {
+  Position p;
+  p.position = position;
+  p.scale    = scale;
+  p.angle    = angle;
+  return p;
+}
+
+// Scales are signed, the primitives must only look at their magnitude
+static Position random_position(BenchRandom& random) {
+  return make_position(
+      {random.uniform(0.f, 400.f), random.uniform(0.f, 400.f)},
+      {random.uniform(-120.f, 120.f), random.uniform(-120.f, 120.f)},
+      random.uniform(-3.125f, 3.125f));
+}
+
+// A unit octagon as a triangle list, laid out like the collision meshes
+// loaded from .obj files. The corners are spelled out, sin() and cos() may
+// round differently elsewhere.
+static Mesh make_octagon() {
+  const float d         = 0.35355339f;  // sqrt(2) / 4
+  const vec2  corners[] = {{0.5f, 0.f},  {d, d},   {0.f, 0.5f},  {-d, d},
+                           {-0.5f, 0.f}, {-d, -d}, {0.f, -0.5f}, {d, -d}};
+
+  Mesh          mesh;
+  ColoredVertex center = {vec3(0.f, 0.f, 0.f), vec3(1.f)};
+  for (int i = 0; i < 8; i++) {
+    ColoredVertex v0 = {vec3(corners[i], 0.f), vec3(1.f)};
+    ColoredVertex v1 = {vec3(corners[(i + 1) % 8], 0.f), vec3(1.f)};
+    for (const ColoredVertex& v : {center, v0, v1}) {
+      mesh.vertex_indices.push_back((uint16_t)mesh.vertices.size());
+      mesh.vertices.push_back(v);
+    }
+  }
+  return mesh;
+}
+
+// The entities mesh_collides() tests, a mesh and one other entity for each
+// of its branches: boxes, shockwaves and canister explosions
+struct MeshScene {
+  Mesh   octagon = make_octagon();
+  Entity mesh;
+  Entity box;
+  Entity shockwave;
+  Entity canister;
+
+  MeshScene() {
+    registry.positions.emplace(mesh);
+    registry.meshPtrs.emplace(mesh, &octagon);
+    registry.positions.emplace(box);
+    registry.positions.emplace(shockwave);
+    registry.enemyProjectiles.emplace(shockwave).type = ENTITY_TYPE::SHOCKWAVE;
+    registry.positions.emplace(canister);
+    registry.consumables.emplace(canister).type =
+        ENTITY_TYPE::OXYGEN_CANISTER;
+    registry.aoe.emplace(canister).radius = 40.f;
+  }
+
+  Entity other(size_t i) const {
+    const Entity others[] = {box, shockwave, canister};
+    return others[i % 3];
+  }
+
+  void place(Entity e, const Position& p) {
+    PositionRef ref = registry.positions.get_mut(e);
+    ref.position    = p.position;
+    ref.scale       = p.scale;
+    ref.angle       = p.angle;
+  }
+};
+
+// Cases with answers worked out by hand, the edges included
+static void check_known_cases(MeshScene& scene) {
+  Position a = make_position({0.f, 0.f}, {10.f, 10.f});
+  expect(box_collides(a, a), "box_collides: a box overlaps itself");
+  expect(!box_collides(a, make_position({10.f, 0.f}, {10.f, 10.f})),
+         "box_collides: boxes sharing an edge don't overlap");
+  expect(box_collides(a, make_position({9.f, 9.f}, {-10.f, -10.f})),
+         "box_collides: negative scales count by their magnitude");
+
+  Position c = make_position({0.f, 0.f}, {6.f, 8.f});  // radius 5
+  expect(circle_collides(c, make_position({4.9f, 0.f}, {0.f, 0.f})),
+         "circle_collides: inside the larger radius");
+  expect(!circle_collides(c, make_position({5.f, 0.f}, {0.f, 0.f})),
+         "circle_collides: on the circle is outside");
+
+  Position box = make_position({10.f, 0.f}, {10.f, 10.f});
+  expect(circle_box_collides(a, 5.f, box),
+         "circle_box_collides: touching counts");
+  expect(!circle_box_collides(a, 4.9f, box),
+         "circle_box_collides: short of the box");
+
+  vec2 inside = find_closest_point(make_position({12.f, 1.f}, {0.f, 0.f}),
+                                   box);
+  expect(inside == vec2(12.f, 1.f),
+         "find_closest_point: a point inside is its own closest point");
+  vec2 outside = find_closest_point(make_position({-3.f, 20.f}, {0.f, 0.f}),
+                                    box);
+  expect(outside == vec2(5.f, 5.f),
+         "find_closest_point: the nearest corner of the box");
+
+  scene.place(scene.mesh, make_position({100.f, 100.f}, {100.f, 100.f}));
+  scene.place(scene.box, make_position({100.f, 100.f}, {120.f, 120.f}));
+  expect(mesh_collides(scene.mesh, scene.box),
+         "mesh_collides: box covering the mesh");
+  // Only vertices and the midpoint of two overlapping ones are tested. Here
+  // every triangle has two vertices level with the box and the midpoint
+  // outside, so the box is missed.
+  scene.place(scene.box, make_position({100.f, 100.f}, {10.f, 10.f}));
+  expect(!mesh_collides(scene.mesh, scene.box),
+         "mesh_collides: small box inside the mesh is missed");
+  scene.place(scene.box, make_position({300.f, 100.f}, {10.f, 10.f}));
+  expect(!mesh_collides(scene.mesh, scene.box),
+         "mesh_collides: box far from the mesh");
+  scene.place(scene.shockwave, make_position({170.f, 100.f}, {60.f, 60.f}));
+  expect(mesh_collides(scene.mesh, scene.shockwave),
+         "mesh_collides: shockwave reaching a vertex");
+  scene.place(scene.canister, make_position({200.f, 100.f}, {1.f, 1.f}));
+  expect(!mesh_collides(scene.mesh, scene.canister),
+         "mesh_collides: canister explosion out of reach");
+}
+
+// Inputs of the randomized checks and the timing runs
+struct Inputs {
+  std::vector<Position> a, b;
+  std::vector<float>    radius;
+};
+
+static Inputs make_inputs(BenchRandom& random) {
+  Inputs inputs;
+  for (int i = 0; i < BENCH_CASES; i++) {
+    inputs.a.push_back(random_position(random));
+    Position b = random_position(random);
+    // half the pairs close together, so both answers come up
+    if (i % 2 == 0) {
+      vec2 offset = {random.uniform(-60.f, 60.f), random.uniform(-60.f, 60.f)};
+      b.position  = inputs.a.back().position + offset;
+    }
+    inputs.b.push_back(b);
+    inputs.radius.push_back(random.uniform(0.f, 80.f));
+  }
+  return inputs;
+}
+
+static void check_random_cases(const Inputs& in, MeshScene& scene) {
+  Digest box, circle, circle_box, mesh, closest;
+  for (size_t i = 0; i < BENCH_CASES; i++) {
+    box.add(box_collides(in.a[i], in.b[i]));
+    circle.add(circle_collides(in.a[i], in.b[i]));
+    circle_box.add(circle_box_collides(in.a[i], in.radius[i], in.b[i]));
+    closest.add(find_closest_point(in.a[i], in.b[i]));
+
+    scene.place(scene.mesh, in.a[i]);
+    scene.place(scene.other(i), in.b[i]);
+    mesh.add(mesh_collides(scene.mesh, scene.other(i)));
+  }
+  check_digest("box_collides", box, GOLDEN_BOX_COLLIDES);
+  check_digest("circle_collides", circle, GOLDEN_CIRCLE_COLLIDES);
+  check_digest("circle_box_collides", circle_box,
+               GOLDEN_CIRCLE_BOX_COLLIDES);
+  check_digest("mesh_collides", mesh, GOLDEN_MESH_COLLIDES);
+  check_digest("find_closest_point", closest, GOLDEN_FIND_CLOSEST_POINT);
+}
+
+// Runs call(i) over every input, iterations times, and prints the cost per
+// call. The results are summed so the calls can't be optimized away.
+template <class Call>
+static void time_primitive(const char* name, unsigned int iterations,
+                           const Call& call) {
+  size_t            allocs_before = allocations.load();
+  Clock::time_point start         = Clock::now();
+  volatile float    sink          = 0.f;
+  for (unsigned int n = 0; n < iterations; n++) {
+    float sum = 0.f;
+    for (size_t i = 0; i < BENCH_CASES; i++) sum += call(i);
+    sink = sink + sum;
+  }
+  double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                  Clock::now() - start)
+                  .count();
+  double calls = (double)iterations * BENCH_CASES;
+  printf("%-20s  %9.2f  %11.3f\n", name, ns / calls,
+         (allocations.load() - allocs_before) / calls);
+}
+
+int main(int argc, char* argv[]) {
+  unsigned int iterations = 200;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc &&
+        parse_uint(argv[i + 1], iterations) && iterations > 0) {
+      i++;
+    } else {
+      fprintf(stderr, "usage: %s [--iterations N]\n", argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+
+  BenchRandom random(0x42u);
+  MeshScene   scene;
+  Inputs      in = make_inputs(random);
+
+  check_known_cases(scene);
+  check_random_cases(in, scene);
+  if (failures > 0) {
+    printf("%d collision checks failed\n", failures);
+    return EXIT_FAILURE;
+  }
+  printf("collision results match the recorded ones\n\n");
+
+  printf("%-20s  %9s  %11s\n", "primitive", "ns/call", "allocs/call");
+  time_primitive("box_collides", iterations,
+                 [&](size_t i) { return box_collides(in.a[i], in.b[i]); });
+  time_primitive("circle_collides", iterations,
+                 [&](size_t i) { return circle_collides(in.a[i], in.b[i]); });
+  time_primitive("circle_box_collides", iterations, [&](size_t i) {
+    return circle_box_collides(in.a[i], in.radius[i], in.b[i]);
+  });
+  time_primitive("find_closest_point", iterations, [&](size_t i) {
+    return find_closest_point(in.a[i], in.b[i]).x;
+  });
+  // placing the entities is part of the loop, it is two sparse lookups
+  time_primitive("mesh_collides", iterations, [&](size_t i) {
+    scene.place(scene.mesh, in.a[i]);
+    scene.place(scene.other(i), in.b[i]);
+    return mesh_collides(scene.mesh, scene.other(i));
+  });
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,444 @@
+// Performance regression gate. Replays the scenarios of a baseline file, each
+// a seed and an input script or recording, headless and compares what they
+// cost against the numbers recorded in it:
+//
+//   - the mean time of every profiled section (PROFILE_SCOPE), e.g.
+//     "tick", "collisions.step" or "collisions.detect_masses"
+//   - the entities at the end of the run and the most at any tick
+//   - the peak resident memory of the process
+//
+//   bermuda_perf_check [--baseline file.json] [--runs N] [--update]
+//
+// Every metric past its tolerance is listed and the check fails. So does a
+// replay that ends in another state than the recorded one (checksum or tick
+// count), its numbers no longer measure the same game. --update writes this
+// machine's numbers into the baseline instead. Timings only compare against
+// a baseline from the same machine and build type.
+//
+// The baseline looks like
+//
+//   {
+//     "tolerances": {
+//       "section": 0.25,           slowdown allowed, relative
+//       "section_floor": 0.01,     share of a tick, smaller
+//                                  differences are noise
+//       "entities": 0.1,           growth allowed, relative
+//       "peak_rss_kb": 0.2         growth allowed, relative
+//     },
+//     "scenarios": [
+//       {
+//         "name": "crate_rooms", "seed": 7, "ticks": 3600,
+//         "input": "crate_rooms.txt",  (or "replay": a recording)
+//         "expected": {...}            (written by --update)
+//       }
+//     ]
+//   }
+//
+// with input and replay paths relative to the baseline file. Each run of a
+// scenario is a process of its own, the game keeps its state in globals and
+// the peak memory is per process. Of several runs the fastest time of each
+// section counts.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+// after windows.h
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include "command_line.hpp"
+#include "json.hpp"
+#include "profiler.hpp"
+#include "simulation.hpp"
+
+// keeps the baseline's keys in the order they were written
+using json = nlohmann::ordered_json;
+
+#define PERF_BASELINE PROJECT_SOURCE_DIR "bench/perf/baseline.json"
+
+// What one scenario cost
+struct ScenarioResult {
+  unsigned int                  ticks         = 0;
+  size_t                        entities      = 0;
+  size_t                        peak_entities = 0;
+  long                          peak_rss_kb   = 0;
+  std::string                   checksum;
+  std::map<std::string, double> section_us;  // mean per call
+};
+
+static void to_json(json& j, const ScenarioResult& result) {
+  j = json{{"ticks", result.ticks},
+           {"entities", result.entities},
+           {"peak_entities", result.peak_entities},
+           {"peak_rss_kb", result.peak_rss_kb},
+           {"checksum", result.checksum},
+           {"section_us", result.section_us}};
+}
+
+static void from_json(const json& j, ScenarioResult& result) {
+  result.ticks         = j.at("ticks");
+  result.entities      = j.at("entities");
+  result.peak_entities = j.at("peak_entities");
+  result.peak_rss_kb   = j.at("peak_rss_kb");
+  result.checksum      = j.at("checksum");
+  result.section_us =
+      j.at("section_us").get<std::map<std::string, double>>();
+}
+
+struct Tolerances {
+  double section       = 0.25;
+  double section_floor = 0.01;
+  double entities      = 0.1;
+  double peak_rss_kb   = 0.2;
+};
+
+static bool read_json(const std::string& path, json& out) {
+  std::ifstream file(path);
+  if (!file.is_open()) {
+    fprintf(stderr, "Failed to open %s\n", path.c_str());
+    return false;
+  }
+  try {
+    file >> out;
+  } catch (const json::exception& e) {
+    fprintf(stderr, "%s: %s\n", path.c_str(), e.what());
+    return false;
+  }
+  return true;
+}
+
+static bool write_json(const std::string& path, const json& value) {
+  std::ofstream file(path);
+  if (!file.is_open()) {
+    fprintf(stderr, "Failed to write %s\n", path.c_str());
+    return false;
+  }
+  file << value.dump(2) << "\n";
+  return true;
+}
+
+// Most memory the process had resident so far
+static long peak_rss_kb() {
+#ifdef _WIN32
+  PROCESS_MEMORY_COUNTERS counters;
+  if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters,
+                            sizeof(counters))) {
+    return 0;
+  }
+  return (long)(counters.PeakWorkingSetSize / 1024);
+#else
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+  return usage.ru_maxrss / 1024;  // in bytes there
+#else
+  return usage.ru_maxrss;
+#endif
+#endif
+}
+
+// The child side: plays one scenario and writes its ScenarioResult
+static int run_scenario(const HeadlessOptions& options,
+                        const std::string&     out_path) {
+#ifdef BERMUDA_PROFILING
+  HeadlessResult headless;
+  if (run_headless(options, &headless) != EXIT_SUCCESS) {
+    return EXIT_FAILURE;
+  }
+
+  ScenarioResult result;
+  result.ticks         = headless.ticks;
+  result.entities      = headless.entities;
+  result.peak_entities = headless.peak_entities;
+  result.peak_rss_kb   = peak_rss_kb();
+  char checksum[9];
+  snprintf(checksum, sizeof(checksum), "%08x", headless.checksum);
+  result.checksum = checksum;
+  for (const ProfileStats& stats : profiler().stats()) {
+    // to the nanosecond, finer is noise and clutters the baseline
+    double us = stats.total_ms * 1000.0 / stats.calls;
+    result.section_us[stats.name] = std::round(us * 1000.0) / 1000.0;
+  }
+  return write_json(out_path, result) ? EXIT_SUCCESS : EXIT_FAILURE;
+#else
+  (void)options;
+  (void)out_path;
+  return EXIT_FAILURE;
+#endif
+}
+
+// Runs a scenario in a child process, its output going to a log file
+static bool spawn_scenario(const std::string& self, const json& scenario,
+                           const std::string& base_dir,
+                           ScenarioResult&    result) {
+  std::string  name    = scenario.at("name");
+  unsigned int seed    = scenario.at("seed");
+  std::string  out     = "perf_check_" + name + ".json";
+  std::string  log     = "perf_check_" + name + ".log";
+  std::string  command = "\"" + self + "\" --run-scenario \"" + out +
+                        "\" --seed " + std::to_string(seed);
+  if (scenario.contains("ticks")) {
+    unsigned int ticks = scenario["ticks"];
+    command += " --ticks " + std::to_string(ticks);
+  }
+  for (const char* key : {"input", "replay"}) {
+    if (scenario.contains(key)) {
+      std::string path = scenario[key];
+      command += std::string(" --") + key + " \"" + base_dir + path + "\"";
+    }
+  }
+  command += " > \"" + log + "\" 2>&1";
+
+  json output;
+  if (std::system(command.c_str()) != 0 || !read_json(out, output)) {
+    fprintf(stderr, "Scenario %s failed, see %s\n", name.c_str(),
+            log.c_str());
+    return false;
+  }
+  result = output.get<ScenarioResult>();
+  return true;
+}
+
+// Keeps the fastest time of every section across runs. The rest is the same
+// every run of a deterministic replay, memory aside, which is kept lowest.
+static void keep_best(ScenarioResult& best, const ScenarioResult& run) {
+  for (const auto& section : run.section_us) {
+    auto it = best.section_us.find(section.first);
+    if (it == best.section_us.end()) {
+      best.section_us.insert(section);
+    } else {
+      it->second = std::min(it->second, section.second);
+    }
+  }
+  best.peak_rss_kb = std::min(best.peak_rss_kb, run.peak_rss_kb);
+}
+
+// Prints a table of a scenario's metrics, baseline against now, and the
+// regressions into failures
+class Report {
+  std::string               scenario;
+  std::vector<std::string>& failures;
+
+  void row(const std::string& metric, double expected, double now,
+           const char* format, double allowed, bool regressed) {
+    char expected_text[32], now_text[32];
+    snprintf(expected_text, sizeof(expected_text), format, expected);
+    snprintf(now_text, sizeof(now_text), format, now);
+    double change = expected != 0.0 ? (now - expected) / expected * 100.0 : 0.0;
+    printf("  %-36s %12s %12s %+8.1f%%", metric.c_str(), expected_text,
+           now_text, change);
+    if (regressed) {
+      printf("  << over %+.0f%%", allowed * 100.0);
+      char failure[256];
+      snprintf(failure, sizeof(failure),
+               "%s: %s %s -> %s (%+.1f%%, allowed %+.0f%%)", scenario.c_str(),
+               metric.c_str(), expected_text, now_text, change,
+               allowed * 100.0);
+      failures.push_back(failure);
+    }
+    printf("\n");
+  }
+
+public:
+  Report(const std::string& scenario, std::vector<std::string>& failures)
+      : scenario(scenario), failures(failures) {
+    printf("  %-36s %12s %12s %9s\n", "metric", "baseline", "now", "change");
+  }
+
+  // A section regressed past its tolerance and by more than floor_us
+  void section(const std::string& name, double expected, double now,
+               double tolerance, double floor_us) {
+    bool regressed =
+        now > expected * (1.0 + tolerance) && now - expected > floor_us;
+    row(name + " us", expected, now, "%.3f", tolerance, regressed);
+  }
+
+  void count(const std::string& name, double expected, double now,
+             double tolerance) {
+    row(name, expected, now, "%.0f", tolerance,
+        now > expected * (1.0 + tolerance));
+  }
+
+  void missing(const std::string& name) {
+    printf("  %-36s  ran in the baseline, not now\n", (name + " us").c_str());
+    failures.push_back(scenario + ": " + name + " no longer runs");
+  }
+};
+
+static void compare(const std::string& name, const ScenarioResult& expected,
+                    const ScenarioResult& now, const Tolerances& tolerances,
+                    std::vector<std::string>& failures) {
+  if (now.checksum != expected.checksum || now.ticks != expected.ticks) {
+    char failure[256];
+    snprintf(failure, sizeof(failure),
+             "%s: the replay diverged, %u ticks and checksum %s -> %u ticks "
+             "and %s",
+             name.c_str(), expected.ticks, expected.checksum.c_str(),
+             now.ticks, now.checksum.c_str());
+    printf("  the replay diverged from the baseline's (%u ticks, checksum %s, "
+           "now %u ticks, %s), the game plays differently\n",
+           expected.ticks, expected.checksum.c_str(), now.ticks,
+           now.checksum.c_str());
+    failures.push_back(failure);
+  }
+
+  Report report(name, failures);
+  report.count("entities", expected.entities, now.entities,
+               tolerances.entities);
+  report.count("peak_entities", expected.peak_entities, now.peak_entities,
+               tolerances.entities);
+  report.count("peak_rss_kb", expected.peak_rss_kb, now.peak_rss_kb,
+               tolerances.peak_rss_kb);
+  // Most sections take a fraction of a microsecond and jitter by more than
+  // their tolerance. Slowdowns count once they cost a share of the
+  // baseline's tick, so the floor follows the scenario rather than a fixed
+  // number of microseconds.
+  auto   tick     = expected.section_us.find("tick");
+  double floor_us = tick != expected.section_us.end()
+                        ? tick->second * tolerances.section_floor
+                        : 0.0;
+  for (const auto& section : expected.section_us) {
+    auto it = now.section_us.find(section.first);
+    if (it == now.section_us.end()) {
+      report.missing(section.first);
+    } else {
+      report.section(section.first, section.second, it->second,
+                     tolerances.section, floor_us);
+    }
+  }
+  for (const auto& section : now.section_us) {
+    if (expected.section_us.count(section.first) == 0) {
+      printf("  %-36s %12s %12.3f  new\n", (section.first + " us").c_str(),
+             "-", section.second);
+    }
+  }
+}
+
+// Directory of a path with its trailing separator, empty for a bare file name
+static std::string directory_of(const std::string& path) {
+  size_t slash = path.find_last_of("/\\");
+  return slash == std::string::npos ? "" : path.substr(0, slash + 1);
+}
+
+int main(int argc, char* argv[]) {
+#ifndef BERMUDA_PROFILING
+  fprintf(stderr, "perf_check needs a build with BERMUDA_PROFILING\n");
+  return EXIT_FAILURE;
+#endif
+  std::string     baseline_path = PERF_BASELINE;
+  unsigned int    runs          = 3;
+  bool            update        = false;
+  std::string     run_out;  // set in the children
+  HeadlessOptions options;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+      baseline_path = argv[++i];
+    } else if (strcmp(argv[i], "--runs") == 0 && i + 1 < argc) {
+      if (!parse_uint(argv[++i], runs) || runs == 0) {
+        fprintf(stderr, "--runs expects a number of runs\n");
+        return EXIT_FAILURE;
+      }
+    } else if (strcmp(argv[i], "--update") == 0) {
+      update = true;
+    } else if (strcmp(argv[i], "--run-scenario") == 0 && i + 1 < argc) {
+      // how the check starts its children
+      run_out = argv[++i];
+    } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+      parse_uint(argv[++i], options.seed);
+    } else if (strcmp(argv[i], "--ticks") == 0 && i + 1 < argc) {
+      parse_uint(argv[++i], options.ticks);
+    } else if (strcmp(argv[i], "--input") == 0 && i + 1 < argc) {
+      options.input_path = argv[++i];
+    } else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+      options.replay_path = argv[++i];
+    } else {
+      fprintf(stderr,
+              "usage: %s [--baseline file.json] [--runs N] [--update]\n",
+              argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+  if (!run_out.empty()) {
+    return run_scenario(options, run_out);
+  }
+
+  json baseline;
+  if (!read_json(baseline_path, baseline)) {
+    return EXIT_FAILURE;
+  }
+  std::string              base_dir = directory_of(baseline_path);
+  Tolerances               tolerances;
+  std::vector<std::string> failures;
+  try {
+    json t = baseline.value("tolerances", json::object());
+    tolerances.section = t.value("section", tolerances.section);
+    tolerances.section_floor =
+        t.value("section_floor", tolerances.section_floor);
+    tolerances.entities    = t.value("entities", tolerances.entities);
+    tolerances.peak_rss_kb = t.value("peak_rss_kb", tolerances.peak_rss_kb);
+
+    for (json& scenario : baseline.at("scenarios")) {
+      std::string name = scenario.at("name");
+      printf("scenario %s: seed %u, %u runs\n", name.c_str(),
+             (unsigned int)scenario.at("seed"), runs);
+
+      ScenarioResult best;
+      for (unsigned int run = 0; run < runs; run++) {
+        ScenarioResult result;
+        if (!spawn_scenario(argv[0], scenario, base_dir, result)) {
+          return EXIT_FAILURE;
+        }
+        if (run == 0) {
+          best = result;
+        } else {
+          keep_best(best, result);
+        }
+      }
+
+      if (update) {
+        scenario["expected"] = best;
+        printf("  recorded %zu sections, %zu entities, %ld kB peak\n",
+               best.section_us.size(), best.entities, best.peak_rss_kb);
+      } else if (!scenario.contains("expected")) {
+        printf("  nothing recorded yet, run with --update\n");
+        failures.push_back(name + ": no expected numbers");
+      } else {
+        compare(name, scenario["expected"].get<ScenarioResult>(), best,
+                tolerances, failures);
+      }
+    }
+  } catch (const json::exception& e) {
+    fprintf(stderr, "%s: %s\n", baseline_path.c_str(), e.what());
+    return EXIT_FAILURE;
+  }
+
+  if (update) {
+    if (!write_json(baseline_path, baseline)) {
+      return EXIT_FAILURE;
+    }
+    printf("perf_check: updated %s\n", baseline_path.c_str());
+    return EXIT_SUCCESS;
+  }
+  if (!failures.empty()) {
+    printf("\nperf_check: %zu regressions against %s\n", failures.size(),
+           baseline_path.c_str());
+    for (const std::string& failure : failures) {
+      printf("  %s\n", failure.c_str());
+    }
+    return EXIT_FAILURE;
+  }
+  printf("\nperf_check: within tolerances of %s\n", baseline_path.c_str());
+  return EXIT_SUCCESS;
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "ecs_memory.hpp"
 #include "enemy.hpp"
 
 // A timer that will be associated to the dying
@@ -57,13 +58,13 @@ struct ActsAsProjectile {
 };
 
 struct EntityGroup {
-  Entity group;
+  Entity group        = Entity(0);
   float active_dir_cd = 0.f;
   float change_dir_cd = 1000.f;
 };
 
 struct Group {
-  std::vector<Entity> members;
+  PooledVector<Entity> members;
   float active_dir_cd = 0.f;
   float change_dir_cd = 1000.f;
 };
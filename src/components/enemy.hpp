@@ -2,6 +2,7 @@
 #include <functional>
 #include <vector>
 
+#include "ecs_memory.hpp"
 #include "render_system.hpp"
 #include "respawn.hpp"
 
@@ -28,16 +29,16 @@ struct EnemyProjectile {
 };
 
 struct EnemySupport {
-  Entity user;
+  Entity user = Entity(0);
   bool   ignores_user;
 };
 
 struct Boss {
-  ENTITY_TYPE                        type;
-  float                              curr_cd = 0.f;
-  float                              ai_cd   = 0.f;
-  bool                               is_angry        = false;
-  std::vector<std::function<void()>> ai;
+  ENTITY_TYPE                         type;
+  float                               curr_cd = 0.f;
+  float                               ai_cd   = 0.f;
+  bool                                is_angry        = false;
+  PooledVector<std::function<void()>> ai;
 };
 
 struct Lobster {
@@ -3,6 +3,7 @@
 #include "level_util.hpp"
 #include "player.hpp"
 #include "common.hpp"
+#include "ecs_memory.hpp"
 #include "respawn.hpp"
 #include <limits>
 
@@ -39,14 +40,14 @@ struct Vector {
 };
 
 struct Space {
-  std::vector<Entity> boundaries;
-  std::vector<Entity> walls;
-  std::vector<Entity> doors;
+  PooledVector<Entity> boundaries;
+  PooledVector<Entity> walls;
+  PooledVector<Entity> doors;
 };
 
 struct DoorConnection {
   std::string room_id;
-  Entity exit_door;
+  Entity exit_door = Entity(0);
   Direction direction;
 
   // Gameplay related data.
@@ -68,10 +69,12 @@ struct Interactable {
 };
 
 struct PressurePlate {
-  bool active;
   float mass_activation = 20;
 };
 
+// Marks the pressure plates something stands on
+struct PressedPlate {};
+
 struct Floor {};
 
 struct Geyser {
@@ -16,7 +16,7 @@ struct DebugComponent {
 struct GameCursor {};
 
 struct Emoting {
-  Entity child;
+  Entity child = Entity(0);
 };
 
 struct Overlay {};
@@ -5,8 +5,8 @@ struct Oxygen {
   float  level;
   float  rate;
   bool   isRendered;
-  Entity oxygenBar;
-  Entity backgroundBar;
+  Entity oxygenBar     = Entity(0);
+  Entity backgroundBar = Entity(0);
 };
 
 struct OxygenModifier {
@@ -15,6 +15,173 @@ struct Motion {
   vec2 velocity = {0, 0};
 };
 
+// Positions and motions are read and written for every moving entity every
+// frame, so their containers keep each field in its own contiguous array (see
+// ComponentStorage) for loops to stream over. Containers hand out proxies of
+// field references instead of Position&, fields are accessed the same way.
+// The Const proxies stand in for const Position&.
+struct ConstPositionRef {
+  const vec2&  position;
+  const float& angle;
+  const vec2&  scale;
+  const vec2&  originalScale;
+
+  operator Position() const {
+    return Position{position, angle, scale, originalScale};
+  }
+};
+
+struct PositionRef {
+  vec2&  position;
+  float& angle;
+  vec2&  scale;
+  vec2&  originalScale;
+
+  PositionRef& operator=(const Position& p) {
+    position      = p.position;
+    angle         = p.angle;
+    scale         = p.scale;
+    originalScale = p.originalScale;
+    return *this;
+  }
+
+  // Copies the values over, the references keep pointing at the same entity
+  PositionRef& operator=(const PositionRef& p) { return *this = Position(p); }
+
+  operator Position() const {
+    return Position{position, angle, scale, originalScale};
+  }
+
+  operator ConstPositionRef() const {
+    return {position, angle, scale, originalScale};
+  }
+};
+
+struct PositionArrays {
+  std::vector<vec2>  position;
+  std::vector<float> angle;
+  std::vector<vec2>  scale;
+  std::vector<vec2>  originalScale;
+
+  PositionRef operator[](size_t i) {
+    return {position[i], angle[i], scale[i], originalScale[i]};
+  }
+  ConstPositionRef operator[](size_t i) const {
+    return {position[i], angle[i], scale[i], originalScale[i]};
+  }
+  PositionRef back() { return (*this)[size() - 1]; }
+  size_t      size() const { return angle.size(); }
+  size_t      capacity() const { return angle.capacity(); }
+
+  void reserve(size_t n) {
+    position.reserve(n);
+    angle.reserve(n);
+    scale.reserve(n);
+    originalScale.reserve(n);
+  }
+
+  void push_back(const Position& p) {
+    position.push_back(p.position);
+    angle.push_back(p.angle);
+    scale.push_back(p.scale);
+    originalScale.push_back(p.originalScale);
+  }
+
+  void pop_back() {
+    position.pop_back();
+    angle.pop_back();
+    scale.pop_back();
+    originalScale.pop_back();
+  }
+
+  void clear() {
+    position.clear();
+    angle.clear();
+    scale.clear();
+    originalScale.clear();
+  }
+};
+
+inline void shrink_capacity(PositionArrays& arrays, size_t n) {
+  shrink_capacity(arrays.position, n);
+  shrink_capacity(arrays.angle, n);
+  shrink_capacity(arrays.scale, n);
+  shrink_capacity(arrays.originalScale, n);
+}
+
+template <>
+struct ComponentStorage<Position> {
+  using type = PositionArrays;
+};
+
+struct ConstMotionRef {
+  const vec2& acceleration;
+  const vec2& velocity;
+
+  operator Motion() const { return Motion{acceleration, velocity}; }
+};
+
+struct MotionRef {
+  vec2& acceleration;
+  vec2& velocity;
+
+  MotionRef& operator=(const Motion& m) {
+    acceleration = m.acceleration;
+    velocity     = m.velocity;
+    return *this;
+  }
+
+  // Copies the values over, the references keep pointing at the same entity
+  MotionRef& operator=(const MotionRef& m) { return *this = Motion(m); }
+
+  operator Motion() const { return Motion{acceleration, velocity}; }
+
+  operator ConstMotionRef() const { return {acceleration, velocity}; }
+};
+
+struct MotionArrays {
+  std::vector<vec2> acceleration;
+  std::vector<vec2> velocity;
+
+  MotionRef      operator[](size_t i) { return {acceleration[i], velocity[i]}; }
+  ConstMotionRef operator[](size_t i) const {
+    return {acceleration[i], velocity[i]};
+  }
+  MotionRef back() { return (*this)[size() - 1]; }
+  size_t    size() const { return velocity.size(); }
+  size_t    capacity() const { return velocity.capacity(); }
+
+  void reserve(size_t n) {
+    acceleration.reserve(n);
+    velocity.reserve(n);
+  }
+
+  void push_back(const Motion& m) {
+    acceleration.push_back(m.acceleration);
+    velocity.push_back(m.velocity);
+  }
+
+  void pop_back() {
+    acceleration.pop_back();
+    velocity.pop_back();
+  }
+
+  void clear() {
+    acceleration.clear();
+    velocity.clear();
+  }
+};
+
+inline void shrink_capacity(MotionArrays& arrays, size_t n) {
+  shrink_capacity(arrays.acceleration, n);
+  shrink_capacity(arrays.velocity, n);
+}
+
+template <>
+struct ComponentStorage<Motion> {
+  using type = MotionArrays;
+};
+
 struct Mass {
   int mass;
 };
@@ -23,6 +190,22 @@ struct Mass {
 struct Collision {
   // Note, the first object is stored in the ECS container.entities
   Entity other; // the second object involved in the collision
-  Collision(Entity &other) { this->other = other; };
+  Collision(Entity &other) : other(other) {};
 };
 
+// Makes an entity follow another one, its Position is derived from the
+// parent's by the hierarchy pass (see updateHierarchy) using its
+// LocalTransform
+struct Parent {
+  Entity       parent = Entity(0);
+  unsigned int depth  = 0; // ancestors above the parent, parents update first
+};
+
+// Where a child sits relative to its parent: the parent's position plus
+// offset, plus anchor times the parent's scale (e.g. {0, -0.5} for the top
+// edge), plus reach along the child's own angle
+struct LocalTransform {
+  vec2  offset = {0, 0};
+  vec2  anchor = {0, 0};
+  float reach  = 0.f;
+};
@@ -23,7 +23,7 @@ struct PlayerProjectile {
 
 // Weapon component
 struct PlayerWeapon {
-  Entity projectile;
+  Entity projectile = Entity(0);
 };
 
 // Consumable inventory
@@ -68,9 +68,9 @@ struct Notification {
 
 // Player component
 struct Player {
-  Entity weapon;
-  Entity collisionMesh;
-  Entity dashIndicator;
+  Entity weapon        = Entity(0);
+  Entity collisionMesh = Entity(0);
+  Entity dashIndicator = Entity(0);
   // Controls
   bool upHeld            = false;
   bool downHeld          = false;
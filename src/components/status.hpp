@@ -13,5 +13,5 @@ struct KnockedBack {
   vec2 original_velocity;
   vec2 knocked_velocity;
   float duration;
-  Entity knockback_proj;
+  Entity knockback_proj = Entity(0);
 };
\ No newline at end of file
@@ -0,0 +1,29 @@
+#include "ecs_command_buffer.hpp"
+
+ECSCommandBuffer registry_commands;
+
+std::vector<Entity>& ECSCommandBuffer::removals_of(
+    ContainerInterface* container) {
+  for (auto& container_removals : removals) {
+    if (container_removals.first == container) {
+      return container_removals.second;
+    }
+  }
+  removals.emplace_back(container, std::vector<Entity>());
+  return removals.back().second;
+}
+
+void ECSCommandBuffer::flush() {
+  for (std::function<void()>& add : additions) add();
+  additions.clear();
+
+  for (auto& container_removals : removals) {
+    container_removals.first->remove_batch(container_removals.second);
+  }
+  removals.clear();
+
+  if (!destroyed.empty()) {
+    registry.destroy_batch(std::move(destroyed));
+    destroyed.clear();
+  }
+}
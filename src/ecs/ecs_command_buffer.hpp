@@ -0,0 +1,60 @@
+#pragma once
+
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "tiny_ecs.hpp"
+#include "tiny_ecs_registry.hpp"
+
+// Records structural changes to the registry (creating and destroying
+// entities, adding and removing components) while systems iterate over its
+// containers, and applies them all at once in flush(). Iteration never sees
+// the dense arrays reordered underneath it, so no entity gets skipped and no
+// defensive copies are needed.
+class ECSCommandBuffer {
+  // Components to insert, each wrapped with the container it goes to
+  std::vector<std::function<void()>> additions;
+
+  // Component removals grouped by container, so that flush() visits every
+  // affected container once
+  std::vector<std::pair<ContainerInterface*, std::vector<Entity>>> removals;
+
+  // Entities to remove from every container and release
+  std::vector<Entity> destroyed;
+
+  std::vector<Entity>& removals_of(ContainerInterface* container);
+
+public:
+  // Entity ids are not part of any container, so a new entity is handed out
+  // right away and its components are added at the next flush()
+  Entity create() { return Entity(); }
+
+  // Removes all components of e and releases it at the next flush()
+  void destroy(Entity e) { destroyed.push_back(e); }
+
+  // Inserts c for e at the next flush(), unless e was destroyed by then
+  template <typename Component>
+  void add(Entity e, Component c) {
+    additions.push_back([e, c]() {
+      if (e.is_alive()) registry.get<Component>().insert(e, c);
+    });
+  }
+
+  // Removes the component of type 'Component' from e at the next flush()
+  template <typename Component>
+  void remove(Entity e) {
+    removals_of(&registry.get<Component>()).push_back(e);
+  }
+
+  // Applies everything recorded since the last flush: additions first, then
+  // component removals, then destroyed entities
+  void flush();
+
+  bool empty() const {
+    return additions.empty() && removals.empty() && destroyed.empty();
+  }
+};
+
+// Shared buffer flushed by the game loop at the sync points between systems
+extern ECSCommandBuffer registry_commands;
@@ -0,0 +1,127 @@
+#include "ecs_memory.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <new>
+
+constexpr size_t PoolResource::NUM_CLASSES;
+constexpr size_t PoolResource::MIN_BLOCK;
+constexpr size_t PoolResource::CHUNK_BYTES;
+constexpr size_t MonotonicArena::CHUNK_BYTES;
+
+size_t PoolResource::size_class(size_t bytes) {
+  size_t c = 0;
+  while (c < NUM_CLASSES && class_bytes(c) < bytes) {
+    c++;
+  }
+  return c;
+}
+
+PoolResource::~PoolResource() {
+  for (void* chunk : chunks) {
+    ::operator delete(chunk);
+  }
+}
+
+void* PoolResource::allocate(size_t bytes, size_t align) {
+  size_t c = size_class(bytes);
+  // every class is a multiple of 16 bytes, so blocks stay max-aligned
+  if (c == NUM_CLASSES || align > alignof(std::max_align_t)) {
+    assert(align <= alignof(std::max_align_t) &&
+           "over-aligned component memory is not supported");
+    return ::operator new(bytes);
+  }
+
+  if (FreeBlock* block = free_lists[c]) {
+    free_lists[c] = block->next;
+    return block;
+  }
+
+  size_t size = class_bytes(c);
+  if (chunk_left < size) {
+    // the tail of the old chunk is too small for this class; hand it out to
+    // the smaller ones rather than wasting it
+    while (chunk_left >= MIN_BLOCK) {
+      size_t tail      = size_class(chunk_left + 1) - 1;
+      auto*  block     = reinterpret_cast<FreeBlock*>(chunk_cursor);
+      block->next      = free_lists[tail];
+      free_lists[tail] = block;
+      chunk_cursor += class_bytes(tail);
+      chunk_left -= class_bytes(tail);
+    }
+    chunk_cursor = static_cast<char*>(::operator new(CHUNK_BYTES));
+    chunk_left   = CHUNK_BYTES;
+    chunks.push_back(chunk_cursor);
+  }
+
+  void* p = chunk_cursor;
+  chunk_cursor += size;
+  chunk_left -= size;
+  return p;
+}
+
+void PoolResource::deallocate(void* p, size_t bytes, size_t align) {
+  size_t c = size_class(bytes);
+  if (c == NUM_CLASSES || align > alignof(std::max_align_t)) {
+    ::operator delete(p);
+    return;
+  }
+  auto* block   = static_cast<FreeBlock*>(p);
+  block->next   = free_lists[c];
+  free_lists[c] = block;
+}
+
+MonotonicArena::~MonotonicArena() {
+  for (Chunk& chunk : chunks) {
+    ::operator delete(chunk.data);
+  }
+}
+
+void* MonotonicArena::allocate(size_t bytes, size_t align) {
+  assert(align <= alignof(std::max_align_t) &&
+         "over-aligned component memory is not supported");
+  while (current < chunks.size()) {
+    Chunk&    chunk = chunks[current];
+    uintptr_t base  = reinterpret_cast<uintptr_t>(chunk.data);
+    size_t    start = ((base + offset + align - 1) & ~(align - 1)) - base;
+    if (start + bytes <= chunk.size) {
+      offset = start + bytes;
+      return chunk.data + start;
+    }
+    current++;
+    offset = 0;
+  }
+
+  // out of chunks, oversized requests get a chunk of their own
+  size_t size = std::max(bytes, CHUNK_BYTES);
+  chunks.push_back({static_cast<char*>(::operator new(size)), size});
+  current = chunks.size() - 1;
+  offset  = bytes;
+  return chunks.back().data;
+}
+
+void MonotonicArena::release() {
+  current = 0;
+  offset  = 0;
+}
+
+size_t MonotonicArena::chunk_bytes() const {
+  size_t bytes = 0;
+  for (const Chunk& chunk : chunks) {
+    bytes += chunk.size;
+  }
+  return bytes;
+}
+
+// Both are leaked on purpose: the global registry's components are destroyed
+// after any function-local static, and still hand their memory back here
+PoolResource& component_pool() {
+  static PoolResource* pool = new PoolResource();
+  return *pool;
+}
+
+MonotonicArena& room_arena() {
+  static MonotonicArena* arena = new MonotonicArena();
+  return *arena;
+}
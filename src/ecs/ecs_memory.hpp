@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Where the heap memory owned by components comes from. Mirrors the subset
+// of std::pmr::memory_resource the components need, which C++14 lacks.
+class MemoryResource {
+public:
+  virtual ~MemoryResource() = default;
+
+  virtual void* allocate(size_t bytes, size_t align) = 0;
+  virtual void  deallocate(void* p, size_t bytes, size_t align) = 0;
+};
+
+// Small-object pool shared by all components. Blocks are rounded up to one
+// of a few size classes and recycled through per-class free lists carved
+// from large chunks, so pushing to a component's vector or assigning its
+// string does not go through the general-purpose allocator after warm-up.
+// Anything larger than the biggest class is forwarded to operator new.
+class PoolResource : public MemoryResource {
+  static constexpr size_t NUM_CLASSES = 6;  // 16, 32, ..., 512 bytes
+  static constexpr size_t MIN_BLOCK   = 16;
+  static constexpr size_t CHUNK_BYTES = 64 * 1024;
+
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+
+  FreeBlock*         free_lists[NUM_CLASSES] = {};
+  std::vector<void*> chunks;
+  char*              chunk_cursor = nullptr;
+  size_t             chunk_left   = 0;
+
+  static size_t size_class(size_t bytes);
+  static size_t class_bytes(size_t size_class) {
+    return MIN_BLOCK << size_class;
+  }
+
+public:
+  PoolResource() = default;
+  PoolResource(const PoolResource&) = delete;
+  PoolResource& operator=(const PoolResource&) = delete;
+  ~PoolResource() override;
+
+  void* allocate(size_t bytes, size_t align) override;
+  void  deallocate(void* p, size_t bytes, size_t align) override;
+
+  size_t chunk_bytes() const { return chunks.size() * CHUNK_BYTES; }
+};
+
+// Bump allocator whose memory lives until release(). deallocate() is a
+// no-op; everything handed out is reclaimed at once, and the chunks are
+// kept for the next round so steady-state use does not allocate at all.
+class MonotonicArena : public MemoryResource {
+  static constexpr size_t CHUNK_BYTES = 16 * 1024;
+
+  struct Chunk {
+    char*  data;
+    size_t size;
+  };
+
+  std::vector<Chunk> chunks;
+  size_t             current = 0;  // chunk being bumped
+  size_t             offset  = 0;  // bytes used in the current chunk
+
+public:
+  MonotonicArena() = default;
+  MonotonicArena(const MonotonicArena&) = delete;
+  MonotonicArena& operator=(const MonotonicArena&) = delete;
+  ~MonotonicArena() override;
+
+  void* allocate(size_t bytes, size_t align) override;
+  void  deallocate(void*, size_t, size_t) override {}
+
+  // Invalidates everything allocated so far
+  void release();
+
+  size_t chunk_bytes() const;
+};
+
+// Pool the components draw from by default
+PoolResource& component_pool();
+
+// Arena for components that only live as long as the current room, released
+// by the level system once the room's entities have been destroyed
+MonotonicArena& room_arena();
+
+// Allocator that draws from a MemoryResource, like std::pmr's
+// polymorphic_allocator. A default-constructed one uses component_pool().
+//
+// The allocator travels with its memory when a container is moved (so the
+// swap-and-pop in ComponentContainer::remove keeps arena storage in the
+// arena), but a copy always starts over in the pool. Copying a room-scoped
+// component out, e.g. into a save, therefore never keeps a pointer into the
+// room arena.
+template <typename T>
+class ResourceAllocator {
+  template <typename U>
+  friend class ResourceAllocator;
+
+  MemoryResource* resource;
+
+public:
+  using value_type = T;
+
+  using propagate_on_container_copy_assignment = std::false_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap            = std::true_type;
+
+  ResourceAllocator() : resource(&component_pool()) {}
+  ResourceAllocator(MemoryResource* resource) : resource(resource) {}
+  template <typename U>
+  ResourceAllocator(const ResourceAllocator<U>& other)
+      : resource(other.resource) {}
+
+  T* allocate(size_t n) {
+    return static_cast<T*>(resource->allocate(n * sizeof(T), alignof(T)));
+  }
+  void deallocate(T* p, size_t n) {
+    resource->deallocate(p, n * sizeof(T), alignof(T));
+  }
+
+  ResourceAllocator select_on_container_copy_construction() const {
+    return ResourceAllocator();
+  }
+
+  MemoryResource* get_resource() const { return resource; }
+
+  template <typename U>
+  bool operator==(const ResourceAllocator<U>& other) const {
+    return resource == other.resource;
+  }
+  template <typename U>
+  bool operator!=(const ResourceAllocator<U>& other) const {
+    return resource != other.resource;
+  }
+};
+
+template <typename T>
+using PooledVector = std::vector<T, ResourceAllocator<T>>;
+using PooledString =
+    std::basic_string<char, std::char_traits<char>, ResourceAllocator<char>>;
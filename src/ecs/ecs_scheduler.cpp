@@ -0,0 +1,110 @@
+#include "ecs_scheduler.hpp"
+
+#include <cstdio>
+#include <string>
+
+void check_component_access(unsigned int type_id, ComponentAccess access) {
+  // the system this thread works for, also in the jobs it queued, see
+  // run_system()
+  auto running = static_cast<const SystemScheduler::Entry*>(job_owner());
+  if (running == nullptr || running->access.allows(type_id, access)) {
+    return;
+  }
+  static const char* verbs[] = {"reads", "writes", "adds or removes"};
+  std::string component = registry.stats().containers[type_id].name;
+  fprintf(stderr, "System %s %s %s without declaring it\n", running->name,
+          verbs[(int)access], component.c_str());
+  assert(false && "System touched a component it did not declare");
+}
+
+bool SystemAccess::conflicts(const SystemAccess& other) const {
+  if (is_exclusive || other.is_exclusive) {
+    return true;
+  }
+  return (write_set & (other.read_set | other.write_set)).any() ||
+         (other.write_set & read_set).any();
+}
+
+bool SystemAccess::allows(unsigned int type_id, ComponentAccess access) const {
+  switch (access) {
+    case ComponentAccess::READ:
+      return is_exclusive || read_set.test(type_id) || write_set.test(type_id);
+    case ComponentAccess::WRITE:
+      return is_exclusive || write_set.test(type_id);
+    case ComponentAccess::STRUCTURE:
+      return is_exclusive;
+  }
+  return false;
+}
+
+void SystemScheduler::add(const char* name, const SystemAccess& access,
+                          System system) {
+  size_t i = systems.size();
+  commands.resize(i + 1);
+
+  // Exclusive systems in a row run one after the other on the main thread
+  // either way, they share a task
+  if (access.exclusive_access() && i > 0 &&
+      systems[i - 1].access.exclusive_access()) {
+    systems.push_back({name, access, std::move(system), systems[i - 1].task});
+    return;
+  }
+
+  TaskGraph::Lane lane = access.exclusive_access() ? TaskGraph::Lane::MAIN
+                                                   : TaskGraph::Lane::ANY;
+  TaskGraph::TaskId task = graph.add([this, i] { run_task(i); }, lane);
+  systems.push_back({name, access, std::move(system), task});
+
+  // An edge from the task of every earlier system it conflicts with. Edges
+  // implied by others are kept, frames have a handful of systems.
+  for (size_t before = 0; before < i; before++) {
+    bool first_of_task =
+        before == 0 || systems[before - 1].task != systems[before].task;
+    if (first_of_task && task_conflicts(systems[before].task, access)) {
+      graph.precede(systems[before].task, task);
+    }
+  }
+}
+
+bool SystemScheduler::task_conflicts(TaskGraph::TaskId task,
+                                     const SystemAccess& access) const {
+  for (const Entry& entry : systems) {
+    if (entry.task == task && entry.access.conflicts(access)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void SystemScheduler::run_task(size_t first) {
+  TaskGraph::TaskId task = systems[first].task;
+  for (size_t i = first; i < systems.size() && systems[i].task == task; i++) {
+    run_system(i);
+  }
+}
+
+void SystemScheduler::run_system(size_t i) {
+  Entry& entry = systems[i];
+  if (entry.access.exclusive_access()) {
+    // everything added before has finished, see run()
+    flush_until(i);
+  }
+  // the jobs the system queues are checked against it too. A system
+  // waiting on jobs of its own may run another one meanwhile.
+  const void* outer = job_owner();
+  set_job_owner(&entry);
+  entry.run(commands[i]);
+  set_job_owner(outer);
+}
+
+void SystemScheduler::flush_until(size_t end) {
+  for (; flushed < end; flushed++) {
+    commands[flushed].flush();
+  }
+}
+
+void SystemScheduler::run() {
+  flushed = 0;
+  jobs().run(graph);
+  flush_until(systems.size());
+}
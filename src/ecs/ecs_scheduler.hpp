@@ -0,0 +1,115 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include "ecs_command_buffer.hpp"
+#include "jobs.hpp"
+#include "tiny_ecs.hpp"
+#include "tiny_ecs_registry.hpp"
+
+// The component types a system reads and writes. Systems whose accesses don't
+// conflict (they touch different types, or only read the same ones) may run
+// at the same time, e.g.
+//
+//   SystemAccess().reads<Position>().writes<Motion>()
+//
+// Adding or removing components, creating or destroying entities, drawing
+// random numbers and GL calls are not safe next to anything else, systems
+// doing any of them are declared exclusive(). Parallel systems defer their
+// structural changes to the command buffer they are handed instead.
+class SystemAccess {
+  ComponentSignature read_set;
+  ComponentSignature write_set;
+  bool               is_exclusive = false;
+
+  template <typename... Components>
+  static ComponentSignature signature_of() {
+    ComponentSignature signature;
+    int                expand[] = {
+        0, (signature.set(ECSComponents::component_id<Components>()), 0)...};
+    (void)expand;
+    return signature;
+  }
+
+public:
+  template <typename... Components>
+  SystemAccess& reads() {
+    read_set |= signature_of<Components...>();
+    return *this;
+  }
+
+  template <typename... Components>
+  SystemAccess& writes() {
+    write_set |= signature_of<Components...>();
+    return *this;
+  }
+
+  // Runs on the main thread with no other system running
+  SystemAccess& exclusive() {
+    is_exclusive = true;
+    return *this;
+  }
+
+  bool exclusive_access() const { return is_exclusive; }
+
+  // True if the two must not run at the same time
+  bool conflicts(const SystemAccess& other) const;
+
+  // True if the declaration covers using component type_id that way
+  bool allows(unsigned int type_id, ComponentAccess access) const;
+};
+
+// Runs the systems of a frame in the order they were added, except that
+// systems that don't conflict with each other run at the same time on the
+// job pool. Every system waits for the earlier ones it conflicts with, so a
+// frame ends up in the same state as if it had run serially. Debug builds
+// assert that systems, and the jobs they hand to the pool, only touch the
+// components they declared.
+//
+// Systems are added once and run every frame. The task graph is extended as
+// they are added, running it costs no more than scheduling its tasks.
+// Exclusive systems in a row share a task. A system that only runs in some
+// frames checks so itself.
+class SystemScheduler {
+public:
+  // Structural changes of the system, applied before the next exclusive
+  // system starts, in the order the systems were added
+  using System = std::function<void(ECSCommandBuffer& commands)>;
+
+  SystemScheduler() {}
+
+  // Tasks of the graph refer back to the scheduler
+  SystemScheduler(const SystemScheduler&)            = delete;
+  SystemScheduler& operator=(const SystemScheduler&) = delete;
+
+  // Adds a system after the others, waiting for every one of them it
+  // conflicts with
+  void add(const char* name, const SystemAccess& access, System system);
+
+  size_t size() const { return systems.size(); }
+
+  // Runs every system added so far once. Main thread only.
+  void run();
+
+private:
+  friend void check_component_access(unsigned int    type_id,
+                                     ComponentAccess access);
+
+  struct Entry {
+    const char*       name;
+    SystemAccess      access;
+    System            run;
+    TaskGraph::TaskId task;  // runs the system and those after it in the task
+  };
+  std::vector<Entry>            systems;
+  std::vector<ECSCommandBuffer> commands;  // per system, kept for reuse
+  TaskGraph                     graph;     // a task per system
+  size_t                        flushed = 0;  // systems whose commands ran
+
+  bool task_conflicts(TaskGraph::TaskId task,
+                      const SystemAccess& access) const;
+  void run_task(size_t first);
+  void run_system(size_t i);
+  void flush_until(size_t end);
+};
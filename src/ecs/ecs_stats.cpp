@@ -0,0 +1,24 @@
+#include "ecs_stats.hpp"
+
+using nlohmann::json;
+
+void to_json(json& j, const ContainerStats& stats) {
+  j = {{"name", stats.name},
+       {"count", stats.count},
+       {"capacity", stats.capacity},
+       {"component_bytes", stats.component_bytes},
+       {"index_bytes", stats.index_bytes},
+       {"high_water_mark", stats.high_water_mark}};
+}
+
+void to_json(json& j, const RegistryStats& stats) {
+  j = {{"containers", stats.containers},
+       {"totals",
+        {{"count", stats.count},
+         {"component_bytes", stats.component_bytes},
+         {"index_bytes", stats.index_bytes},
+         {"signature_bytes", stats.signature_bytes}}},
+       {"entities",
+        {{"live", stats.live_entities},
+         {"allocated", stats.allocated_entities}}}};
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+#include "json.hpp"
+#include "tiny_ecs.hpp"
+
+// JSON form of the registry stats, e.g.
+// nlohmann::json stats = registry.stats();
+void to_json(nlohmann::json& j, const ContainerStats& stats);
+void to_json(nlohmann::json& j, const RegistryStats& stats);
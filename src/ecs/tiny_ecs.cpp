@@ -1,6 +1,76 @@
 // internal
 #include "tiny_ecs.hpp"
 
+#include <cstdlib>
+#include <deque>
+#ifdef __GNUG__
+#include <cxxabi.h>
+#endif
+
 // All we need to store besides the containers is the id of every entity and
 // callbacks to be able to remove entities across containers
-unsigned int Entity::id_count = 1;
\ No newline at end of file
+unsigned int Entity::id_count = 1;
+
+namespace {
+// Current generation of every index handed out so far, and the released
+// indices waiting for re-use. Released indices are handed out oldest first so
+// that a single index cycles through its generations as slowly as possible.
+// Both live behind a function as globals (e.g. the player) create entities
+// during static initialization.
+struct EntityIdPool {
+  std::vector<unsigned int> generations = {0};
+  std::deque<unsigned int>  free_indices;
+};
+
+EntityIdPool& id_pool() {
+  static EntityIdPool pool;
+  return pool;
+}
+}  // namespace
+
+unsigned int Entity::create() {
+  EntityIdPool& pool = id_pool();
+  if (pool.free_indices.empty()) {
+    assert(id_count <= ENTITY_INDEX_MASK && "Ran out of entity indices");
+    pool.generations.push_back(0);
+    return id_count++;
+  }
+  unsigned int index = pool.free_indices.front();
+  pool.free_indices.pop_front();
+  return (pool.generations[index] << ENTITY_INDEX_BITS) | index;
+}
+
+bool Entity::is_alive() const {
+  const EntityIdPool& pool = id_pool();
+  return index() != 0 && index() < pool.generations.size() &&
+         pool.generations[index()] == generation();
+}
+
+void Entity::release(Entity e) {
+  if (!e.is_alive()) {
+    return;
+  }
+  EntityIdPool& pool          = id_pool();
+  pool.generations[e.index()] = (e.generation() + 1) & ENTITY_GENERATION_MASK;
+  pool.free_indices.push_back(e.index());
+}
+
+size_t Entity::live_count() {
+  return allocated_count() - id_pool().free_indices.size();
+}
+
+size_t Entity::allocated_count() { return id_pool().generations.size() - 1; }
+
+std::string type_name(const std::type_info& type) {
+#ifdef __GNUG__
+  // GCC and Clang mangle the names typeid hands out, MSVC does not
+  int   status    = 0;
+  char* demangled = abi::__cxa_demangle(type.name(), nullptr, nullptr, &status);
+  if (status == 0) {
+    std::string name(demangled);
+    free(demangled);
+    return name;
+  }
+#endif
+  return type.name();
+}
\ No newline at end of file
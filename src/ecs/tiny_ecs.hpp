@@ -2,23 +2,39 @@
 
 #include <algorithm>
 #include <assert.h>
+#include <bitset>
+#include <cstdint>
 #include <functional>
+#include <limits>
+#include <memory>
 #include <set>
+#include <string>
+#include <tuple>
+#include <type_traits>
 #include <typeindex>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
+// An entity id packs the index of the entity in its low bits and the
+// generation of that index in the remaining high bits. Indices are re-used
+// once an entity is released, the generation tells stale handles apart.
+const unsigned int ENTITY_INDEX_BITS = 20;
+const unsigned int ENTITY_INDEX_MASK = (1u << ENTITY_INDEX_BITS) - 1;
+const unsigned int ENTITY_GENERATION_MASK =
+    (1u << (32 - ENTITY_INDEX_BITS)) - 1;
+
 // Unique identifier for all entities
 class Entity {
   unsigned int id;
   static unsigned int
       id_count; // starts from 1, entit 0 is the default initialization
+
+  // Hands out a released index if there is one, a never used one otherwise
+  static unsigned int create();
+
 public:
-  Entity() {
-    id = id_count++;
-    // Note, indices of already deleted entities arent re-used in this simple
-    // implementation.
-  }
+  Entity() { id = create(); }
   Entity(unsigned int custom_id) : id(custom_id) {}
 
   operator unsigned int() {
@@ -29,127 +45,1190 @@ public:
     return id;
   } // this enables automatic casting to int
 
-  bool operator==(const Entity &other) {
+  bool operator==(const Entity &other) const {
     return id == (unsigned int) other;
   }
+
+  // Position of the entity in id-indexed structures such as sparse indices
+  unsigned int index() const { return id & ENTITY_INDEX_MASK; }
+
+  // How many times the index was re-used before this handle was created
+  unsigned int generation() const { return id >> ENTITY_INDEX_BITS; }
+
+  // False once the entity was released, even if its index was re-used since
+  bool is_alive() const;
+
+  // Frees the index of e for re-use and invalidates all handles to it. Does
+  // nothing for handles that are already stale.
+  static void release(Entity e);
+
+  // Number of entities that are not released
+  static size_t live_count();
+
+  // Number of indices handed out so far, live and waiting for re-use
+  static size_t allocated_count();
+};
+
+// Readable name of a type, e.g. of a component
+std::string type_name(const std::type_info& type);
+
+// Occupancy and memory of a single container
+struct ContainerStats {
+  std::string name;
+  size_t      count           = 0; // live components
+  size_t      capacity        = 0; // components that fit without growing
+  size_t      component_bytes = 0; // components and their entity list
+  size_t      index_bytes     = 0; // sparse index and bookkeeping
+  size_t      high_water_mark = 0; // most components held at once
+};
+
+// Occupancy and memory of a whole registry
+struct RegistryStats {
+  std::vector<ContainerStats> containers;
+
+  // Sums over all containers
+  size_t count           = 0;
+  size_t component_bytes = 0;
+  size_t index_bytes     = 0;
+
+  size_t signature_bytes    = 0;
+  size_t live_entities      = 0;
+  size_t allocated_entities = 0;
+};
+
+// Upper bound on the number of containers in a registry
+const unsigned int MAX_COMPONENT_TYPES = 128;
+
+// One bit per container of a registry, set if an entity has that component
+using ComponentSignature = std::bitset<MAX_COMPONENT_TYPES>;
+
+// The signature of every entity index, kept up to date by the containers. A
+// released entity has no components left, so its index starts out empty
+// when it is re-used.
+class SignatureTable {
+  std::vector<ComponentSignature> signatures;
+
+public:
+  ComponentSignature get(Entity e) const {
+    if (e.index() >= signatures.size()) {
+      return ComponentSignature();
+    }
+    return signatures[e.index()];
+  }
+
+  void set(Entity e, unsigned int type_id) {
+    if (e.index() >= signatures.size()) {
+      signatures.resize(e.index() + 1);
+    }
+    signatures[e.index()].set(type_id);
+  }
+
+  void reset(Entity e, unsigned int type_id) {
+    if (e.index() < signatures.size()) {
+      signatures[e.index()].reset(type_id);
+    }
+  }
+
+  size_t memory() const {
+    return signatures.capacity() * sizeof(ComponentSignature);
+  }
 };
 
-// Common interface to refer to all containers in the ECS registry
+// How a system uses a component type, see SystemAccess in ecs_scheduler.hpp
+enum class ComponentAccess { READ, WRITE, STRUCTURE };
+
+// Asserts that the system this thread works for, run by a SystemScheduler
+// directly or through the jobs it queued, has declared the access to
+// component type_id. Does nothing outside of scheduled systems. Containers of
+// a registry call it in debug builds.
+void check_component_access(unsigned int type_id, ComponentAccess access);
+
+// Common interface to refer to containers of any component type at runtime,
+// e.g. from a command buffer. Registries reach their containers through
+// compile-time component ids instead, see ComponentRegistry.
 struct ContainerInterface {
   virtual void clear() = 0;
   virtual size_t size() = 0;
   virtual void remove(Entity e) = 0;
+  virtual void remove_batch(const std::vector<Entity>& batch) = 0;
   virtual bool has(Entity entity) = 0;
 };
 
+// Lets systems react to components being added to or removed from a
+// container instead of scanning it every frame. Observers are called right
+// away, the added() and removed() lists collect the entities until the system
+// consuming them calls clear_changes().
+class ContainerObservers {
+  std::vector<std::function<void(Entity)>> insert_observers;
+  std::vector<std::function<void(Entity)>> remove_observers;
+
+  bool                tracking = false;
+  std::vector<Entity> added_entities;
+  std::vector<Entity> removed_entities;
+
+protected:
+  void notify_insert(Entity e) {
+    if (tracking) added_entities.push_back(e);
+    for (auto& observer : insert_observers) observer(e);
+  }
+
+  // Called while the component of e can still be read
+  void notify_remove(Entity e) {
+    if (tracking) removed_entities.push_back(e);
+    for (auto& observer : remove_observers) observer(e);
+  }
+
+public:
+  // Calls observer with every entity that receives a component
+  void on_insert(std::function<void(Entity)> observer) {
+    insert_observers.push_back(std::move(observer));
+  }
+
+  // Calls observer with every entity that is about to lose its component
+  void on_remove(std::function<void(Entity)> observer) {
+    remove_observers.push_back(std::move(observer));
+  }
+
+  // Starts recording added() and removed(), containers nobody consumes the
+  // lists of don't pay for them
+  void track_changes() { tracking = true; }
+
+  // The entities that received or lost a component since the last
+  // clear_changes(). An entity can show up in both, has() tells which came
+  // last.
+  const std::vector<Entity>& added() const { return added_entities; }
+  const std::vector<Entity>& removed() const { return removed_entities; }
+
+  void clear_changes() {
+    added_entities.clear();
+    removed_entities.clear();
+  }
+};
+
+// Number of entity ids covered by a single page of a container's sparse index
+const unsigned int SPARSE_PAGE_SIZE = 1024;
+
+// Marks an entity id that has no component in a container's sparse index
+const unsigned int INVALID_COMPONENT_ID =
+    std::numeric_limits<unsigned int>::max();
+
+// The paged sparse array from Entity index -> array index of a container. A
+// page is only allocated once an entity in its index range is added, so
+// containers with few, scattered entities stay small. Slots are keyed by index
+// alone, the container's entities array tells live handles from stale ones.
+class SparseIndex {
+  std::vector<std::unique_ptr<unsigned int[]>> pages;
+
+public:
+  // Returns the slot holding the array index of e, or nullptr if its page has
+  // never been allocated
+  unsigned int* find_slot(Entity e) const {
+    unsigned int page = e.index() / SPARSE_PAGE_SIZE;
+    if (page >= pages.size() || !pages[page]) {
+      return nullptr;
+    }
+    return &pages[page][e.index() % SPARSE_PAGE_SIZE];
+  }
+
+  // Returns the slot holding the array index of e, allocating its page
+  unsigned int& slot(Entity e) {
+    unsigned int page = e.index() / SPARSE_PAGE_SIZE;
+    if (page >= pages.size()) {
+      pages.resize(page + 1);
+    }
+    if (!pages[page]) {
+      pages[page].reset(new unsigned int[SPARSE_PAGE_SIZE]);
+      std::fill_n(pages[page].get(), SPARSE_PAGE_SIZE, INVALID_COMPONENT_ID);
+    }
+    return pages[page][e.index() % SPARSE_PAGE_SIZE];
+  }
+
+  // The allocated pages and the page table
+  size_t memory() const {
+    size_t bytes = pages.capacity() * sizeof(pages[0]);
+    for (const auto& page : pages)
+      if (page) bytes += SPARSE_PAGE_SIZE * sizeof(unsigned int);
+    return bytes;
+  }
+};
+
+// How a container lays out its components, an array of structs by default.
+// Hot components can opt into a struct of arrays by specializing this with a
+// layout that keeps one contiguous array per field and hands out proxies of
+// field references, see PositionArrays.
+template <typename Component>
+struct ComponentStorage {
+  using type = std::vector<Component>;
+};
+
+// Shrinks the capacity of v to n, or to its size if that is larger, with a
+// single reallocation. Does nothing if v has no more room than that. Struct
+// of arrays layouts overload it for their arrays, see PositionArrays.
+template <typename T, typename Allocator>
+void shrink_capacity(std::vector<T, Allocator>& v, size_t n) {
+  n = std::max(n, v.size());
+  if (v.capacity() <= n) {
+    return;
+  }
+  std::vector<T, Allocator> shrunk(v.get_allocator());
+  shrunk.reserve(n);
+  shrunk.insert(shrunk.end(), std::make_move_iterator(v.begin()),
+                std::make_move_iterator(v.end()));
+  v.swap(shrunk);
+}
+
 // A container that stores components of type 'Component' and associated
-// entities
-template <typename Component> // A component can be any class
-class ComponentContainer : public ContainerInterface {
+// entities. Empty component types are stored in a TagContainer instead.
+template <typename Component, // A component can be any class
+          bool IsTag = std::is_empty<Component>::value>
+class ComponentContainer : public ContainerInterface,
+                           public ContainerObservers {
 private:
-  // The hash map from Entity -> array index.
-  std::unordered_map<unsigned int, unsigned int>
-      map_entity_componentID; // the entity is cast to uint to be hashable.
-  bool registered = false;
+  // Entity index -> array index, see SparseIndex
+  SparseIndex sparse;
+
+  // Signatures of the registry this container belongs to, if any
+  SignatureTable* signatures = nullptr;
+  unsigned int    type_id    = 0;
+
+  // Most components this container held at once
+  size_t high_water_mark = 0;
+
+  // The frame counter of the registry, stamped into versions
+  const unsigned int* clock = nullptr;
+
+  // The frame each component was inserted or last written through one of the
+  // *_mut() accessors, parallel to components
+  std::vector<unsigned int> versions;
+
+  unsigned int now() const { return clock ? *clock : 0; }
+
+  unsigned int* find_slot(Entity e) const { return sparse.find_slot(e); }
+  unsigned int& slot(Entity e) { return sparse.slot(e); }
+
+  void check(ComponentAccess access) const {
+#ifndef NDEBUG
+    if (signatures) check_component_access(type_id, access);
+#endif
+  }
 
 public:
+  using Storage = typename ComponentStorage<Component>::type;
+
+  // Component& for arrays of structs, a proxy of field references for
+  // struct of arrays layouts
+  using reference = decltype(std::declval<Storage&>()[0]);
+
+  // const Component& for arrays of structs, a copy for struct of arrays
+  using const_reference = decltype(std::declval<const Storage&>()[0]);
+
   // Container of all components of type 'Component'
-  std::vector<Component> components;
+  Storage components;
 
   // The corresponding entities
   std::vector<Entity> entities;
 
-  // Constructor that registers the type
   ComponentContainer() {}
 
+  // The sparse index owns its pages, containers are only ever referenced
+  ComponentContainer(const ComponentContainer&)            = delete;
+  ComponentContainer& operator=(const ComponentContainer&) = delete;
+
+  // Makes the container record its entities in table under bit type_id
+  void set_signature_table(SignatureTable* table, unsigned int type_id) {
+    signatures    = table;
+    this->type_id = type_id;
+  }
+
+  // Makes the container stamp changes with the frame counted by frame
+  void set_clock(const unsigned int* frame) { clock = frame; }
+
   // Inserting a component c associated to entity e
-  inline Component &insert(Entity e, Component c,
-                           bool check_for_duplicates = true) {
+  inline reference insert(Entity e, Component c,
+                          bool check_for_duplicates = true) {
     // Usually, every entity should only have one instance of each component
     // type
     assert(!(check_for_duplicates && has(e)) &&
            "Entity already contained in ECS registry");
+    assert(e.is_alive() && "Entity was already released");
+    check(ComponentAccess::STRUCTURE);
 
-    map_entity_componentID[e] = (unsigned int)components.size();
+    slot(e) = (unsigned int)components.size();
+    if (signatures) signatures->set(e, type_id);
     components.push_back(
         std::move(c)); // the move enforces move instead of copy constructor
     entities.push_back(e);
+    versions.push_back(now());
+    high_water_mark = std::max(high_water_mark, entities.size());
+    notify_insert(e);
     return components.back();
   };
 
   // The emplace function takes the the provided arguments Args, creates a new
   // object of type Component, and inserts it into the ECS system
-  template <typename... Args> Component &emplace(Entity e, Args &&...args) {
+  template <typename... Args> reference emplace(Entity e, Args &&...args) {
     return insert(e, Component(std::forward<Args>(args)...));
   };
 
   template <typename... Args>
-  Component &emplace_with_duplicates(Entity e, Args &&...args) {
+  reference emplace_with_duplicates(Entity e, Args &&...args) {
     return insert(e, Component(std::forward<Args>(args)...), false);
   };
 
-  // A wrapper to return the component of an entity
-  Component &get(Entity e) {
+  // A wrapper to return the component of an entity for reading, writers use
+  // get_mut() so that changed_since() sees their writes
+  const_reference get(Entity e) const {
+    assert(find(e) != INVALID_COMPONENT_ID &&
+           "Entity not contained in ECS registry");
+    check(ComponentAccess::READ);
+    return components[*find_slot(e)];
+  }
+
+  // The component of e for writing, stamped as changed in the current frame
+  reference get_mut(Entity e) {
     assert(has(e) && "Entity not contained in ECS registry");
-    return components[map_entity_componentID[e]];
+    check(ComponentAccess::WRITE);
+    unsigned int id = *find_slot(e);
+    versions[id]    = now();
+    return components[id];
+  }
+
+  // The frame the component of e was inserted or last changed in
+  unsigned int version(Entity e) const {
+    assert(find(e) != INVALID_COMPONENT_ID &&
+           "Entity not contained in ECS registry");
+    return versions[*find_slot(e)];
+  }
+
+  // True if the component of e was inserted or changed in frame 'since' or
+  // later
+  bool changed_since(Entity e, unsigned int since) const {
+    unsigned int id = find(e);
+    return id != INVALID_COMPONENT_ID && versions[id] >= since;
+  }
+
+  // The entities whose component was inserted or changed in frame 'since' or
+  // later. A system passing the frame it last ran in sees every change since,
+  // the ones made later in that frame included.
+  std::vector<Entity> changed_since(unsigned int since) const {
+    check(ComponentAccess::READ);
+    std::vector<Entity> changed;
+    for (size_t i = 0; i < versions.size(); i++) {
+      if (versions[i] >= since) changed.push_back(entities[i]);
+    }
+    return changed;
+  }
+
+  // Returns the array index of the component of e, or INVALID_COMPONENT_ID if
+  // e has none. Together with at() this saves the second lookup of a has(e)
+  // followed by a get(e).
+  unsigned int find(Entity e) const {
+    check(ComponentAccess::READ);
+    unsigned int* id = find_slot(e);
+    if (id == nullptr || *id == INVALID_COMPONENT_ID || !(entities[*id] == e)) {
+      return INVALID_COMPONENT_ID;
+    }
+    return *id;
+  }
+
+  // The component at array index i for reading, see find()
+  const_reference at(unsigned int i) const {
+    check(ComponentAccess::READ);
+    return components[i];
+  }
+
+  // The same for writing, stamped as changed in the current frame
+  reference at_mut(unsigned int i) {
+    check(ComponentAccess::WRITE);
+    versions[i] = now();
+    return components[i];
+  }
+
+  // Returns the component of e for reading, or nullptr if e has none. Only
+  // available for arrays of structs.
+  const Component* try_get(Entity e) const {
+    unsigned int id = find(e);
+    return id == INVALID_COMPONENT_ID ? nullptr : &components[id];
+  }
+
+  // The same for writing, stamped as changed in the current frame
+  Component* try_get_mut(Entity e) {
+    unsigned int id = find(e);
+    return id == INVALID_COMPONENT_ID ? nullptr : &at_mut(id);
   }
 
   // Check if entity has a component of type 'Component'
-  bool has(Entity entity) { return map_entity_componentID.count(entity) > 0; }
+  bool has(Entity entity) { return find(entity) != INVALID_COMPONENT_ID; }
 
   // Remove an component and pack the container to re-use the empty space
   void remove(Entity e) {
-    if (has(e)) {
-      // Get the current position
-      int cID = map_entity_componentID[e];
-
-      // Move the last element to position cID using the move operator
-      // Note, components[cID] = components.back() would trigger the copy
-      // instead of move operator
-      components[cID] = std::move(components.back());
-      entities[cID] =
-          entities.back(); // the entity is only a single index, copy it.
-      map_entity_componentID[entities.back()] = cID;
-
-      // Erase the old component and free its memory
-      map_entity_componentID.erase(e);
-      components.pop_back();
-      entities.pop_back();
-      // Note, one could mark the id for re-use
+    if (!has(e)) {
+      return;
     }
+    check(ComponentAccess::STRUCTURE);
+    notify_remove(e);
+    // Get the current position
+    unsigned int* id = find_slot(e);
+    unsigned int cID = *id;
+
+    // Move the last element to position cID using the move operator
+    // Note, components[cID] = components.back() would trigger the copy
+    // instead of move operator
+    components[cID] = std::move(components.back());
+    entities[cID] =
+        entities.back(); // the entity is only a single index, copy it.
+    versions[cID]               = versions.back();
+    *find_slot(entities.back()) = cID;
+
+    // Erase the old component and free its memory
+    *id = INVALID_COMPONENT_ID;
+    if (signatures) signatures->reset(e, type_id);
+    components.pop_back();
+    entities.pop_back();
+    versions.pop_back();
   };
 
+  // Remove the components of all entities in batch with a single compaction
+  // sweep over the container. The remaining components keep their order, e.g.
+  // the one sort_by_component() put them in, whatever the size of the batch.
+  void remove_batch(const std::vector<Entity>& batch) {
+    if (entities.empty()) {
+      return;
+    }
+    check(ComponentAccess::STRUCTURE);
+    // Unlink the removed entities first, the sweep recognizes them by their
+    // invalidated slot
+    bool removed_any = false;
+    for (Entity e : batch) {
+      if (!has(e)) {
+        continue;
+      }
+      notify_remove(e);
+      *find_slot(e) = INVALID_COMPONENT_ID;
+      if (signatures) signatures->reset(e, type_id);
+      removed_any = true;
+    }
+    if (!removed_any) {
+      return;
+    }
+
+    unsigned int kept = 0;
+    for (unsigned int i = 0; i < entities.size(); i++) {
+      unsigned int* id = find_slot(entities[i]);
+      if (*id == INVALID_COMPONENT_ID) {
+        continue;
+      }
+      if (kept != i) {
+        components[kept] = std::move(components[i]);
+        entities[kept]   = entities[i];
+        versions[kept]   = versions[i];
+        *id              = kept;
+      }
+      kept++;
+    }
+    while (components.size() > kept) components.pop_back();
+    entities.resize(kept);
+    versions.resize(kept);
+  }
+
+  // Makes room for n components, so that inserting them does not reallocate
+  void reserve(size_t n) {
+    check(ComponentAccess::STRUCTURE);
+    components.reserve(n);
+    entities.reserve(n);
+    versions.reserve(n);
+  }
+
+  // Frees the memory held beyond room for 'spare' more components, e.g. after
+  // tearing down a large room. Every array is reallocated at most once.
+  void shrink_to_fit(size_t spare = 0) {
+    check(ComponentAccess::STRUCTURE);
+    size_t n = entities.size() + spare;
+    shrink_capacity(components, n);
+    shrink_capacity(entities, n);
+    shrink_capacity(versions, n);
+    order.clear();
+    order.shrink_to_fit();
+  }
+
   // Remove all components of type 'Component'
   void clear() {
-    map_entity_componentID.clear();
+    check(ComponentAccess::STRUCTURE);
+    for (Entity e : entities) notify_remove(e);
+    for (Entity e : entities) {
+      *find_slot(e) = INVALID_COMPONENT_ID;
+      if (signatures) signatures->reset(e, type_id);
+    }
     components.clear();
     entities.clear();
+    versions.clear();
   }
 
   // Report the number of components of type 'Component'
   size_t size() { return components.size(); }
 
+  // Number of components that fit without reallocating
+  size_t capacity() const { return components.capacity(); }
+
+  ContainerStats stats() const {
+    ContainerStats stats;
+    stats.name            = type_name(typeid(Component));
+    stats.count           = entities.size();
+    stats.capacity        = components.capacity();
+    stats.high_water_mark = high_water_mark;
+
+    stats.component_bytes = components.capacity() * sizeof(Component) +
+                            entities.capacity() * sizeof(Entity) +
+                            versions.capacity() * sizeof(unsigned int);
+
+    // the sparse index and the scratch space of sort()
+    stats.index_bytes =
+        sparse.memory() + order.capacity() * sizeof(unsigned int);
+    return stats;
+  }
+
   // Sort the components and associated entity assignment structures by the
-  // comparisonFunction, see std::sort
+  // comparisonFunction on entities, see std::sort
   template <class Compare> void sort(Compare comparisonFunction) {
-    // First sort the entity list as desired
+    sort_order([&](unsigned int a, unsigned int b) {
+      return comparisonFunction(entities[a], entities[b]);
+    });
+  }
+
+  // Sort the components and associated entity assignment structures by the
+  // comparisonFunction on components, e.g. render requests by texture
+  template <class Compare> void sort_by_component(Compare comparisonFunction) {
+    sort_order([&](unsigned int a, unsigned int b) {
+      return comparisonFunction(components[a], components[b]);
+    });
+  }
+
+private:
+  // Scratch space of sort(), kept to not allocate on every call
+  std::vector<unsigned int> order;
+
+  // Sorts the array indices by compare, then moves every component to its
+  // sorted position in place
+  template <class Compare> void sort_order(Compare compare) {
+    check(ComponentAccess::STRUCTURE);
+    order.resize(entities.size());
+    for (unsigned int i = 0; i < order.size(); i++) order[i] = i;
+    std::sort(order.begin(), order.end(), compare);
+    apply_order();
+  }
+
+  // Puts the component at array index order[i] at index i. The permutation
+  // is made up of cycles, each of them is rotated with a single temporary,
+  // and every index is updated once its component has arrived. Entries of
+  // order are reset to i when done, which marks the cycles already rotated.
+  void apply_order() {
+    for (unsigned int start = 0; start < order.size(); start++) {
+      if (order[start] == start) {
+        continue;
+      }
+      Component    component = std::move(components[start]);
+      Entity       entity    = entities[start];
+      unsigned int version   = versions[start];
+      unsigned int i         = start;
+      while (order[i] != start) {
+        unsigned int next       = order[i];
+        components[i]           = std::move(components[next]);
+        entities[i]             = entities[next];
+        versions[i]             = versions[next];
+        *find_slot(entities[i]) = i;
+        order[i]                = i;
+        i                       = next;
+      }
+      components[i]      = std::move(component);
+      entities[i]        = entity;
+      versions[i]        = version;
+      *find_slot(entity) = i;
+      order[i]           = i;
+    }
+  }
+};
+
+// A container for components without data, such as ActiveWall. Only which
+// entities carry the tag is stored: one bit per entity index answers has(),
+// and a dense entity list serves iteration. The position of each entity in
+// that list is kept in a SparseIndex, as in ComponentContainer, so untagging
+// takes constant time. All entities share one instance of the tag for the
+// has/get interface of ComponentContainer.
+template <typename Tag>
+class TagContainer : public ContainerInterface, public ContainerObservers {
+  static_assert(std::is_empty<Tag>::value, "Tags must not hold any data");
+
+  // Bit i % 64 of word i / 64 is set if the entity with index i has the tag
+  std::vector<uint64_t> bits;
+
+  // Entity index -> position in entities
+  SparseIndex positions;
+
+  // Signatures of the registry this container belongs to, if any
+  SignatureTable* signatures = nullptr;
+  unsigned int    type_id    = 0;
+
+  // Most entities tagged at once
+  size_t high_water_mark = 0;
+
+  static Tag instance;
+
+  bool test(unsigned int index) const {
+    return index / 64 < bits.size() && (bits[index / 64] >> (index % 64)) & 1;
+  }
+
+  void set_bit(unsigned int index) {
+    if (index / 64 >= bits.size()) {
+      bits.resize(index / 64 + 1, 0);
+    }
+    bits[index / 64] |= uint64_t(1) << (index % 64);
+  }
+
+  void untag(Entity e) {
+    bits[e.index() / 64] &= ~(uint64_t(1) << (e.index() % 64));
+    *positions.find_slot(e) = INVALID_COMPONENT_ID;
+    if (signatures) signatures->reset(e, type_id);
+  }
+
+  void reindex() {
+    for (unsigned int i = 0; i < entities.size(); i++) {
+      *positions.find_slot(entities[i]) = i;
+    }
+  }
+
+  void check(ComponentAccess access) const {
+#ifndef NDEBUG
+    if (signatures) check_component_access(type_id, access);
+#endif
+  }
+
+public:
+  using reference       = Tag&;
+  using const_reference = const Tag&;
+
+  // The entities that have the tag
+  std::vector<Entity> entities;
+
+  TagContainer() {}
+
+  TagContainer(const TagContainer&)            = delete;
+  TagContainer& operator=(const TagContainer&) = delete;
+
+  void set_signature_table(SignatureTable* table, unsigned int type_id) {
+    signatures    = table;
+    this->type_id = type_id;
+  }
+
+  // Tags carry no data that could change
+  void set_clock(const unsigned int*) {}
+
+  // Tags entity e, the tag itself carries nothing worth keeping
+  Tag& insert(Entity e, Tag = Tag(), bool check_for_duplicates = true) {
+    assert(!(check_for_duplicates && has(e)) &&
+           "Entity already contained in ECS registry");
+    assert(e.is_alive() && "Entity was already released");
+    if (has(e)) {
+      return instance;
+    }
+    check(ComponentAccess::STRUCTURE);
+
+    unsigned int& position = positions.slot(e);
+    if (test(e.index())) {
+      // the index is still tagged for an entity released without being
+      // untagged, e takes over its place
+      entities[position] = e;
+    } else {
+      set_bit(e.index());
+      position = (unsigned int)entities.size();
+      entities.push_back(e);
+      high_water_mark = std::max(high_water_mark, entities.size());
+    }
+    if (signatures) signatures->set(e, type_id);
+    notify_insert(e);
+    return instance;
+  }
+
+  template <typename... Args>
+  Tag& emplace(Entity e, Args&&... args) {
+    return insert(e, Tag(std::forward<Args>(args)...));
+  }
+
+  template <typename... Args>
+  Tag& emplace_with_duplicates(Entity e, Args&&... args) {
+    return insert(e, Tag(std::forward<Args>(args)...), false);
+  }
+
+  Tag& get(Entity e) {
+    assert(has(e) && "Entity not contained in ECS registry");
+    return instance;
+  }
+
+  Tag* try_get(Entity e) { return has(e) ? &instance : nullptr; }
+
+  Tag* try_get_mut(Entity e) { return try_get(e); }
+
+  // Tags have no array of their own, any index but INVALID_COMPONENT_ID
+  // stands for the shared instance
+  unsigned int find(Entity e) { return has(e) ? 0 : INVALID_COMPONENT_ID; }
+
+  const Tag& at(unsigned int) const {
+    check(ComponentAccess::READ);
+    return instance;
+  }
+
+  // Tags carry no data that could change, there is nothing to stamp
+  Tag& at_mut(unsigned int) {
+    check(ComponentAccess::WRITE);
+    return instance;
+  }
+
+  // A clear bit answers no by itself. A set bit may belong to a newer entity
+  // re-using the index of a stale handle, so only then is the tagged handle
+  // compared to e. A released entity is found until it is untagged, as in
+  // ComponentContainer.
+  bool has(Entity e) {
+    check(ComponentAccess::READ);
+    return test(e.index()) && entities[*positions.find_slot(e)] == e;
+  }
+
+  // Untags e by moving the last tagged entity into its place
+  void remove(Entity e) {
+    if (!has(e)) {
+      return;
+    }
+    check(ComponentAccess::STRUCTURE);
+    notify_remove(e);
+    unsigned int position = *positions.find_slot(e);
+    untag(e);
+    if (position != entities.size() - 1) {
+      Entity last                   = entities.back();
+      entities[position]         = last;
+      *positions.find_slot(last) = position;
+    }
+    entities.pop_back();
+  }
+
+  // Untags all entities in batch with a single sweep over the dense list
+  void remove_batch(const std::vector<Entity>& batch) {
+    if (entities.empty()) {
+      return;
+    }
+    check(ComponentAccess::STRUCTURE);
+    bool removed_any = false;
+    for (Entity e : batch) {
+      if (has(e)) {
+        notify_remove(e);
+        untag(e);
+        removed_any = true;
+      }
+    }
+    if (removed_any) {
+      entities.erase(std::remove_if(entities.begin(), entities.end(),
+                                    [this](Entity e) {
+                                      return *positions.find_slot(e) ==
+                                             INVALID_COMPONENT_ID;
+                                    }),
+                     entities.end());
+      reindex();
+    }
+  }
+
+  void clear() {
+    check(ComponentAccess::STRUCTURE);
+    for (Entity e : entities) notify_remove(e);
+    for (Entity e : entities) untag(e);
+    entities.clear();
+  }
+
+  size_t size() { return entities.size(); }
+
+  size_t capacity() const { return entities.capacity(); }
+
+  void reserve(size_t n) {
+    check(ComponentAccess::STRUCTURE);
+    entities.reserve(n);
+  }
+
+  void shrink_to_fit(size_t spare = 0) {
+    check(ComponentAccess::STRUCTURE);
+    shrink_capacity(entities, entities.size() + spare);
+  }
+
+  // Tags take no memory of their own, only the entity list and its index do
+  ContainerStats stats() const {
+    ContainerStats stats;
+    stats.name            = type_name(typeid(Tag));
+    stats.count           = entities.size();
+    stats.capacity        = entities.capacity();
+    stats.component_bytes = entities.capacity() * sizeof(Entity);
+    stats.index_bytes =
+        bits.capacity() * sizeof(uint64_t) + positions.memory();
+    stats.high_water_mark = high_water_mark;
+    return stats;
+  }
+
+  // Sort the tagged entities by the comparisonFunction, see std::sort
+  template <class Compare>
+  void sort(Compare comparisonFunction) {
+    check(ComponentAccess::STRUCTURE);
     std::sort(entities.begin(), entities.end(), comparisonFunction);
-    // Now re-arrange the components (Note, creates a new vector, which may be
-    // slow! Not sure if in-place could be faster:
-    // https://stackoverflow.com/questions/63703637/how-to-efficiently-permute-an-array-in-place-using-stdswap)
-    std::vector<Component> components_new;
-    components_new.reserve(components.size());
-    std::transform(
-        entities.begin(), entities.end(), std::back_inserter(components_new),
-        [&](Entity e) {
-          return std::move(get(e));
-        }); // note, the get still uses the old hash map (on purpose!)
-    components =
-        std::move(components_new); // note, we use move operations to not create
-                                   // unneccesary copies of objects, but memory
-                                   // is still allocated for the new vector
-    // Fill the new hashmap
-    for (unsigned int i = 0; i < entities.size(); i++)
-      map_entity_componentID[entities[i]] = i;
+    reindex();
+  }
+};
+
+template <typename Tag>
+Tag TagContainer<Tag>::instance;
+
+template <typename Tag>
+class ComponentContainer<Tag, true> : public TagContainer<Tag> {};
+
+// Component types to leave out of a view, e.g.
+// registry.view<Motion, Mass>(exclude<Player>)
+template <typename... Excluded>
+struct ExcludeList {};
+
+template <typename... Excluded>
+constexpr ExcludeList<Excluded...> exclude{};
+
+// True if T is one of 'Types'
+template <typename T, typename... Types>
+struct Contains : std::false_type {};
+
+template <typename T, typename First, typename... Rest>
+struct Contains<T, First, Rest...>
+    : std::integral_constant<bool, std::is_same<T, First>::value ||
+                                       Contains<T, Rest...>::value> {};
+
+// All entities that have every component in 'Components' and none of the
+// excluded ones. Iteration walks the smallest of the requested containers.
+// Whether an entity matches is read off its signature, the components are
+// looked up once per container when they are handed out.
+template <typename... Components>
+class ComponentView {
+  static_assert(sizeof...(Components) > 0, "A view needs a component type");
+
+  std::tuple<ComponentContainer<Components>*...> containers;
+
+  // Signatures of the registry and the bits of the required and excluded
+  // component types in them
+  const SignatureTable* signatures;
+  ComponentSignature    required;
+  ComponentSignature    excluded;
+
+  // Entities of the smallest requested container, iteration is driven by it
+  const std::vector<Entity>* driver = nullptr;
+
+  bool matches(Entity e) const {
+    ComponentSignature signature = signatures->get(e);
+    return (signature & required) == required && (signature & excluded).none();
+  }
+
+  // Hands out the component of e in container for reading, or for writing
+  // when Write is true_type
+  template <typename Component>
+  static typename ComponentContainer<Component>::const_reference
+  component_of(ComponentContainer<Component>* container, Entity e,
+               std::false_type) {
+    return container->at(container->find(e));
+  }
+
+  template <typename Component>
+  static typename ComponentContainer<Component>::reference
+  component_of(ComponentContainer<Component>* container, Entity e,
+               std::true_type) {
+    return container->at_mut(container->find(e));
+  }
+
+  template <class Access, class Callback, size_t... I>
+  void visit(Callback& callback, Entity e, std::index_sequence<I...>) {
+    if (!matches(e)) return;
+    callback(e, component_of(std::get<I>(containers), e,
+                             typename Access::template writes<Components>{})...);
+  }
+
+  template <class Access, class Callback>
+  void for_each(Callback& callback) {
+    for (size_t i = 0; i < driver->size();) {
+      Entity e = (*driver)[i];
+      visit<Access>(callback, e, std::index_sequence_for<Components...>{});
+      if (i < driver->size() && (*driver)[i] == e) i++;
+    }
+  }
+
+  struct ReadAll {
+    template <typename Component>
+    using writes = std::false_type;
+  };
+
+  // Writes the components in 'Written', or all of them if it is empty
+  template <typename... Written>
+  struct WriteSome {
+    template <typename Component>
+    using writes =
+        std::integral_constant<bool, sizeof...(Written) == 0 ||
+                                         Contains<Component, Written...>::value>;
+  };
+
+public:
+  ComponentView(ComponentContainer<Components>&... included,
+                const SignatureTable* signatures, ComponentSignature required,
+                ComponentSignature excluded)
+      : containers(&included...),
+        signatures(signatures),
+        required(required),
+        excluded(excluded) {
+    for (const std::vector<Entity>* entities : {&included.entities...})
+      if (driver == nullptr || entities->size() < driver->size())
+        driver = entities;
+  }
+
+  // Calls callback(entity, const components&...) for every entity in the
+  // view. The callback may remove the entity it was called for, the entity
+  // swapped into its place is visited next.
+  template <class Callback>
+  void each(Callback callback) {
+    for_each<ReadAll>(callback);
+  }
+
+  // The same, handing out the components in 'Written' (all of them if none
+  // are named) for writing, e.g. each_mut<Motion>(...). These are stamped as
+  // changed in the current frame before the callback is called, so loops that
+  // only write some of the entities they visit use each() and get_mut().
+  template <typename... Written, class Callback>
+  void each_mut(Callback callback) {
+    for_each<WriteSome<Written...>>(callback);
+  }
+
+  // A wrapper to return a requested component of an entity in the view for
+  // reading
+  template <typename Component>
+  typename ComponentContainer<Component>::const_reference get(Entity e) const {
+    return std::get<ComponentContainer<Component>*>(containers)->get(e);
+  }
+
+  // The same for writing, stamped as changed in the current frame
+  template <typename Component>
+  typename ComponentContainer<Component>::reference get_mut(Entity e) {
+    return std::get<ComponentContainer<Component>*>(containers)->get_mut(e);
+  }
+
+  // Forward iterator over the entities in the view, for range based loops.
+  // Use each() instead when entities get removed while iterating.
+  class iterator {
+    const ComponentView* view;
+    size_t               i;
+
+    void skip_mismatches() {
+      while (i < view->driver->size() && !view->matches((*view->driver)[i]))
+        i++;
+    }
+
+  public:
+    iterator(const ComponentView* view, size_t i) : view(view), i(i) {
+      skip_mismatches();
+    }
+
+    Entity operator*() const { return (*view->driver)[i]; }
+
+    iterator& operator++() {
+      i++;
+      skip_mismatches();
+      return *this;
+    }
+
+    bool operator!=(const iterator& other) const { return i != other.i; }
+  };
+
+  iterator begin() const { return iterator(this, 0); }
+  iterator end() const { return iterator(this, driver->size()); }
+};
+
+// The position of T in 'Types', the compile-time id of a component type in a
+// ComponentRegistry
+template <typename T, typename... Types>
+struct TypeIndex;
+
+template <typename T, typename... Rest>
+struct TypeIndex<T, T, Rest...> : std::integral_constant<unsigned int, 0> {};
+
+template <typename T, typename First, typename... Rest>
+struct TypeIndex<T, First, Rest...>
+    : std::integral_constant<unsigned int,
+                             1 + TypeIndex<T, Rest...>::value> {};
+
+template <typename T>
+struct TypeIndex<T> {
+  static_assert(sizeof(T) == 0, "Component type has no container in registry");
+};
+
+// A registry holding one container per type in 'Components'. The type list is
+// the only place a component type is listed: its position there is the
+// component id, the bit the type takes in entity signatures. Loops over all
+// containers are unrolled at compile time, so neither lookups nor removals go
+// through virtual calls.
+template <typename... Components>
+class ComponentRegistry {
+  static_assert(sizeof...(Components) <= MAX_COMPONENT_TYPES,
+                "Raise MAX_COMPONENT_TYPES to add more containers");
+
+  std::tuple<ComponentContainer<Components>...> containers;
+
+  // Which containers every entity is in, bit i standing for the i-th type
+  SignatureTable signatures;
+
+  // Counts the frames components are stamped with when they change, starting
+  // at 1 so that 0 predates everything
+  unsigned int current_frame = 1;
+
+  using Indices = std::index_sequence_for<Components...>;
+
+  template <class F, size_t... I>
+  void for_each_container(F& f, std::index_sequence<I...>) {
+    int expand[] = {0, (f(std::get<I>(containers)), 0)...};
+    (void)expand;
+  }
+
+  template <class F, size_t... I>
+  void for_each_container_in(ComponentSignature signature, F& f,
+                             std::index_sequence<I...>) {
+    if (signature.none()) return;
+    int expand[] = {0, (signature.test(I) ? f(std::get<I>(containers)) : void(),
+                        0)...};
+    (void)expand;
+  }
+
+  template <size_t... I>
+  void set_signature_tables(std::index_sequence<I...>) {
+    int expand[] = {
+        0, (std::get<I>(containers).set_signature_table(&signatures, I),
+            std::get<I>(containers).set_clock(&current_frame), 0)...};
+    (void)expand;
+  }
+
+  template <typename... Types>
+  static ComponentSignature signature_of() {
+    ComponentSignature signature;
+    int expand[] = {0, (signature.set(component_id<Types>()), 0)...};
+    (void)expand;
+    return signature;
+  }
+
+public:
+  ComponentRegistry() { set_signature_tables(Indices{}); }
+
+  // Containers are referred to by address, e.g. by views
+  ComponentRegistry(const ComponentRegistry&)            = delete;
+  ComponentRegistry& operator=(const ComponentRegistry&) = delete;
+
+  // The id of 'Component', known at compile time
+  template <typename Component>
+  static constexpr unsigned int component_id() {
+    return TypeIndex<Component, Components...>::value;
+  }
+
+  static constexpr unsigned int component_count() {
+    return sizeof...(Components);
+  }
+
+  // Returns the container of the given component type
+  template <typename Component>
+  ComponentContainer<Component>& get() {
+    return std::get<component_id<Component>()>(containers);
+  }
+
+  // Calls observer with every entity that receives a 'Component'
+  template <typename Component>
+  void on_insert(std::function<void(Entity)> observer) {
+    get<Component>().on_insert(std::move(observer));
+  }
+
+  // Calls observer with every entity about to lose its 'Component'
+  template <typename Component>
+  void on_remove(std::function<void(Entity)> observer) {
+    get<Component>().on_remove(std::move(observer));
+  }
+
+  // The frame changes are currently stamped with, see
+  // ComponentContainer::changed_since
+  unsigned int frame() const { return current_frame; }
+
+  // Starts the next frame, called once per iteration of the game loop
+  void advance_frame() { current_frame++; }
+
+  // The components e has, one bit per component id
+  ComponentSignature signature(Entity e) const { return signatures.get(e); }
+
+  // Occupancy and memory of every container and of the registry as a whole
+  RegistryStats stats() {
+    RegistryStats stats;
+    for_each_container([&stats](const auto& container) {
+      stats.containers.push_back(container.stats());
+      const ContainerStats& added = stats.containers.back();
+      stats.count += added.count;
+      stats.component_bytes += added.component_bytes;
+      stats.index_bytes += added.index_bytes;
+    });
+    stats.signature_bytes    = signatures.memory();
+    stats.live_entities      = Entity::live_count();
+    stats.allocated_entities = Entity::allocated_count();
+    return stats;
+  }
+
+  // Calls f(container) for every container, f is called with the concrete
+  // container type
+  template <class F>
+  void for_each_container(F f) {
+    for_each_container(f, Indices{});
+  }
+
+  // Calls f(container) for every container e has a component in
+  template <class F>
+  void for_each_container_of(Entity e, F f) {
+    for_each_container_in(signatures.get(e), f, Indices{});
+  }
+
+  // Calls f(container) for every container whose bit is set in signature
+  template <class F>
+  void for_each_container_in(ComponentSignature signature, F f) {
+    for_each_container_in(signature, f, Indices{});
+  }
+
+  // All entities with every component in 'Included' and none in
+  // 'Excluded', e.g. registry.view<Motion, Mass>(exclude<Player>)
+  template <typename... Included, typename... Excluded>
+  ComponentView<Included...> view(ExcludeList<Excluded...> = {}) {
+    return ComponentView<Included...>(get<Included>()..., &signatures,
+                                      signature_of<Included...>(),
+                                      signature_of<Excluded...>());
+  }
+
+  void clear_all_components() {
+    for_each_container([](auto& container) { container.clear(); });
+  }
+
+  // Removes e from every container it has a component in
+  void remove_components_of(Entity e) {
+    for_each_container_of(e, [e](auto& container) { container.remove(e); });
+  }
+
+  // Removes all entities in batch from every container any of them has a
+  // component in, sweeping each of these containers once
+  void remove_components_of(const std::vector<Entity>& batch) {
+    ComponentSignature touched;
+    for (Entity e : batch) touched |= signatures.get(e);
+    for_each_container_in(touched, [&batch](auto& container) {
+      container.remove_batch(batch);
+    });
+  }
+
+  // Shrinks every container with room for more than watermark components it
+  // does not use down to room for watermark more, e.g. once the entities of a
+  // busy room are gone. The next room's spawns fit in what is left.
+  void shrink_to_fit(size_t watermark) {
+    for_each_container([watermark](auto& container) {
+      if (container.capacity() - container.size() > watermark) {
+        container.shrink_to_fit(watermark);
+      }
+    });
   }
 };
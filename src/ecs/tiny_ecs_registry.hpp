@@ -15,235 +15,294 @@
 #include "status.hpp"
 #include "tiny_ecs.hpp"
 
-class ECSRegistry {
-  // Callbacks to remove a particular or all entities in the system
-  std::vector<ContainerInterface*> registry_list;
+// All component types of the game. A type's position in this list is its
+// component id, listing it here is all it takes to give it a container.
+using ECSComponents = ComponentRegistry<
+    // physics related
+    Motion, Position, Collision, Mass, Parent, LocalTransform,
+    // player related
+    DeathTimer, Player, PlayerCollisionMesh, PlayerWeapon, PlayerProjectile,
+    Explosion, Inventory, Key, PlayerHUD, InventoryCounter, Communication,
+    Notification,
+    // enemy related
+    Deadly, EnemyProjectile, EnemySupport, Boss, ModifyOxygenCD, Lobster,
+    // oxygen related
+    Oxygen, OxygenModifier,
+    // ai related
+    Wander, WanderLine, WanderSquare, TracksPlayer, TracksPlayerRanged, Group,
+    EntityGroup, Shooter,
+    // abilities related
+    Stun, KnockBack, AreaOfEffect, ActsAsProjectile,
+    // render related
+    Mesh*, RenderRequest, vec3, ScreenState, TextRequest, SaveStatus,
+    // level related
+    SpaceBoundingBox, Vector, Space, DoorConnection, ActiveWall, ActiveDoor,
+    Interactable, Floor, Geyser, Bubble, Breakable, PressurePlate, PressedPlate,
+    Ambient,
+    // status related
+    LowOxygen, Stunned, KnockedBack, Attacked,
+    // audio related
+    Sound, Music,
+    // other
+    Consumable, Item, Drop, WeaponDrop, DebugComponent, Emoting, GameCursor,
+    Overlay, RoomTransition>;
 
-  public:
-  // Manually created list of all components this game has
+class ECSRegistry : public ECSComponents {
+public:
+  // Named access to the containers, bound once at construction
   // physics related
-  ComponentContainer<Motion>    motions;
-  ComponentContainer<Position>  positions;
-  ComponentContainer<Collision> collisions;
-  ComponentContainer<Mass>      masses;
+  ComponentContainer<Motion>&         motions         = get<Motion>();
+  ComponentContainer<Position>&       positions       = get<Position>();
+  ComponentContainer<Collision>&      collisions      = get<Collision>();
+  ComponentContainer<Mass>&           masses          = get<Mass>();
+  ComponentContainer<Parent>&         parents         = get<Parent>();
+  ComponentContainer<LocalTransform>& localTransforms = get<LocalTransform>();
 
   // player related
-  ComponentContainer<DeathTimer>          deathTimers;
-  ComponentContainer<Player>              players;
-  ComponentContainer<PlayerCollisionMesh> playersCollisionMeshes;
-  ComponentContainer<PlayerWeapon>        playerWeapons;
-  ComponentContainer<PlayerProjectile>    playerProjectiles;
-  ComponentContainer<Explosion>           explosions;
-  ComponentContainer<Inventory>           inventory;
-  ComponentContainer<Key>                 keys;
-  ComponentContainer<PlayerHUD>           playerHUD;
-  ComponentContainer<InventoryCounter>    inventoryCounters;
-  ComponentContainer<Communication>       communications;
-  ComponentContainer<Notification>        notifications;
+  ComponentContainer<DeathTimer>&          deathTimers   = get<DeathTimer>();
+  ComponentContainer<Player>&              players       = get<Player>();
+  ComponentContainer<PlayerCollisionMesh>& playersCollisionMeshes =
+      get<PlayerCollisionMesh>();
+  ComponentContainer<PlayerWeapon>&        playerWeapons = get<PlayerWeapon>();
+  ComponentContainer<PlayerProjectile>&    playerProjectiles =
+      get<PlayerProjectile>();
+  ComponentContainer<Explosion>&           explosions    = get<Explosion>();
+  ComponentContainer<Inventory>&           inventory     = get<Inventory>();
+  ComponentContainer<Key>&                 keys          = get<Key>();
+  ComponentContainer<PlayerHUD>&           playerHUD     = get<PlayerHUD>();
+  ComponentContainer<InventoryCounter>&    inventoryCounters =
+      get<InventoryCounter>();
+  ComponentContainer<Communication>&       communications =
+      get<Communication>();
+  ComponentContainer<Notification>&        notifications = get<Notification>();
 
   // enemy related
-  ComponentContainer<Deadly>          deadlys;
-  ComponentContainer<EnemyProjectile> enemyProjectiles;
-  ComponentContainer<EnemySupport>    enemySupports;
-  ComponentContainer<Boss>            bosses;
-  ComponentContainer<ModifyOxygenCD>  modifyOxygenCd;
-  ComponentContainer<Lobster>         lobsters;
+  ComponentContainer<Deadly>&          deadlys        = get<Deadly>();
+  ComponentContainer<EnemyProjectile>& enemyProjectiles =
+      get<EnemyProjectile>();
+  ComponentContainer<EnemySupport>&    enemySupports  = get<EnemySupport>();
+  ComponentContainer<Boss>&            bosses         = get<Boss>();
+  ComponentContainer<ModifyOxygenCD>&  modifyOxygenCd = get<ModifyOxygenCD>();
+  ComponentContainer<Lobster>&         lobsters       = get<Lobster>();
 
   // oxygen related
-  ComponentContainer<Oxygen>         oxygen;
-  ComponentContainer<OxygenModifier> oxygenModifiers;
+  ComponentContainer<Oxygen>&         oxygen          = get<Oxygen>();
+  ComponentContainer<OxygenModifier>& oxygenModifiers = get<OxygenModifier>();
 
   // ai related
-  ComponentContainer<Wander>             wanders;
-  ComponentContainer<WanderLine>         wanderLines;
-  ComponentContainer<WanderSquare>       wanderSquares;
-  ComponentContainer<TracksPlayer>       trackPlayer;
-  ComponentContainer<TracksPlayerRanged> trackPlayerRanged;
-  ComponentContainer<Group>              groups;
-  ComponentContainer<EntityGroup>        entityGroups;
-  ComponentContainer<Shooter>            shooters;
+  ComponentContainer<Wander>&             wanders       = get<Wander>();
+  ComponentContainer<WanderLine>&         wanderLines   = get<WanderLine>();
+  ComponentContainer<WanderSquare>&       wanderSquares = get<WanderSquare>();
+  ComponentContainer<TracksPlayer>&       trackPlayer   = get<TracksPlayer>();
+  ComponentContainer<TracksPlayerRanged>& trackPlayerRanged =
+      get<TracksPlayerRanged>();
+  ComponentContainer<Group>&              groups        = get<Group>();
+  ComponentContainer<EntityGroup>&        entityGroups  = get<EntityGroup>();
+  ComponentContainer<Shooter>&            shooters      = get<Shooter>();
 
   // abilities related
-  ComponentContainer<Stun>             stuns;
-  ComponentContainer<KnockBack>        knockbacks;
-  ComponentContainer<AreaOfEffect>     aoe;
-  ComponentContainer<ActsAsProjectile> actsAsProjectile;
+  ComponentContainer<Stun>&             stuns      = get<Stun>();
+  ComponentContainer<KnockBack>&        knockbacks = get<KnockBack>();
+  ComponentContainer<AreaOfEffect>&     aoe        = get<AreaOfEffect>();
+  ComponentContainer<ActsAsProjectile>& actsAsProjectile =
+      get<ActsAsProjectile>();
 
   // render related
-  ComponentContainer<Mesh*>         meshPtrs;
-  ComponentContainer<RenderRequest> renderRequests;
-  ComponentContainer<vec3>          colors;
-  ComponentContainer<ScreenState>   screenStates;
-  ComponentContainer<TextRequest>   textRequests;
-  ComponentContainer<SaveStatus>    saveStatuses;
+  ComponentContainer<Mesh*>&         meshPtrs       = get<Mesh*>();
+  ComponentContainer<RenderRequest>& renderRequests = get<RenderRequest>();
+  ComponentContainer<vec3>&          colors         = get<vec3>();
+  ComponentContainer<ScreenState>&   screenStates   = get<ScreenState>();
+  ComponentContainer<TextRequest>&   textRequests   = get<TextRequest>();
+  ComponentContainer<SaveStatus>&    saveStatuses   = get<SaveStatus>();
 
   // level related
-  ComponentContainer<SpaceBoundingBox> bounding_boxes;
-  ComponentContainer<Vector>           vectors;
-  ComponentContainer<Space>            spaces;
-  ComponentContainer<DoorConnection>   doorConnections;
-  ComponentContainer<ActiveWall>       activeWalls;
-  ComponentContainer<ActiveDoor>       activeDoors;
-  ComponentContainer<Interactable>     interactable;
-  ComponentContainer<Floor>            floors;
-  ComponentContainer<Geyser>           geysers;
-  ComponentContainer<Bubble>           bubbles;
-  ComponentContainer<Breakable>        breakables;
-  ComponentContainer<PressurePlate>    pressurePlates;
-  ComponentContainer<Ambient>    ambient;
+  ComponentContainer<SpaceBoundingBox>& bounding_boxes =
+      get<SpaceBoundingBox>();
+  ComponentContainer<Vector>&           vectors         = get<Vector>();
+  ComponentContainer<Space>&            spaces          = get<Space>();
+  ComponentContainer<DoorConnection>&   doorConnections = get<DoorConnection>();
+  ComponentContainer<ActiveWall>&       activeWalls     = get<ActiveWall>();
+  ComponentContainer<ActiveDoor>&       activeDoors     = get<ActiveDoor>();
+  ComponentContainer<Interactable>&     interactable    = get<Interactable>();
+  ComponentContainer<Floor>&            floors          = get<Floor>();
+  ComponentContainer<Geyser>&           geysers         = get<Geyser>();
+  ComponentContainer<Bubble>&           bubbles         = get<Bubble>();
+  ComponentContainer<Breakable>&        breakables      = get<Breakable>();
+  ComponentContainer<PressurePlate>&    pressurePlates  = get<PressurePlate>();
+  ComponentContainer<PressedPlate>&     pressedPlates   = get<PressedPlate>();
+  ComponentContainer<Ambient>&          ambient         = get<Ambient>();
 
   // status related
-  ComponentContainer<LowOxygen>   lowOxygen;
-  ComponentContainer<Stunned>     stunned;
-  ComponentContainer<KnockedBack> knockedback;
-  ComponentContainer<Attacked>    attacked;
+  ComponentContainer<LowOxygen>&   lowOxygen   = get<LowOxygen>();
+  ComponentContainer<Stunned>&     stunned     = get<Stunned>();
+  ComponentContainer<KnockedBack>& knockedback = get<KnockedBack>();
+  ComponentContainer<Attacked>&    attacked    = get<Attacked>();
 
   // audio related
-  ComponentContainer<Sound> sounds;
-  ComponentContainer<Music> musics;
+  ComponentContainer<Sound>& sounds = get<Sound>();
+  ComponentContainer<Music>& musics = get<Music>();
 
   // other
-  ComponentContainer<Consumable>     consumables;
-  ComponentContainer<Item>           items;
-  ComponentContainer<Drop>           drops;
-  ComponentContainer<WeaponDrop>     weaponDrops;
-  ComponentContainer<DebugComponent> debugComponents;
-  ComponentContainer<Emoting>        emoting;
-  ComponentContainer<GameCursor>     cursors;
-  ComponentContainer<Overlay>        overlays;
-  ComponentContainer<RoomTransition> roomTransitions;
-
-  // constructor that adds all containers for looping over them
-  // IMPORTANT: Don't forget to add any newly added containers!
-  ECSRegistry() {
-    // physics related
-    registry_list.push_back(&motions);
-    registry_list.push_back(&collisions);
-    registry_list.push_back(&positions);
-    registry_list.push_back(&masses);
-    // player related
-    registry_list.push_back(&deathTimers);
-    registry_list.push_back(&players);
-    registry_list.push_back(&playersCollisionMeshes);
-    registry_list.push_back(&playerWeapons);
-    registry_list.push_back(&playerProjectiles);
-    registry_list.push_back(&explosions);
-    registry_list.push_back(&inventory);
-    registry_list.push_back(&keys);
-    registry_list.push_back(&playerHUD);
-    registry_list.push_back(&inventoryCounters);
-    registry_list.push_back(&communications);
-    registry_list.push_back(&notifications);
-    // enemy related
-    registry_list.push_back(&deadlys);
-    registry_list.push_back(&enemyProjectiles);
-    registry_list.push_back(&enemySupports);
-    registry_list.push_back(&bosses);
-    registry_list.push_back(&modifyOxygenCd);
-    registry_list.push_back(&groups);
-    registry_list.push_back(&entityGroups);
-    // oxygen related
-    registry_list.push_back(&oxygen);
-    registry_list.push_back(&oxygenModifiers);
-    // ai related
-    registry_list.push_back(&wanders);
-    registry_list.push_back(&wanderLines);
-    registry_list.push_back(&wanderSquares);
-    registry_list.push_back(&trackPlayer);
-    registry_list.push_back(&trackPlayerRanged);
-    registry_list.push_back(&shooters);
-    // abilities related
-    registry_list.push_back(&stuns);
-    registry_list.push_back(&knockbacks);
-    registry_list.push_back(&aoe);
-    // render related
-    registry_list.push_back(&meshPtrs);
-    registry_list.push_back(&renderRequests);
-    registry_list.push_back(&screenStates);
-    registry_list.push_back(&colors);
-    registry_list.push_back(&textRequests);
-    registry_list.push_back(&saveStatuses);
-    // level related
-    registry_list.push_back(&bounding_boxes);
-    registry_list.push_back(&vectors);
-    registry_list.push_back(&spaces);
-    registry_list.push_back(&doorConnections);
-    registry_list.push_back(&activeWalls);
-    registry_list.push_back(&activeDoors);
-    registry_list.push_back(&interactable);
-    registry_list.push_back(&geysers);
-    registry_list.push_back(&bubbles);
-    registry_list.push_back(&floors);
-    registry_list.push_back(&breakables);
-    registry_list.push_back(&pressurePlates);
-    registry_list.push_back(&ambient);
-    // status related
-    registry_list.push_back(&lowOxygen);
-    registry_list.push_back(&stunned);
-    registry_list.push_back(&knockedback);
-    registry_list.push_back(&attacked);
-    // audio related
-    registry_list.push_back(&sounds);
-    registry_list.push_back(&musics);
-    // other
-    registry_list.push_back(&drops);
-    registry_list.push_back(&weaponDrops);
-    registry_list.push_back(&cursors);
-    registry_list.push_back(&debugComponents);
-    registry_list.push_back(&consumables);
-    registry_list.push_back(&items);
-    registry_list.push_back(&emoting);
-    registry_list.push_back(&overlays);
-    registry_list.push_back(&roomTransitions);
-  }
+  ComponentContainer<Consumable>&     consumables     = get<Consumable>();
+  ComponentContainer<Item>&           items           = get<Item>();
+  ComponentContainer<Drop>&           drops           = get<Drop>();
+  ComponentContainer<WeaponDrop>&     weaponDrops     = get<WeaponDrop>();
+  ComponentContainer<DebugComponent>& debugComponents = get<DebugComponent>();
+  ComponentContainer<Emoting>&        emoting         = get<Emoting>();
+  ComponentContainer<GameCursor>&     cursors         = get<GameCursor>();
+  ComponentContainer<Overlay>&        overlays        = get<Overlay>();
+  ComponentContainer<RoomTransition>& roomTransitions = get<RoomTransition>();
 
-  void clear_all_components() {
-    for (ContainerInterface* reg : registry_list) reg->clear();
+  ECSRegistry() {
+    parents.on_insert(
+        [this](Entity child) { count_child(parents.get(child).parent, 1); });
+    parents.on_remove(
+        [this](Entity child) { count_child(parents.get(child).parent, -1); });
   }
 
   void list_all_components() {
+    RegistryStats all = stats();
     printf("Debug info on all registry entries:\n");
-    for (ContainerInterface* reg : registry_list)
-      if (reg->size() > 0)
-        printf("%4d components of type %s\n", (int)reg->size(),
-               typeid(*reg).name());
+    for (const ContainerStats& container : all.containers)
+      if (container.count > 0)
+        printf("%4d components of type %s (%d bytes, %d for the index)\n",
+               (int)container.count, container.name.c_str(),
+               (int)container.component_bytes, (int)container.index_bytes);
+    printf("%d live entities, %d ids allocated\n", (int)all.live_entities,
+           (int)all.allocated_entities);
   }
 
   void list_all_components_of(Entity e) {
     printf("Debug info on components of entity %u:\n", (unsigned int)e);
-    for (ContainerInterface* reg : registry_list)
-      if (reg->has(e)) printf("type %s\n", typeid(*reg).name());
+    if (!e.is_alive()) return;
+    for_each_container_of(e, [](auto& container) {
+      printf("type %s\n", container.stats().name.c_str());
+    });
   }
 
+  // Destroys e along with its children (see Parent), removing it from each of
+  // its containers in turn like remove() does, which moves the last component
+  // into its place. Use destroy_batch for many entities or to keep the order
+  // of sorted containers.
   void remove_all_components_of(Entity e) {
-    // player, collision, emoting oxygen
-    if (oxygen.has(e)) {
-      Oxygen& o = oxygen.get(e);
-      remove_all_components_of(o.oxygenBar);
-      remove_all_components_of(o.backgroundBar);
+    if (!e.is_alive()) return;
+    if (child_count(e) == 0) {
+      destroy(e);
+      return;
+    }
+    std::vector<Entity> family = {e};
+    add_descendants(family);
+    for (Entity member : family) {
+      if (member.is_alive()) destroy(member);
     }
+  }
+
+  // Destroys all entities at once, along with their children (see Parent).
+  // Every container they have components in is compacted in a single sweep
+  // that keeps the order of the remaining components, even for a batch of one.
+  // Unless shrink_watermark is 0, containers left with more unused room than
+  // that are shrunk to keep just that much.
+  void destroy_batch(std::vector<Entity> entities,
+                     size_t              shrink_watermark = 0) {
+    // a stale handle's index may belong to a newer entity by now
+    entities.erase(std::remove_if(entities.begin(), entities.end(),
+                                  [](Entity e) { return !e.is_alive(); }),
+                   entities.end());
+
+    // children are removed along with their parents, e.g. health bars and
+    // emotes with their enemy
+    add_descendants(entities);
+
+    for (Entity e : entities) leave_group(e);
+
+    remove_components_of(entities);
+    for (Entity e : entities) {
+      // the batch may name an entity twice
+      if (e.is_alive()) Entity::release(e);
+    }
+
+    if (shrink_watermark > 0) shrink_to_fit(shrink_watermark);
+  }
 
-    if (entityGroups.has(e)) {
-      // remove from group if they are in one
-      EntityGroup& eg = entityGroups.get(e);
-      if (groups.has(eg.group)) {
-        Group& g = groups.get(eg.group);
-        g.members.erase(std::remove(g.members.begin(), g.members.end(), e),
-                        g.members.end());
+  // Number of entities whose Parent is e
+  unsigned int child_count(Entity e) const {
+    return e.index() < child_counts.size() ? child_counts[e.index()] : 0;
+  }
+
+  // Appends everything below the given entities in the hierarchy, see Parent.
+  // Entities without children cost a lookup each, Parent is only swept when
+  // some of them have children.
+  void add_descendants(std::vector<Entity>& entities) {
+    std::vector<Entity> ancestors;
+    size_t              missing = 0;
+    for (Entity e : entities) {
+      if (child_count(e) > 0) {
+        ancestors.push_back(e);
+        missing += child_count(e);
       }
     }
+    if (missing == 0) return;
+    std::sort(ancestors.begin(), ancestors.end());
+    ancestors.erase(std::unique(ancestors.begin(), ancestors.end()),
+                    ancestors.end());
 
-    if (players.has(e)) {
-      Player& p = players.get(e);
-      remove_all_components_of(p.weapon);
+    // parents are usually sorted by depth, making a single sweep enough
+    bool found = true;
+    while (missing > 0 && found) {
+      found = false;
+      for (size_t i = 0; i < parents.size() && missing > 0; i++) {
+        Entity child = parents.entities[i];
+        if (!std::binary_search(ancestors.begin(), ancestors.end(),
+                                parents.components[i].parent) ||
+            std::binary_search(ancestors.begin(), ancestors.end(), child)) {
+          continue;
+        }
+        entities.push_back(child);
+        missing--;
+        found = true;
+        if (child_count(child) > 0) {
+          missing += child_count(child);
+          ancestors.insert(
+              std::upper_bound(ancestors.begin(), ancestors.end(), child),
+              child);
+        }
+      }
     }
+  }
+
+  // Releases e if it no longer has any component, e.g. the throwaway entities
+  // sounds and music are played on
+  void release_if_empty(Entity e) {
+    if (signature(e).none()) Entity::release(e);
+  }
 
-    if (emoting.has(e)) {
-      Emoting& ee = emoting.get(e);
-      remove_all_components_of(ee.child);
+private:
+  // Removes e from the members of its Group, if it is in one
+  void leave_group(Entity e) {
+    if (!entityGroups.has(e)) return;
+    const EntityGroup& eg = entityGroups.get(e);
+    if (groups.has(eg.group)) {
+      Group& g = groups.get_mut(eg.group);
+      g.members.erase(std::remove(g.members.begin(), g.members.end(), e),
+                      g.members.end());
     }
+  }
+
+  void destroy(Entity e) {
+    leave_group(e);
+    remove_components_of(e);
+    Entity::release(e);
+  }
 
-    for (ContainerInterface* reg : registry_list) reg->remove(e);
+  // Number of children of the entity with index i, kept up to date by
+  // observing Parent so that childless entities skip add_descendants
+  std::vector<unsigned int> child_counts;
+
+  void count_child(Entity parent, int change) {
+    if (parent.index() >= child_counts.size()) {
+      child_counts.resize(parent.index() + 1, 0);
+    }
+    child_counts[parent.index()] += change;
   }
 };
 
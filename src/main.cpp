@@ -1,60 +1,102 @@
 #include <cstdio>
+#include <cstring>
 
 #include "ai_system.hpp"
-#define GL3W_IMPLEMENTATION
-#include <gl3w.h>
 
 // stlib
+#include <algorithm>
 #include <chrono>
 
 // internal
 #include "audio_system.hpp"
 #include "collision_system.hpp"
+#include "command_line.hpp"
+#include "ecs_command_buffer.hpp"
+#include "interpolation.hpp"
 #include "level_system.hpp"
 #include "physics_system.hpp"
+#include "profiler.hpp"
 #include "random.hpp"
 #include "render_system.hpp"
+#include "render_thread.hpp"
 #include "saving_system.hpp"
+#include "simulation.hpp"
 #include "world_state.hpp"
 #include "world_system.hpp"
 // #include "game_start_system.hpp"
 
 using Clock = std::chrono::high_resolution_clock;
 
-bool   krab_boss_encountered = false;
-bool   sharkman_encountered  = false;
-bool   is_intro              = false;
-bool   is_start              = false;
-bool   is_paused             = false;
-bool   is_krab_cutscene      = false;
-bool   is_sharkman_cutscene  = false;
-bool   is_cthulhu_cutscene   = false;
-bool   is_death              = false;
-bool   is_end                = false;
-Entity overlay;
-bool   room_transitioning = false;
-Entity rt_entity;
-
-Entity player;
-
-// Consumable Entities
-Entity      player_weapon;
-Entity      player_projectile;
-Entity      harpoon;
-Entity      net;
-Entity      concussive;
-Entity      torpedo;
-Entity      shrimp;
-PROJECTILES wep_type;
-
-Entity harpoon_gun;
-Entity net_gun;
-Entity concussive_gun;
-Entity torpedo_gun;
-Entity shrimp_gun;
+// Reports where the time went and writes the trace, if one was asked for
+static void finish_profiling(const std::string& trace_path) {
+#ifdef BERMUDA_PROFILING
+  profiler().print_stats();
+  if (!trace_path.empty() && profiler().write_trace(trace_path)) {
+    printf("Wrote trace to %s\n", trace_path.c_str());
+  }
+#endif
+}
 
 // Entry point
+//
+//   bermuda [--record session.rec | --replay session.rec] [--trace out.json]
+//           [--no-render-thread] [seed]
+//   bermuda --headless [--ticks N] [--input script.txt] [--trace out.json]
+//           [--record session.rec | --replay session.rec] [seed]
 int main(int argc, char* argv[]) {
+  // world seed
+  unsigned int seed = 0;
+
+  bool            headless = false;
+  HeadlessOptions headless_options;
+  std::string     trace_path;
+  bool            use_render_thread = true;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--headless") == 0) {
+      headless = true;
+    } else if (strcmp(argv[i], "--ticks") == 0 && i + 1 < argc) {
+      if (!parse_uint(argv[++i], headless_options.ticks)) {
+        fprintf(stderr, "--ticks expects a number of ticks\n");
+        return EXIT_FAILURE;
+      }
+    } else if (strcmp(argv[i], "--input") == 0 && i + 1 < argc) {
+      headless_options.input_path = argv[++i];
+    } else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+      headless_options.record_path = argv[++i];
+    } else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+      headless_options.replay_path = argv[++i];
+    } else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+      trace_path = argv[++i];
+    } else if (strcmp(argv[i], "--no-render-thread") == 0) {
+      use_render_thread = false;
+    } else {
+      // optionally parse a seed input, an invalid one is ignored
+      parse_uint(argv[i], seed);
+    }
+  }
+
+  if (!trace_path.empty()) {
+#ifdef BERMUDA_PROFILING
+    profiler().start_trace();
+#else
+    fprintf(stderr, "--trace needs a build with BERMUDA_PROFILING\n");
+#endif
+  }
+
+  if (headless) {
+    headless_options.seed = seed;
+    int result            = run_headless(headless_options);
+    finish_profiling(trace_path);
+    return result;
+  }
+
+  // a replay skips the menu and plays the recorded frames
+  Recording  replay;
+  const bool replaying = !headless_options.replay_path.empty();
+  if (replaying && !load_recording(headless_options.replay_path, replay)) {
+    return EXIT_FAILURE;
+  }
+
   // Global systems
   WorldSystem     world;
   RenderSystem    renderer;
@@ -64,9 +106,6 @@ int main(int argc, char* argv[]) {
   CollisionSystem collisions;
   LevelSystem     level;
 
-  // world seed
-  unsigned int seed = 0;
-
   // Initializing window
   GLFWwindow* window = world.create_window();
   if (!window) {
@@ -76,18 +115,6 @@ int main(int argc, char* argv[]) {
     return EXIT_FAILURE;
   }
 
-  // optionally parse a seed input
-  if (argc == 2) {
-    // Convert argument to unsigned int
-    char*         end;
-    unsigned long value = std::strtoul(argv[1], &end, 10);
-
-    // Validate the input
-    if (!(*end != '\0' || value > std::numeric_limits<unsigned int>::max())) {
-      seed = static_cast<unsigned int>(value);
-    }
-  }
-
   // Initialize the bare minimum to get the menu screen working
   renderer.init(window);
   audios.init();
@@ -97,6 +124,14 @@ int main(int argc, char* argv[]) {
   registry.remove_all_components_of(overlay);
   overlay = createOverlay(&renderer);
   overlayState(TEXTURE_ASSET_ID::START_OVERLAY);
+  if (replaying) {
+    world.game_started    = true;
+    world.load_from_save  = replay.load_from_save;
+    world.replaying_input = true;
+    is_start              = replay.is_start;
+    is_intro              = replay.is_intro;
+    seed                  = replay.seed;
+  }
   while (!world.is_over() && !world.game_started) {
     glfwPollEvents();
     renderer.draw();
@@ -109,7 +144,7 @@ int main(int argc, char* argv[]) {
   registry.remove_all_components_of(overlay);
 
   // we loaded from a save file, set the seed again
-  if (world.load_from_save) {
+  if (world.load_from_save && !replaying) {
     seed = get_seed_from_save_file();
   }
 
@@ -138,9 +173,39 @@ int main(int argc, char* argv[]) {
     load_game_from_file();
   }
 
-  // variable timestep loop
-  auto t = Clock::now();
+  // fixed timestep loop, the simulation runs in ticks of tick_ms and the
+  // renderer blends between the last two of them
+  const float tick_ms = replaying ? replay.tick_ms : 1000.f / SIM_TICK_RATE;
+
+  InputRecorder recorder;
+  if (!headless_options.record_path.empty() && !replaying) {
+    Recording start;
+    start.seed           = getGlobalRandomSeed();
+    start.tick_ms        = tick_ms;
+    start.load_from_save = world.load_from_save;
+    start.is_start       = is_start;
+    start.is_intro       = is_intro;
+    if (!recorder.open(headless_options.record_path, start)) {
+      return EXIT_FAILURE;
+    }
+    world.recorder = &recorder;
+  }
+  InputScript  replay_input;
+  for (const InputEvent& event : replay.events) replay_input.add(event);
+  size_t       replay_frame = 0;
+  unsigned int tick         = 0;
+
+  // frame N is drawn on the render thread while frame N+1 is simulated here
+  RenderThread   render_thread;
+  RenderSnapshot snapshot;
+  if (use_render_thread) {
+    render_thread.start(renderer);
+  }
+
+  float accumulator = 0.f;
+  auto  t           = Clock::now();
   while (!world.is_over()) {
+    PROFILE_SCOPE("frame");
     // Processes system messages, if this wasn't present the window would become
     // unresponsive
     glfwPollEvents();
@@ -151,22 +216,47 @@ int main(int argc, char* argv[]) {
             .count() /
         1000;
     t = now;
+    world.update_fps(elapsed_ms);
 
-    world.step(elapsed_ms);
-    bool is_frozen_state = is_intro || is_start || is_paused ||
-                           is_krab_cutscene || is_sharkman_cutscene ||
-                           is_cthulhu_cutscene || is_death || is_end ||
-                           room_transitioning;
-    if (!is_frozen_state) {
-      // Note: WorldSystem::step runs simply to update FPS counter, but is
-      // mostly disabled
-      ai.step(elapsed_ms);
-      physics.step(elapsed_ms);
-      collisions.step(elapsed_ms);
+    // time beyond the catch-up limit (e.g. while the window is dragged) is
+    // dropped instead of simulated all at once. A replay runs the recorded
+    // number of ticks instead, whatever the time.
+    unsigned int ticks;
+    if (replaying) {
+      if (replay_frame == replay.frame_ticks.size()) {
+        printf("Replay finished after %u ticks\n", tick);
+        break;
+      }
+      ticks = replay.frame_ticks[replay_frame++];
+    } else {
+      accumulator = std::min(accumulator + elapsed_ms,
+                             tick_ms * MAX_SIM_STEPS_PER_FRAME);
+      ticks       = (unsigned int)(accumulator / tick_ms);
+      accumulator -= ticks * tick_ms;
+    }
+    for (unsigned int i = 0; i < ticks; i++, tick++) {
+      for (const InputEvent& event : replay_input.take(tick)) {
+        world.handle_input(event);
+      }
+      capturePreviousPositions();
+      step_simulation(world, ai, physics, collisions, tick_ms);
+      // per tick rather than per frame, so that sound requests drain the
+      // same way however the ticks were spread over frames
+      audios.step(tick_ms);
+      recorder.end_tick();
+    }
+    recorder.end_frame(ticks, elapsed_ms);
+
+    float alpha = replaying ? 1.f : accumulator / tick_ms;
+    if (use_render_thread) {
+      renderer.capture(snapshot);
+      render_thread.submit(snapshot, alpha);
+    } else {
+      renderer.draw(alpha);
     }
-    audios.step(elapsed_ms);
-    renderer.draw();
   }
+  render_thread.stop();
 
+  finish_profiling(trace_path);
   return EXIT_SUCCESS;
 }
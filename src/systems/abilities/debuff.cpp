@@ -20,9 +20,9 @@ bool handle_stun(Entity stun_entity, Entity stunned_entity) {
   if (registry.stuns.has(stun_entity)) {
     if (!registry.stunned.has(stunned_entity)) {
       std::cout << "Stunned!" << std::endl;
-      Stun&    stun    = registry.stuns.get(stun_entity);
-      Stunned& stunned = registry.stunned.emplace(stunned_entity);
-      stunned.duration = stun.duration;
+      const Stun& stun    = registry.stuns.get(stun_entity);
+      Stunned&    stunned = registry.stunned.emplace(stunned_entity);
+      stunned.duration    = stun.duration;
       if (registry.deadlys.has(stunned_entity)) {
         stunned.original_velocity = registry.motions.has(stunned_entity) ? registry.motions.get(stunned_entity).velocity : vec2(0.f);
       }
@@ -36,7 +36,7 @@ bool handle_knockback(Entity knockback_entity, Entity knockedback_entity) {
   if (registry.knockbacks.has(knockback_entity)) {
     if (!registry.knockedback.has(knockedback_entity)) {
       std::cout << "KnockedBack!" << std::endl;
-      KnockBack&    knockback    = registry.knockbacks.get(knockback_entity);
+      const KnockBack& knockback = registry.knockbacks.get(knockback_entity);
       KnockedBack& knockedBack = registry.knockedback.emplace(knockedback_entity);
       knockedBack.duration = knockback.duration;
       knockedBack.knockback_proj = knockback_entity;
@@ -64,7 +64,7 @@ bool handle_knockback(Entity knockback_entity, Entity knockedback_entity) {
  */
 bool debuff_entity_can_move(Entity& entity) {
   if (registry.stunned.has(entity)) {
-    Stunned& stunned = registry.stunned.get(entity);
+    const Stunned& stunned = registry.stunned.get(entity);
     if (stunned.duration >= STUN_MOVEMENT_THRESHOLD_MS) {      
       return false;
     }
@@ -95,14 +95,14 @@ bool update_debuffs(float elapsed_ms_since_last_update) {
   ///////////////////////
   for (Entity entity : registry.stunned.entities) {
     // progress timer
-    Stunned& stunned = registry.stunned.get(entity);
+    Stunned& stunned = registry.stunned.get_mut(entity);
     stunned.duration -= elapsed_ms_since_last_update;
 
     // remove if no longer stunned
     if (stunned.duration < 0) {
       if (stunned.original_velocity != vec2(0.f)) {
         if (registry.motions.has(entity) && registry.deadlys.has(entity)) {
-          registry.motions.get(entity).velocity = stunned.original_velocity;
+          registry.motions.get_mut(entity).velocity = stunned.original_velocity;
         }
       }
       registry.stunned.remove(entity);
@@ -113,18 +113,18 @@ bool update_debuffs(float elapsed_ms_since_last_update) {
   ///////////////////////
   for (Entity entity : registry.knockedback.entities) {
     // progress timer
-    KnockedBack& knockedback = registry.knockedback.get(entity);
+    KnockedBack& knockedback = registry.knockedback.get_mut(entity);
     knockedback.duration -= elapsed_ms_since_last_update;
 
     // remove knocked back debuff
     if (knockedback.duration <= 0) {
       if (registry.motions.has(entity)) {
-        registry.motions.get(entity).velocity = knockedback.original_velocity;
+        registry.motions.get_mut(entity).velocity = knockedback.original_velocity;
       }
       registry.knockedback.remove(entity);
 
-      Inventory& inventory = registry.inventory.get(player);
-      PlayerProjectile& playerproj_component = registry.playerProjectiles.get(knockedback.knockback_proj);
+      const Inventory& inventory = registry.inventory.get(player);
+      PlayerProjectile& playerproj_component = registry.playerProjectiles.get_mut(knockedback.knockback_proj);
       bool check_wep_swap = player_projectile != knockedback.knockback_proj;
       playerproj_component.is_loaded = true;
 
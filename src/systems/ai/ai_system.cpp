@@ -14,6 +14,7 @@
 #include "enemy_util.hpp"
 #include "entity_type.hpp"
 #include "physics.hpp"
+#include "profiler.hpp"
 #include "random.hpp"
 #include "tiny_ecs.hpp"
 #include "tiny_ecs_registry.hpp"
@@ -85,7 +86,7 @@ void removeFromAI(Entity& e) {
  * @param pos
  * @return
  */
-bool can_see_entity(Position& pos, Position& entity_pos) {
+bool can_see_entity(const Position& pos, const Position& entity_pos) {
   vec2        direction   = entity_pos.position - pos.position;
   const float player_dist = dot(direction, direction);
   direction               = normalize(direction);
@@ -158,18 +159,18 @@ void choose_new_direction(Entity enemy, Entity other) {
   float distance = sqrt(dot(direction, direction));
   float speed    = sqrt(dot(registry.motions.get(enemy).velocity,
                             registry.motions.get(enemy).velocity));
-  Boss& boss     = registry.bosses.get(enemy);
+  Boss& boss     = registry.bosses.get_mut(enemy);
   // if enemy sees player during target mode, aim at player
   if (registry.trackPlayer.has(enemy) &&
       can_see_entity(registry.positions.get(enemy),
                      registry.positions.get(player)) &&
       distance <= registry.trackPlayer.get(enemy).spot_radius) {
     // turn red
-    boss.is_angry                                = true;
-    registry.trackPlayer.get(enemy).active_track = true;
+    boss.is_angry                                    = true;
+    registry.trackPlayer.get_mut(enemy).active_track = true;
   } else {
     if (registry.trackPlayer.has(enemy)) {
-      registry.trackPlayer.get(enemy).active_track = false;
+      registry.trackPlayer.get_mut(enemy).active_track = false;
     }
     // revert to normal color
     boss.is_angry      = false;
@@ -185,18 +186,18 @@ void choose_new_direction(Entity enemy, Entity other) {
   }
 
   if (direction.x < 0) {
-    registry.positions.get(enemy).scale.x =
+    registry.positions.get_mut(enemy).scale.x =
         abs(registry.positions.get(enemy).scale.x) * -1;
   } else {
-    registry.positions.get(enemy).scale.x =
+    registry.positions.get_mut(enemy).scale.x =
         abs(registry.positions.get(enemy).scale.x);
   }
 
-  direction                            = normalize(direction);
-  registry.motions.get(enemy).velocity = direction * speed;
+  direction                                = normalize(direction);
+  registry.motions.get_mut(enemy).velocity = direction * speed;
 }
 
-void handleUrchinFiring(RenderSystem* renderer, Position& pos) {
+void handleUrchinFiring(RenderSystem* renderer, const Position& pos) {
   launchUrchinNeedle(renderer, pos.position + vec2(abs(pos.scale.x), 0), 0);
   launchUrchinNeedle(renderer, pos.position + vec2(0, abs(pos.scale.y)),
                      M_PI / 2);
@@ -205,7 +206,7 @@ void handleUrchinFiring(RenderSystem* renderer, Position& pos) {
                      1.5f * M_PI);
 }
 
-void handleCthulhuRageProjs(RenderSystem* renderer, Position& pos,
+void handleCthulhuRageProjs(RenderSystem* renderer, const Position& pos,
                             float targetAngle) {
   // shoot one proj at player, 8 in selectively random directions
   shootRageProjectile(renderer, pos.position, targetAngle);
@@ -226,7 +227,7 @@ void handleCthulhuRageProjs(RenderSystem* renderer, Position& pos,
 
 void AISystem::do_boss_ai(float elapsed_ms) {
   for (Entity& b : registry.bosses.entities) {
-    Boss& boss = registry.bosses.get(b);
+    Boss& boss = registry.bosses.get_mut(b);
     boss.curr_cd -= elapsed_ms;
 
     if (boss.type == ENTITY_TYPE::SHARKMAN) {
@@ -234,7 +235,7 @@ void AISystem::do_boss_ai(float elapsed_ms) {
       if (sharkman_texture_num >= 8.f) {
         sharkman_texture_num = 0.f;
       }
-      auto& renderReq = registry.renderRequests.get(b);
+      auto& renderReq = registry.renderRequests.get_mut(b);
       // switch? nah
       if (sharkman_texture_num < 1) {
         renderReq.used_texture = TEXTURE_ASSET_ID::SHARKMAN0;
@@ -281,7 +282,7 @@ void AISystem::do_wander_ai(float elapsed_ms) {
       continue;
     }
 
-    Wander& wander = registry.wanders.get(e);
+    Wander& wander = registry.wanders.get_mut(e);
     wander.active_dir_cd -= elapsed_ms;
 
     if (wander.active_dir_cd > 0) {
@@ -299,17 +300,18 @@ void AISystem::do_wander_ai(float elapsed_ms) {
     }
 
     createEmote(this->renderer, e, EMOTE::NONE);
-    Motion& motion       = registry.motions.get(e);
-    float   speed        = sqrt(dot(motion.velocity, motion.velocity));
-    float   acceleration = sqrt(dot(motion.acceleration, motion.acceleration));
-    float   newAngle     = randomFloat(0.f, 2 * 3.14);
+    MotionRef motion       = registry.motions.get_mut(e);
+    float     speed        = sqrt(dot(motion.velocity, motion.velocity));
+    float     acceleration =
+        sqrt(dot(motion.acceleration, motion.acceleration));
+    float     newAngle     = randomFloat(0.f, 2 * 3.14);
     motion.velocity      = {cos(newAngle), sin(newAngle)};
     motion.acceleration  = {cos(newAngle), sin(newAngle)};
     motion.velocity *= speed;
     motion.acceleration *= acceleration;
 
     if (registry.positions.has(e)) {
-      Position& p = registry.positions.get(e);
+      PositionRef p = registry.positions.get_mut(e);
 
       p.scale.x = abs(p.scale.x);
       if (motion.velocity.x > 0) {
@@ -330,7 +332,7 @@ void AISystem::do_wander_ai_line(float elapsed_ms) {
     if (is_tracking(e) || is_proj(e)) {
       continue;
     }
-    WanderLine& wander = registry.wanderLines.get(e);
+    WanderLine& wander = registry.wanderLines.get_mut(e);
     wander.active_dir_cd -= elapsed_ms;
 
     if (wander.active_dir_cd > 0) {
@@ -343,12 +345,12 @@ void AISystem::do_wander_ai_line(float elapsed_ms) {
     }
 
     createEmote(this->renderer, e, EMOTE::NONE);
-    Motion& motion = registry.motions.get(e);
+    MotionRef motion = registry.motions.get_mut(e);
     motion.velocity *= -1;
     motion.acceleration *= -1;
 
     if (registry.positions.has(e)) {
-      Position& p = registry.positions.get(e);
+      PositionRef p = registry.positions.get_mut(e);
 
       p.scale.x = abs(p.scale.x);
       if (motion.velocity.x > 0) {
@@ -374,7 +376,7 @@ void AISystem::do_wander_ai_square(float elapsed_ms) {
     if (is_tracking(e) || is_proj(e)) {
       continue;
     }
-    WanderSquare& wander = registry.wanderSquares.get(e);
+    WanderSquare& wander = registry.wanderSquares.get_mut(e);
     wander.active_dir_cd -= elapsed_ms;
 
     if (wander.active_dir_cd > 0) {
@@ -387,7 +389,7 @@ void AISystem::do_wander_ai_square(float elapsed_ms) {
     }
 
     createEmote(this->renderer, e, EMOTE::NONE);
-    Motion& motion = registry.motions.get(e);
+    MotionRef motion = registry.motions.get_mut(e);
     if (wander.clockwise) {
       motion.velocity     = rotateClockwise * motion.velocity;
       motion.acceleration = rotateClockwise * motion.acceleration;
@@ -397,7 +399,7 @@ void AISystem::do_wander_ai_square(float elapsed_ms) {
     }
 
     if (registry.positions.has(e)) {
-      Position& p = registry.positions.get(e);
+      PositionRef p = registry.positions.get_mut(e);
 
       p.scale.x = abs(p.scale.x);
       if (motion.velocity.x > 0) {
@@ -414,8 +416,8 @@ void AISystem::do_wander_ai_square(float elapsed_ms) {
  * @param pos
  * @return
  */
-bool AISystem::in_range_of_player(Position& pos, Position& player_pos,
-                                  float range) {
+bool AISystem::in_range_of_player(const Position& pos,
+                                  const Position& player_pos, float range) {
   vec2 distance = player_pos.position - pos.position;
   // printf("%f, %f\n", sqrt(dot(distance, distance)), range);
   return sqrt(dot(distance, distance)) <= range;
@@ -437,10 +439,10 @@ void AISystem::do_track_player(float elapsed_ms) {
     return;
   }
 
-  Position& player_pos = registry.positions.get(player);
+  ConstPositionRef player_pos = registry.positions.get(player);
 
   for (Entity& e : registry.trackPlayer.entities) {
-    TracksPlayer& tracker = registry.trackPlayer.get(e);
+    TracksPlayer& tracker = registry.trackPlayer.get_mut(e);
     tracker.curr_cd -= elapsed_ms;
 
     if (registry.lobsters.has(e)) {
@@ -455,8 +457,8 @@ void AISystem::do_track_player(float elapsed_ms) {
     if (!registry.positions.has(e)) {
       continue;
     }
-    Position& entity_pos = registry.positions.get(e);
-    float     range =
+    ConstPositionRef entity_pos = registry.positions.get(e);
+    float       range =
         tracker.active_track ? tracker.leash_radius : tracker.spot_radius;
 
     if (!in_range_of_player(entity_pos, player_pos, range) ||
@@ -467,7 +469,7 @@ void AISystem::do_track_player(float elapsed_ms) {
       }
       tracker.active_track = false;
       if (registry.lobsters.has(e)) {
-        registry.motions.get(e).velocity =
+        registry.motions.get_mut(e).velocity =
             vec2(registry.lobsters.get(e).original_speed, 0);
       }
       continue;
@@ -485,15 +487,15 @@ void AISystem::do_track_player(float elapsed_ms) {
       continue;
     }
 
-    Motion& motion     = registry.motions.get(e);
-    float   velocity   = sqrt(dot(motion.velocity, motion.velocity));
-    vec2    player_dir = normalize(player_pos.position - entity_pos.position);
+    MotionRef motion     = registry.motions.get_mut(e);
+    float     velocity   = sqrt(dot(motion.velocity, motion.velocity));
+    vec2      player_dir = normalize(player_pos.position - entity_pos.position);
 
     motion.velocity     = player_dir * velocity;
     motion.acceleration = player_dir * tracker.acceleration;
 
     if (registry.positions.has(e)) {
-      Position& p = registry.positions.get(e);
+      PositionRef p = registry.positions.get_mut(e);
 
       p.scale.x = abs(p.scale.x);
       if (motion.velocity.x > 0) {
@@ -520,10 +522,10 @@ void AISystem::do_track_player_ranged(float elapsed_ms) {
     return;
   }
 
-  Position& player_pos = registry.positions.get(player);
+  ConstPositionRef player_pos = registry.positions.get(player);
 
   for (Entity& e : registry.trackPlayerRanged.entities) {
-    TracksPlayerRanged& tracker = registry.trackPlayerRanged.get(e);
+    TracksPlayerRanged& tracker = registry.trackPlayerRanged.get_mut(e);
     tracker.curr_cd -= elapsed_ms;
 
     if (tracker.curr_cd > 0) {
@@ -534,8 +536,8 @@ void AISystem::do_track_player_ranged(float elapsed_ms) {
     if (!registry.positions.has(e)) {
       continue;
     }
-    Position& entity_pos = registry.positions.get(e);
-    float     range =
+    ConstPositionRef entity_pos = registry.positions.get(e);
+    float       range =
         tracker.active_track ? tracker.leash_radius : tracker.spot_radius;
 
     if (!in_range_of_player(entity_pos, player_pos, range) ||
@@ -556,10 +558,10 @@ void AISystem::do_track_player_ranged(float elapsed_ms) {
     tracker.active_track = true;
 
     // set the entity velocity
-    Motion& motion       = registry.motions.get(e);
-    float   velocity     = sqrt(dot(motion.velocity, motion.velocity));
-    vec2    player_dir_o = player_pos.position - entity_pos.position;
-    vec2    player_dir   = normalize(player_dir_o);
+    MotionRef motion       = registry.motions.get_mut(e);
+    float     velocity     = sqrt(dot(motion.velocity, motion.velocity));
+    vec2      player_dir_o = player_pos.position - entity_pos.position;
+    vec2      player_dir   = normalize(player_dir_o);
 
     motion.velocity     = player_dir * velocity;
     motion.acceleration = player_dir * tracker.acceleration;
@@ -572,7 +574,7 @@ void AISystem::do_track_player_ranged(float elapsed_ms) {
     }
 
     if (registry.positions.has(e)) {
-      Position& p = registry.positions.get(e);
+      PositionRef p = registry.positions.get_mut(e);
 
       p.scale.x = abs(p.scale.x);
       if (motion.velocity.x > 0) {
@@ -592,8 +594,8 @@ void AISystem::do_track_player_ranged(float elapsed_ms) {
     registry.actsAsProjectile.emplace(fish);
 
     // make them go towards the player's current direction
-    Motion& fish_motion = registry.motions.get(fish);
-    float   fish_velocity =
+    MotionRef fish_motion   = registry.motions.get_mut(fish);
+    float     fish_velocity =
         sqrt(dot(fish_motion.velocity, fish_motion.velocity)) * 2;
     float fish_accel =
         sqrt(dot(fish_motion.acceleration, fish_motion.acceleration)) * 2;
@@ -604,7 +606,7 @@ void AISystem::do_track_player_ranged(float elapsed_ms) {
 
 void AISystem::do_projectile_firing(float elapsed_ms) {
   for (Entity enemy : registry.shooters.entities) {
-    Shooter& attrs = registry.shooters.get(enemy);
+    Shooter& attrs = registry.shooters.get_mut(enemy);
     attrs.cooldown -= elapsed_ms;
 
     if (attrs.type == RangedEnemies::URCHIN) {
@@ -614,8 +616,8 @@ void AISystem::do_projectile_firing(float elapsed_ms) {
         handleUrchinFiring(renderer, registry.positions.get(enemy));
       }
     } else if (attrs.type == RangedEnemies::SEAHORSE) {
-      Position& enemy_pos  = registry.positions.get(enemy);
-      Position& player_pos = registry.positions.get(player);
+      PositionRef      enemy_pos  = registry.positions.get_mut(enemy);
+      ConstPositionRef player_pos = registry.positions.get(player);
       if (can_see_entity(enemy_pos, player_pos)) {
         vec2 direction = player_pos.position - enemy_pos.position;
         if (direction.x > 0) {
@@ -632,14 +634,14 @@ void AISystem::do_projectile_firing(float elapsed_ms) {
         attrs.cooldown = attrs.default_cd;
       }
     } else if (attrs.type == RangedEnemies::SIREN && attrs.cooldown < 0.f) {
-      Position& enemy_pos = registry.positions.get(enemy);
+      ConstPositionRef enemy_pos = registry.positions.get(enemy);
       for (Entity enemy_ally : registry.deadlys.entities) {
         if (enemy_ally == enemy) continue;
         if (!registry.oxygen.has(enemy_ally)) continue;
-        Oxygen& enemy_ally_oxygen = registry.oxygen.get(enemy_ally);
+        const Oxygen& enemy_ally_oxygen = registry.oxygen.get(enemy_ally);
         if (enemy_ally_oxygen.level >= enemy_ally_oxygen.capacity) continue;
 
-        Position& enemy_ally_pos = registry.positions.get(enemy_ally);
+        ConstPositionRef enemy_ally_pos = registry.positions.get(enemy_ally);
         if (can_see_entity(enemy_pos, enemy_ally_pos)) {
           vec2 direction = enemy_ally_pos.position - enemy_pos.position;
           fireSirenHeal(renderer, enemy, enemy_pos.position, direction);
@@ -652,7 +654,7 @@ void AISystem::do_projectile_firing(float elapsed_ms) {
 
         if (registry.deadlys.entities.size() < CTHULHU_ENEMY_LIMIT) {
           // create tentacle in 1 of 8 locations around cthulhu
-          Position&         enemy_pos     = registry.positions.get(enemy);
+          ConstPositionRef  enemy_pos     = registry.positions.get(enemy);
           float             gap           = 30;
           float             cthulhu_w_gap = abs(enemy_pos.scale.x) / 2 + gap;
           float             cthulhu_h_gap = abs(enemy_pos.scale.y) / 2 + gap;
@@ -672,7 +674,7 @@ void AISystem::do_projectile_firing(float elapsed_ms) {
         } else {
           // limit reached, change behaviour
           if (registry.bosses.has(enemy)) {
-            Boss& boss   = registry.bosses.get(enemy);
+            Boss& boss   = registry.bosses.get_mut(enemy);
             boss.curr_cd = 0;
             printf("enough tenties\n");
           }
@@ -682,26 +684,26 @@ void AISystem::do_projectile_firing(float elapsed_ms) {
       if (attrs.cooldown < 0.f) {
         attrs.cooldown = attrs.default_cd;
 
-        Position& enemy_pos  = registry.positions.get(enemy);
-        Position& player_pos = registry.positions.get(player);
-        vec2      direction  = player_pos.position - enemy_pos.position;
+        ConstPositionRef enemy_pos  = registry.positions.get(enemy);
+        ConstPositionRef player_pos = registry.positions.get(player);
+        vec2             direction  = player_pos.position - enemy_pos.position;
         shootFireball(renderer, enemy_pos.position, direction);
       }
     } else if (attrs.type == RangedEnemies::CTHULHU_CANISTER) {
       if (attrs.cooldown < 0.f) {
         attrs.cooldown = attrs.default_cd;
 
-        Position& enemy_pos  = registry.positions.get(enemy);
-        Position& player_pos = registry.positions.get(player);
-        vec2      direction  = player_pos.position - enemy_pos.position;
-        bool      is_rage    = registry.bosses.get(enemy).is_angry;
+        ConstPositionRef enemy_pos  = registry.positions.get(enemy);
+        ConstPositionRef player_pos = registry.positions.get(player);
+        vec2             direction  = player_pos.position - enemy_pos.position;
+        bool             is_rage    = registry.bosses.get(enemy).is_angry;
         shootCanister(renderer, enemy_pos.position, direction, is_rage);
         cthulhuCanisterDialogue(renderer);
       }
     } else if (attrs.type == RangedEnemies::CTHULHU_SHOCKWAVE) {
       if (attrs.cooldown < 0.f) {
-        attrs.cooldown      = attrs.default_cd;
-        Position& enemy_pos = registry.positions.get(enemy);
+        attrs.cooldown             = attrs.default_cd;
+        ConstPositionRef enemy_pos = registry.positions.get(enemy);
         shootShockwave(renderer, enemy_pos.position);
         cthulhuShockwaveDialogue(renderer);
       }
@@ -709,9 +711,9 @@ void AISystem::do_projectile_firing(float elapsed_ms) {
       if (attrs.cooldown < 0.f) {
         attrs.cooldown = attrs.default_cd;
 
-        Position& enemy_pos  = registry.positions.get(enemy);
-        Position& player_pos = registry.positions.get(player);
-        vec2      direction  = player_pos.position - enemy_pos.position;
+        ConstPositionRef enemy_pos  = registry.positions.get(enemy);
+        ConstPositionRef player_pos = registry.positions.get(player);
+        vec2             direction  = player_pos.position - enemy_pos.position;
         handleCthulhuRageProjs(renderer, enemy_pos,
                                atan2(direction.y, direction.x));
       }
@@ -727,9 +729,9 @@ void AISystem::do_projectile_firing(float elapsed_ms) {
  */
 void AISystem::do_lobster(float elapsed_ms, Entity lobster, Entity player) {
   // printf("DO LOBSTER\n");
-  Motion&   lob_motion = registry.motions.get(lobster);
-  Position& lob_pos    = registry.positions.get(lobster);
-  Lobster&  lob_comp   = registry.lobsters.get(lobster);
+  MotionRef        lob_motion = registry.motions.get_mut(lobster);
+  ConstPositionRef lob_pos    = registry.positions.get(lobster);
+  Lobster&         lob_comp   = registry.lobsters.get_mut(lobster);
 
   if (lob_comp.ram_timer <= 0 && lob_comp.block_timer <= 0) {
     // printf("LOBSTER START BLOCKING\n");
@@ -743,22 +745,23 @@ void AISystem::do_lobster(float elapsed_ms, Entity lobster, Entity player) {
     lob_motion.velocity     = vec2(0.f);
     lob_motion.acceleration = vec2(0.f);
     if (registry.renderRequests.has(lobster)) {
-      RenderRequest& lobster_render = registry.renderRequests.get(lobster);
+      RenderRequest& lobster_render = registry.renderRequests.get_mut(lobster);
       lobster_render.used_texture   = TEXTURE_ASSET_ID::LOBSTER_BLOCK;
     }
     return;
   }
 
-  Position& player_pos   = registry.positions.get(player);
-  float     lob_velocity = sqrt(dot(lob_motion.velocity, lob_motion.velocity));
-  vec2      player_dir   = normalize(player_pos.position - lob_pos.position);
+  ConstPositionRef player_pos   = registry.positions.get(player);
+  float            lob_velocity =
+      sqrt(dot(lob_motion.velocity, lob_motion.velocity));
+  vec2        player_dir   = normalize(player_pos.position - lob_pos.position);
 
   lob_motion.velocity     = player_dir * lob_comp.ram_speed;
   lob_motion.acceleration = player_dir * lob_motion.acceleration;
 }
 
 void AISystem::update_lobster(float elapsed_ms, Entity lob) {
-  Lobster& lobster = registry.lobsters.get(lob);
+  Lobster& lobster = registry.lobsters.get_mut(lob);
   if (lobster.block_timer > 0) {
     // printf("LOBSTER BLOCKING, time: %f\n", lobster.block_timer);
     lobster.block_timer -= elapsed_ms;
@@ -766,7 +769,7 @@ void AISystem::update_lobster(float elapsed_ms, Entity lob) {
       // printf("LOBSTER START RAMMING");
       lobster.ram_timer = lobster.ram_duration;
       if (registry.renderRequests.has(lob)) {
-        RenderRequest& lobster_render = registry.renderRequests.get(lob);
+        RenderRequest& lobster_render = registry.renderRequests.get_mut(lob);
         lobster_render.used_texture   = TEXTURE_ASSET_ID::LOBSTER_RAM;
       }
     }
@@ -776,14 +779,14 @@ void AISystem::update_lobster(float elapsed_ms, Entity lob) {
     if (lobster.ram_timer <= 0) {
       // printf("LOBSTER END RAMMING\n");
       if (registry.renderRequests.has(lob)) {
-        RenderRequest& lobster_render = registry.renderRequests.get(lob);
+        RenderRequest& lobster_render = registry.renderRequests.get_mut(lob);
         lobster_render.used_texture   = TEXTURE_ASSET_ID::LOBSTER;
       }
     }
   }
   if (registry.positions.has(lob) && registry.motions.has(lob)) {
-    Position& p          = registry.positions.get(lob);
-    Motion&   lob_motion = registry.motions.get(lob);
+    PositionRef    p          = registry.positions.get_mut(lob);
+    ConstMotionRef lob_motion = registry.motions.get(lob);
 
     p.scale.x = abs(p.scale.x);
     if (lob_motion.velocity.x > 0) {
@@ -794,6 +797,14 @@ void AISystem::update_lobster(float elapsed_ms, Entity lob) {
 }
 
 void AISystem::step(float elapsed_ms) {
+  PROFILE_SCOPE("ai.step");
+  step_behaviours(elapsed_ms);
+  steer_groups(elapsed_ms);
+  step_attacks(elapsed_ms);
+}
+
+void AISystem::step_behaviours(float elapsed_ms) {
+  PROFILE_SCOPE("ai.behaviours");
   // bosses
   if (registry.bosses.entities.size() > 0) {
     do_boss_ai(elapsed_ms);
@@ -804,7 +815,16 @@ void AISystem::step(float elapsed_ms) {
   do_wander_ai_square(elapsed_ms);
   do_track_player(elapsed_ms);
   do_track_player_ranged(elapsed_ms);
-  do_boids(elapsed_ms);
+}
+
+void AISystem::steer_groups(float elapsed_ms) {
+  PROFILE_SCOPE("ai.boids");
+  steer_boids(elapsed_ms);
+}
+
+void AISystem::step_attacks(float elapsed_ms) {
+  PROFILE_SCOPE("ai.attacks");
+  surround_with_boids(elapsed_ms);
   do_projectile_firing(elapsed_ms);
 }
 
@@ -20,16 +20,25 @@ class AISystem {
   void do_projectile_firing(float elapsed_ms);
   void do_lobster(float elapsed_ms, Entity lobster, Entity player);
   void update_lobster(float elapsed_ms, Entity lobster);
-  bool in_range_of_player(Position &pos, Position &player_pos, float range);
+  bool in_range_of_player(const Position &pos, const Position &player_pos,
+                          float range);
 
   float sharkman_texture_num = 0.f;
   public:
+  // A tick of AI, the three below in a row. The frame runs them as systems of
+  // their own, see simulation.cpp.
   void step(float elapsed_ms);
+  // Bosses, wandering and tracking the player
+  void step_behaviours(float elapsed_ms);
+  // Boids steering, only reads and writes components
+  void steer_groups(float elapsed_ms);
+  // Groups closing in on the player and enemies firing
+  void step_attacks(float elapsed_ms);
   void init(RenderSystem* renderer_arg);
 };
 
 bool is_tracking(Entity e);
 bool any_tracking(std::vector<Entity> entities);
 void choose_new_direction(Entity enemy, Entity other);
-bool can_see_entity(Position &pos, Position &entity_pos);
+bool can_see_entity(const Position &pos, const Position &entity_pos);
 void removeFromAI(Entity& e);
@@ -8,6 +8,7 @@
 #include "ai_system.hpp"
 #include "collision_system.hpp"
 #include "debuff.hpp"
+#include "jobs.hpp"
 #include "physics.hpp"
 #include "physics_system.hpp"
 #include "random.hpp"
@@ -23,7 +24,7 @@ static vec2 get_center_of_mass(Group& g) {
       continue;
     }
 
-    Position& pos = registry.positions.get(e);
+    ConstPositionRef pos = registry.positions.get(e);
     result += pos.position;
   }
   result.x = result.x / (float)g.members.size();
@@ -40,7 +41,7 @@ static vec2 get_avg_dir(Group& g) {
       continue;
     }
 
-    Motion& motion = registry.motions.get(e);
+    ConstMotionRef motion = registry.motions.get(e);
     result += motion.velocity;
   }
   result.x = result.x / (float)g.members.size();
@@ -51,7 +52,7 @@ static vec2 get_avg_dir(Group& g) {
 
 static inline float get_speed(Entity e) {
   if (registry.motions.has(e)) {
-    Motion& motion = registry.motions.get(e);
+    ConstMotionRef motion = registry.motions.get(e);
     return sqrt(dot(motion.velocity, motion.velocity));
   }
   return 0.f;
@@ -61,16 +62,16 @@ static void do_boid_separation(Group& g, Entity e) {
   if (!registry.positions.has(e) || !registry.motions.has(e)) {
     return;
   }
-  vec2      dir_vec  = {0.f, 0.f};
-  Position& position = registry.positions.get(e);
-  Motion&   motion   = registry.motions.get(e);
+  vec2             dir_vec  = {0.f, 0.f};
+  ConstPositionRef position = registry.positions.get(e);
+  MotionRef        motion   = registry.motions.get_mut(e);
 
   // get average direction of all group members within range
   for (Entity other : g.members) {
     if (e == other || !registry.positions.has(other)) {
       continue;
     }
-    Position& pos_other = registry.positions.get(other);
+    ConstPositionRef pos_other = registry.positions.get(other);
 
     vec2  local_dir = position.position - pos_other.position;
     float dist      = sqrt(dot(local_dir, local_dir));
@@ -87,23 +88,21 @@ static void do_boid_avoid_obstacles(Entity e) {
   if (registry.positions.has(e)) {
     return;
   }
-  vec2      dir_vec  = {0.f, 0.f};
-  Position& position = registry.positions.get(e);
-  Motion&   motion   = registry.motions.get(e);
-  for (Entity wall : registry.activeWalls.entities) {
-    if (!registry.positions.has(wall)) {
-      continue;
-    }
-    Position& pos_other = registry.positions.get(wall);
-    vec2      point     = find_closest_point(position, pos_other);
-
-    vec2  local_dir = position.position - point;
-    float dist      = sqrt(dot(local_dir, local_dir));
-
-    if (dist <= MIN_DIST) {
-      dir_vec += local_dir;
-    }
-  }
+  vec2             dir_vec  = {0.f, 0.f};
+  ConstPositionRef position = registry.positions.get(e);
+  MotionRef        motion   = registry.motions.get_mut(e);
+  registry.view<ActiveWall, Position>().each(
+      [&](Entity wall, const ActiveWall& active_wall,
+          ConstPositionRef pos_other) {
+        vec2 point = find_closest_point(position, pos_other);
+
+        vec2  local_dir = position.position - point;
+        float dist      = sqrt(dot(local_dir, local_dir));
+
+        if (dist <= MIN_DIST) {
+          dir_vec += local_dir;
+        }
+      });
   motion.velocity += dir_vec * SEPERATION_WEIGHT;
 }
 
@@ -119,7 +118,7 @@ static void do_boid_alignment(Group& g, Entity e) {
   vec2 avg_dir = get_avg_dir(g);
   avg_dir /= ALIGNMENT_WEIGHT;
 
-  Motion& motion = registry.motions.get(e);
+  MotionRef motion = registry.motions.get_mut(e);
   motion.velocity += avg_dir;
 }
 
@@ -134,8 +133,8 @@ static void do_boid_cohesion(Group& g, Entity e) {
   }
   vec2 center_of_mass = get_center_of_mass(g);
 
-  Position& position = registry.positions.get(e);
-  Motion&   motion   = registry.motions.get(e);
+  ConstPositionRef position = registry.positions.get(e);
+  MotionRef        motion   = registry.motions.get_mut(e);
 
   vec2 dir = (center_of_mass - position.position) * COHESION_WEIGHT;
 
@@ -158,11 +157,11 @@ static void do_tracking_surround(Group& g) {
       continue;
     }
     // reset cooldown so it looks less jank
-    EntityGroup& eg  = registry.entityGroups.get(e);
+    EntityGroup& eg  = registry.entityGroups.get_mut(e);
     eg.active_dir_cd = eg.change_dir_cd;
 
-    Position& enemy_pos    = registry.positions.get(e);
-    Motion&   enemy_motion = registry.motions.get(e);
+    PositionRef enemy_pos    = registry.positions.get_mut(e);
+    MotionRef   enemy_motion = registry.motions.get_mut(e);
 
     //
     // first shark moves directly at the player
@@ -201,9 +200,9 @@ static void do_normalize_speed(Entity e, float speed) {
   }
 
   if (registry.motions.has(e) && registry.positions.has(e)) {
-    Position& position = registry.positions.get(e);
-    Motion&   motion   = registry.motions.get(e);
-    motion.velocity    = normalize(motion.velocity) * speed;
+    PositionRef position = registry.positions.get_mut(e);
+    MotionRef   motion   = registry.motions.get_mut(e);
+    motion.velocity      = normalize(motion.velocity) * speed;
 
     position.scale.x = abs(position.scale.x);
     if (motion.velocity.x > 0) {
@@ -212,28 +211,41 @@ static void do_normalize_speed(Entity e, float speed) {
   }
 }
 
-void do_boids(float elapsed_ms) {
-  for (Group& g : registry.groups.components) {
-    // update individual entities within the boid
-    for (Entity e : g.members) {
-      if (!registry.entityGroups.has(e)) {
-        continue;
-      }
-
-      EntityGroup& eg = registry.entityGroups.get(e);
-      eg.active_dir_cd -= elapsed_ms;
-      if (eg.active_dir_cd <= 0.f) {
-        float speed = get_speed(e);
-        do_boid_avoid_obstacles(e);
-        do_boid_separation(g, e);
-        do_boid_alignment(g, e);
-        do_boid_cohesion(g, e);
-        do_normalize_speed(e, speed);
-        eg.active_dir_cd = eg.change_dir_cd;
-      }
+// update individual entities within the boid
+static void do_group_members(Group& g, float elapsed_ms) {
+  for (Entity e : g.members) {
+    if (!registry.entityGroups.has(e)) {
+      continue;
+    }
+
+    EntityGroup& eg = registry.entityGroups.get_mut(e);
+    eg.active_dir_cd -= elapsed_ms;
+    if (eg.active_dir_cd <= 0.f) {
+      float speed = get_speed(e);
+      do_boid_avoid_obstacles(e);
+      do_boid_separation(g, e);
+      do_boid_alignment(g, e);
+      do_boid_cohesion(g, e);
+      do_normalize_speed(e, speed);
+      eg.active_dir_cd = eg.change_dir_cd;
+    }
+  }
+}
+
+void steer_boids(float elapsed_ms) {
+  // groups share no members, so they can steer at the same time
+  auto& groups = registry.groups.components;
+  auto  steer  = [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+      do_group_members(groups[i], elapsed_ms);
     }
+  };
+  jobs().parallel_for(0, groups.size(), BOIDS_GROUPS_PER_JOB, steer);
+}
 
-    // collaborative behaviour
+void surround_with_boids(float elapsed_ms) {
+  for (Group& g : registry.groups.components) {
+    // collaborative behaviour, it draws random numbers so stays in order
     g.active_dir_cd -= elapsed_ms;
     if (g.active_dir_cd <= 0.f) {
       do_tracking_surround(g);
@@ -6,6 +6,12 @@
 #define SEPERATION_WEIGHT 1.f
 #define COHESION_WEIGHT 0.3f
 #define ALIGNMENT_WEIGHT 0.3f
+// Groups per job, up to this many are steered on the calling thread
+#define BOIDS_GROUPS_PER_JOB 4
 
 extern Entity player;
-void do_boids(float elapsed_ms);
+// Members of every group change direction when due. Groups steer on the job
+// pool, this only reads and writes components.
+void steer_boids(float elapsed_ms);
+// Groups tracking the player fan out around them. Draws random numbers.
+void surround_with_boids(float elapsed_ms);
@@ -1,6 +1,11 @@
 #include "audio_system.hpp"
 
+#include "profiler.hpp"
+
 AudioSystem::~AudioSystem() {
+  if (muted) {
+    return;
+  }
   for (auto it = music_map.begin(); it != music_map.end(); ++it) {
     Mix_FreeMusic(music_map[it->first]);
   }
@@ -59,8 +64,17 @@ void AudioSystem::init() {
   fprintf(stderr, "Loaded music\n");
 }
 
+void AudioSystem::init_headless() {
+  muted = true;
+}
+
 void AudioSystem::step(float elapsed_ms) {
+  PROFILE_SCOPE("audios.step");
+  // Requests are drained even when muted, the systems check for pending ones
   for (Entity entity : registry.sounds.entities) {
+    if (muted) {
+      break;
+    }
     Sound sound = registry.sounds.get(entity);
     int   channel =
         Mix_PlayChannelTimed(-1, sound_map[sound.id], 0, sound.max_time);
@@ -75,9 +89,16 @@ void AudioSystem::step(float elapsed_ms) {
     }
     Mix_Volume(channel, 64);
   }
-  registry.sounds.clear();
+  while (registry.sounds.entities.size() > 0) {
+    Entity entity = registry.sounds.entities.back();
+    registry.sounds.remove(entity);
+    registry.release_if_empty(entity);
+  }
 
   for (Entity entity : registry.musics.entities) {
+    if (muted) {
+      break;
+    }
     Music music = registry.musics.get(entity);
     //cheat code for pausing music
     if (music.id == MUSIC_ASSET_ID::MUSIC_COUNT) {
@@ -87,5 +108,9 @@ void AudioSystem::step(float elapsed_ms) {
       Mix_PlayMusic(music_map[music.id], -1);
     }
   }
-  registry.musics.clear();
+  while (registry.musics.entities.size() > 0) {
+    Entity entity = registry.musics.entities.back();
+    registry.musics.remove(entity);
+    registry.release_if_empty(entity);
+  }
 }
\ No newline at end of file
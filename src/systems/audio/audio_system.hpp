@@ -80,10 +80,15 @@ private:
 
 	void init_audio_maps();
 
+	// Set by init_headless(), requests are dropped instead of played
+	bool muted = false;
+
 public:
 
     ~AudioSystem();
 
 	void init();
+	// Null audio for runs without a device, nothing is loaded or played
+	void init_headless();
 	void step(float elapsed_ms);
 };
\ No newline at end of file
@@ -15,21 +15,27 @@
 #include "enemy.hpp"
 #include "entity_type.hpp"
 #include "items.hpp"
+#include "jobs.hpp"
 #include "oxygen.hpp"
 #include "player.hpp"
+#include "profiler.hpp"
 #include "tiny_ecs_registry.hpp"
 
 void CollisionSystem::init(RenderSystem* renderer, LevelSystem* level) {
   this->renderer = renderer;
   this->level    = level;
+
+  // only the plates that changed are looked at, see
+  // handle_pressure_plate_changes
+  registry.pressedPlates.track_changes();
 }
 
 bool CollisionSystem::checkBoxCollision(Entity entity_i, Entity entity_j) {
   if (!registry.positions.has(entity_i) || !registry.positions.has(entity_j)) {
     return false;
   }
-  Position& position_i = registry.positions.get(entity_i);
-  Position& position_j = registry.positions.get(entity_j);
+  ConstPositionRef position_i = registry.positions.get(entity_i);
+  ConstPositionRef position_j = registry.positions.get(entity_j);
   if (box_collides(position_i, position_j)) {
     registry.collisions.emplace_with_duplicates(entity_i, entity_j);
     registry.collisions.emplace_with_duplicates(entity_j, entity_i);
@@ -38,24 +44,25 @@ bool CollisionSystem::checkBoxCollision(Entity entity_i, Entity entity_j) {
   return false;
 }
 
-bool CollisionSystem::checkPlayerMeshCollision(Entity entity_i, Entity entity_j,
-                                               Entity collisionMesh) {
+bool CollisionSystem::checkPlayerBounds(Entity entity_i, Entity entity_j) {
   if (!registry.positions.has(entity_i) || !registry.positions.has(entity_j)) {
     return false;
   }
-  Position& position_i = registry.positions.get(entity_i);
-  Position& position_j = registry.positions.get(entity_j);
-  bool      player_bb_collides;
+  ConstPositionRef position_i = registry.positions.get(entity_i);
+  ConstPositionRef position_j = registry.positions.get(entity_j);
   if (registry.enemyProjectiles.has(entity_j) &&
       registry.enemyProjectiles.get(entity_j).type == ENTITY_TYPE::SHOCKWAVE) {
     // shockwave uses circle mesh collision
-    float radius       = max(position_j.scale.x, position_j.scale.y) / 2;
-    player_bb_collides = circle_box_collides(position_j, radius, position_i);
-  } else {
-    player_bb_collides = box_collides(position_i, position_j);
+    float radius = max(position_j.scale.x, position_j.scale.y) / 2;
+    return circle_box_collides(position_j, radius, position_i);
   }
+  return box_collides(position_i, position_j);
+}
 
-  if (player_bb_collides && mesh_collides(collisionMesh, entity_j)) {
+bool CollisionSystem::checkPlayerMeshCollision(Entity entity_i, Entity entity_j,
+                                               Entity collisionMesh) {
+  if (checkPlayerBounds(entity_i, entity_j) &&
+      mesh_collides(collisionMesh, entity_j)) {
     registry.collisions.emplace_with_duplicates(entity_i, entity_j);
     registry.collisions.emplace_with_duplicates(entity_j, entity_i);
     return true;
@@ -63,12 +70,34 @@ bool CollisionSystem::checkPlayerMeshCollision(Entity entity_i, Entity entity_j,
   return false;
 }
 
+void CollisionSystem::checkPlayerMeshCollisions(Entity entity_i,
+                                                Entity collisionMesh) {
+  // the mesh tests are the expensive part, they run side by side and the
+  // collisions are added in candidate order
+  mesh_hits.assign(mesh_candidates.size(), 0);
+  auto test = [&](size_t begin, size_t end) {
+    for (size_t k = begin; k < end; k++) {
+      mesh_hits[k] = mesh_collides(collisionMesh, mesh_candidates[k]);
+    }
+  };
+  jobs().parallel_for(0, mesh_candidates.size(), 1, test);
+
+  for (size_t k = 0; k < mesh_candidates.size(); k++) {
+    if (mesh_hits[k]) {
+      registry.collisions.emplace_with_duplicates(entity_i,
+                                                  mesh_candidates[k]);
+      registry.collisions.emplace_with_duplicates(mesh_candidates[k],
+                                                  entity_i);
+    }
+  }
+}
+
 bool CollisionSystem::checkCircleCollision(Entity entity_i, Entity entity_j) {
   if (!registry.positions.has(entity_i) || !registry.positions.has(entity_j)) {
     return false;
   }
-  Position& position_i = registry.positions.get(entity_i);
-  Position& position_j = registry.positions.get(entity_j);
+  ConstPositionRef position_i = registry.positions.get(entity_i);
+  ConstPositionRef position_j = registry.positions.get(entity_j);
   if (circle_collides(position_i, position_j)) {
     registry.collisions.emplace_with_duplicates(entity_i, entity_j);
     registry.collisions.emplace_with_duplicates(entity_j, entity_i);
@@ -83,9 +112,10 @@ bool CollisionSystem::checkCircleBoxCollision(Entity circle_bound_entity,
       !registry.positions.has(box_bound_entity)) {
     return false;
   }
-  Position& position_i = registry.positions.get(circle_bound_entity);
-  float     radius     = max(position_i.scale.x, position_i.scale.y) / 2.f;
-  Position& position_j = registry.positions.get(box_bound_entity);
+  ConstPositionRef position_i = registry.positions.get(circle_bound_entity);
+  float            radius     =
+      max(position_i.scale.x, position_i.scale.y) / 2.f;
+  ConstPositionRef position_j = registry.positions.get(box_bound_entity);
   if (circle_box_collides(position_i, radius, position_j)) {
     registry.collisions.emplace_with_duplicates(circle_bound_entity,
                                                 box_bound_entity);
@@ -97,46 +127,84 @@ bool CollisionSystem::checkCircleBoxCollision(Entity circle_bound_entity,
 }
 
 void CollisionSystem::step(float elapsed_ms) {
-  collision_detection();
+  PROFILE_SCOPE("collisions.step");
+  {
+    PROFILE_SCOPE("collisions.detect");
+    collision_detection();
 
-  handle_collision_end();
+    handle_collision_end();
+  }
+  {
+    PROFILE_SCOPE("collisions.resolve");
+    collision_resolution();
 
-  collision_resolution();
+    handle_pressure_plate_changes();
+  }
 }
 
 // Check if collision has ended here.
 void CollisionSystem::handle_collision_end() {
-  // Check if pressure plate collision has ended.
-  for (Entity entity : registry.pressurePlates.entities) {
-    bool pressurePlateCollisionExists = registry.collisions.has(entity);
-    if (!pressurePlateCollisionExists) {
-      if (!registry.sounds.has(entity) &&
-          registry.pressurePlates.get(entity).active) {
-        registry.sounds.insert(entity, Sound(SOUND_ASSET_ID::PRESSURE_PLATE));
-      }
-      registry.pressurePlates.get(entity).active = false;
-      // Connect to an available door, if we haven't yet.
-      // Exploits the fact that there's only 1 PP per room.
-      for (Entity& entity : registry.activeDoors.entities) {
-        if (registry.doorConnections.has(entity)) {
-          DoorConnection& door_connection = registry.doorConnections.get(entity);
-          if (door_connection.objective == Objective::PRESSURE_PLATE) {
-            door_connection.locked = true;
-
-            // change the sprite
-            if (registry.renderRequests.has(entity)) {
-              registry.renderRequests.remove(entity);
-
-              level->assign_door_sprite(entity, door_connection);
-            }
-          }
+  // Release the pressure plates nothing stands on anymore
+  std::vector<Entity> released;
+  for (Entity entity : registry.pressedPlates.entities) {
+    if (!registry.collisions.has(entity)) {
+      released.push_back(entity);
+    }
+  }
+  registry.pressedPlates.remove_batch(released);
+}
+
+// React to the pressure plates pressed or released during this step. Plates
+// destroyed along with their room show up as released, but are gone by now.
+void CollisionSystem::handle_pressure_plate_changes() {
+  bool changed = false;
+  for (Entity entity : registry.pressedPlates.removed()) {
+    if (!registry.pressurePlates.has(entity) ||
+        registry.pressedPlates.has(entity)) {
+      continue;
+    }
+    if (!registry.sounds.has(entity)) {
+      registry.sounds.insert(entity, Sound(SOUND_ASSET_ID::PRESSURE_PLATE));
+    }
+    registry.renderRequests.get_mut(entity).used_texture =
+        TEXTURE_ASSET_ID::PRESSURE_PLATE_OFF;
+    changed = true;
+  }
+  for (Entity entity : registry.pressedPlates.added()) {
+    if (!registry.pressedPlates.has(entity)) {
+      continue;
+    }
+    if (!registry.sounds.has(entity)) {
+      registry.sounds.insert(entity, Sound(SOUND_ASSET_ID::PRESSURE_PLATE));
+    }
+    registry.renderRequests.get_mut(entity).used_texture =
+        TEXTURE_ASSET_ID::PRESSURE_PLATE_ON;
+    changed = true;
+  }
+  registry.pressedPlates.clear_changes();
+  if (!changed) {
+    return;
+  }
+
+  // Connect to an available door, if we haven't yet.
+  // Exploits the fact that there's only 1 PP per room.
+  bool locked = registry.pressedPlates.size() == 0;
+  for (Entity& entity : registry.activeDoors.entities) {
+    if (registry.doorConnections.has(entity)) {
+      DoorConnection& door_connection =
+          registry.doorConnections.get_mut(entity);
+      if (door_connection.objective == Objective::PRESSURE_PLATE) {
+        door_connection.locked = locked;
+
+        // change the sprite
+        if (registry.renderRequests.has(entity)) {
+          registry.renderRequests.remove(entity);
+
+          level->assign_door_sprite(entity, door_connection);
         }
       }
-      registry.renderRequests.get(entity).used_texture =
-          TEXTURE_ASSET_ID::PRESSURE_PLATE_OFF;
     }
   }
-
 }
 
 /***********************************
@@ -163,55 +231,87 @@ void CollisionSystem::collision_detection() {
 }
 
 void CollisionSystem::detectPlayerProjectileCollisions() {
+  PROFILE_SCOPE("collisions.detect_projectiles");
   ComponentContainer<PlayerProjectile>& playerproj_container =
       registry.playerProjectiles;
   ComponentContainer<Deadly>&     enemy_container      = registry.deadlys;
   ComponentContainer<ActiveWall>& wall_container       = registry.activeWalls;
   ComponentContainer<Consumable>& consumable_container = registry.consumables;
 
-  for (uint i = 0; i < playerproj_container.components.size(); i++) {
-    Entity entity_i = playerproj_container.entities[i];
-    if (!registry.positions.has(entity_i) ||
-        registry.playerProjectiles.get(entity_i).is_loaded) {
-      continue;
-    }
-
-    // detect player projectile and wall collisions
-    for (uint j = 0; j < wall_container.size(); j++) {
-      Entity entity_j = wall_container.entities[j];
-      checkBoxCollision(entity_i, entity_j);
-    }
-
-    // detect player projectile and oxygen canister collisions
-    for (uint j = 0; j < consumable_container.size(); j++) {
-      Entity      entity_j   = consumable_container.entities[j];
-      Consumable& consumable = consumable_container.get(entity_j);
-      if (consumable.type != ENTITY_TYPE::OXYGEN_CANISTER) {
+  // Projectiles are tested independently, possibly on other threads, and
+  // their collisions added in projectile order afterwards
+  size_t count = playerproj_container.components.size();
+  if (projectile_hits.size() < count) {
+    projectile_hits.resize(count);
+  }
+  auto detect = [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+      std::vector<Entity>& hits     = projectile_hits[i];
+      Entity               entity_i = playerproj_container.entities[i];
+      hits.clear();
+      if (!registry.positions.has(entity_i) ||
+          registry.playerProjectiles.get(entity_i).is_loaded) {
         continue;
       }
-      checkBoxCollision(entity_i, entity_j);
-    }
+      Position position_i = registry.positions.get(entity_i);
+
+      // detect player projectile and wall collisions
+      for (uint j = 0; j < wall_container.size(); j++) {
+        Entity entity_j = wall_container.entities[j];
+        if (registry.positions.has(entity_j) &&
+            box_collides(position_i, registry.positions.get(entity_j))) {
+          hits.push_back(entity_j);
+        }
+      }
 
-    // detect player projectile and enemy collisions
-    for (uint j = 0; j < enemy_container.size(); j++) {
-      Entity entity_j = enemy_container.entities[j];
-      bool   collided = checkCircleCollision(entity_i, entity_j);
-      // if the projectile is single target and collided, don't check for
-      // anymore enemies.
+      // detect player projectile and oxygen canister collisions
+      for (uint j = 0; j < consumable_container.size(); j++) {
+        Entity            entity_j   = consumable_container.entities[j];
+        const Consumable& consumable = consumable_container.get(entity_j);
+        if (consumable.type != ENTITY_TYPE::OXYGEN_CANISTER) {
+          continue;
+        }
+        if (registry.positions.has(entity_j) &&
+            box_collides(position_i, registry.positions.get(entity_j))) {
+          hits.push_back(entity_j);
+        }
+      }
+
+      // detect player projectile and enemy collisions
       PlayerProjectile& playerproj_comp = playerproj_container.components[i];
-      if (collided && (playerproj_comp.type == PROJECTILES::HARPOON ||
-                       playerproj_comp.type == PROJECTILES::NET ||
-                       playerproj_comp.type == PROJECTILES::TORPEDO)) {
-        break;
+      for (uint j = 0; j < enemy_container.size(); j++) {
+        Entity entity_j = enemy_container.entities[j];
+        if (!registry.positions.has(entity_j) ||
+            !circle_collides(position_i, registry.positions.get(entity_j))) {
+          continue;
+        }
+        hits.push_back(entity_j);
+        // if the projectile is single target and collided, don't check for
+        // anymore enemies.
+        if (playerproj_comp.type == PROJECTILES::HARPOON ||
+            playerproj_comp.type == PROJECTILES::NET ||
+            playerproj_comp.type == PROJECTILES::TORPEDO) {
+          break;
+        }
       }
     }
+  };
+  jobs().parallel_for(0, count, PROJECTILES_PER_JOB, detect);
+
+  for (size_t i = 0; i < count; i++) {
+    Entity entity_i = playerproj_container.entities[i];
+    for (Entity entity_j : projectile_hits[i]) {
+      registry.collisions.emplace_with_duplicates(entity_i, entity_j);
+      registry.collisions.emplace_with_duplicates(entity_j, entity_i);
+    }
   }
 }
 
 void CollisionSystem::detectPlayerCollisions() {
-  ComponentContainer<Player>&         player_container = registry.players;
-  ComponentContainer<Deadly>&         enemy_container  = registry.deadlys;
-  ComponentContainer<EnemyProjectile> enemy_proj_container =
+  PROFILE_SCOPE("collisions.detect_player");
+  ComponentContainer<Player>&          player_container = registry.players;
+  ComponentContainer<Deadly>&          enemy_container  = registry.deadlys;
+  ComponentContainer<EnemyProjectile>& enemy_proj_container =
       registry.enemyProjectiles;
   ComponentContainer<Item>&         item_container       = registry.items;
   ComponentContainer<Consumable>&   consumable_container = registry.consumables;
@@ -224,52 +324,68 @@ void CollisionSystem::detectPlayerCollisions() {
       continue;
     }
     Player player_comp = registry.players.get(entity_i);
+    mesh_candidates.clear();
 
     // detect player and enemy collisions
     for (uint j = 0; j < enemy_container.size(); j++) {
       Entity entity_j = enemy_container.entities[j];
       // don't detect the enemy collision if their attack is on cooldown
       if (registry.modifyOxygenCd.has(entity_j)) {
-        ModifyOxygenCD& modifyOxygenCd = registry.modifyOxygenCd.get(entity_j);
+        const ModifyOxygenCD& modifyOxygenCd =
+            registry.modifyOxygenCd.get(entity_j);
         if (modifyOxygenCd.curr_cd > 0.f) {
           continue;
         }
       }
-      checkPlayerMeshCollision(entity_i, entity_j, player_comp.collisionMesh);
+      if (checkPlayerBounds(entity_i, entity_j)) {
+        mesh_candidates.push_back(entity_j);
+      }
     }
 
     for (uint j = 0; j < enemy_proj_container.size(); j++) {
       Entity entity_j = enemy_proj_container.entities[j];
-      checkPlayerMeshCollision(entity_i, entity_j, player_comp.collisionMesh);
+      if (checkPlayerBounds(entity_i, entity_j)) {
+        mesh_candidates.push_back(entity_j);
+      }
     }
 
     for (uint j = 0; j < item_container.size(); j++) {
       Entity entity_j = item_container.entities[j];
-      checkPlayerMeshCollision(entity_i, entity_j, player_comp.collisionMesh);
+      if (checkPlayerBounds(entity_i, entity_j)) {
+        mesh_candidates.push_back(entity_j);
+      }
     }
 
     for (uint j = 0; j < consumable_container.size(); j++) {
       Entity entity_j = consumable_container.entities[j];
-      checkPlayerMeshCollision(entity_i, entity_j, player_comp.collisionMesh);
+      if (checkPlayerBounds(entity_i, entity_j)) {
+        mesh_candidates.push_back(entity_j);
+      }
     }
 
     for (uint j = 0; j < interactable_container.size(); j++) {
       Entity entity_j = interactable_container.entities[j];
       // don't detect the interactable collision if their attack is on cooldown
       if (registry.modifyOxygenCd.has(entity_j)) {
-        ModifyOxygenCD& modifyOxygenCd = registry.modifyOxygenCd.get(entity_j);
+        const ModifyOxygenCD& modifyOxygenCd =
+            registry.modifyOxygenCd.get(entity_j);
         if (modifyOxygenCd.curr_cd > 0.f) {
           continue;
         }
       }
-      checkPlayerMeshCollision(entity_i, entity_j, player_comp.collisionMesh);
+      if (checkPlayerBounds(entity_i, entity_j)) {
+        mesh_candidates.push_back(entity_j);
+      }
     }
+
+    checkPlayerMeshCollisions(entity_i, player_comp.collisionMesh);
   }
 }
 
 void CollisionSystem::detectEnemySupportCollisions() {
-  ComponentContainer<Deadly>&      enemy_container = registry.deadlys;
-  ComponentContainer<EnemySupport> enemy_supp_container =
+  PROFILE_SCOPE("collisions.detect_enemy_support");
+  ComponentContainer<Deadly>&       enemy_container = registry.deadlys;
+  ComponentContainer<EnemySupport>& enemy_supp_container =
       registry.enemySupports;
 
   for (uint i = 0; i < enemy_supp_container.components.size(); i++) {
@@ -284,7 +400,7 @@ void CollisionSystem::detectEnemySupportCollisions() {
           entity_j == registry.enemySupports.get(entity_i).user)
         continue;
       if (!registry.oxygen.has(entity_j)) continue;
-      Oxygen& entity_j_oxygen = registry.oxygen.get(entity_j);
+      const Oxygen& entity_j_oxygen = registry.oxygen.get(entity_j);
       if (entity_j_oxygen.level >= entity_j_oxygen.capacity) continue;
       checkCircleBoxCollision(entity_i, entity_j);
     }
@@ -292,14 +408,15 @@ void CollisionSystem::detectEnemySupportCollisions() {
 }
 
 void CollisionSystem::detectWallCollisions() {
-  ComponentContainer<Deadly>&         enemy_container = registry.deadlys;
-  ComponentContainer<EnemyProjectile> enemy_proj_container =
+  PROFILE_SCOPE("collisions.detect_walls");
+  ComponentContainer<Deadly>&          enemy_container = registry.deadlys;
+  ComponentContainer<EnemyProjectile>& enemy_proj_container =
       registry.enemyProjectiles;
-  ComponentContainer<EnemySupport> enemy_supp_container =
+  ComponentContainer<EnemySupport>& enemy_supp_container =
       registry.enemySupports;
   ComponentContainer<ActiveWall>& wall_container = registry.activeWalls;
 
-  for (uint i = 0; i < wall_container.components.size(); i++) {
+  for (uint i = 0; i < wall_container.size(); i++) {
     Entity entity_i = wall_container.entities[i];
     if (!registry.positions.has(entity_i)) {
       continue;
@@ -323,11 +440,12 @@ void CollisionSystem::detectWallCollisions() {
 }
 
 void CollisionSystem::detectDoorCollisions() {
+  PROFILE_SCOPE("collisions.detect_doors");
   ComponentContainer<ActiveDoor>& door_container   = registry.activeDoors;
   ComponentContainer<Deadly>&     enemy_container  = registry.deadlys;
   ComponentContainer<Player>&     player_container = registry.players;
 
-  for (uint i = 0; i < door_container.components.size(); i++) {
+  for (uint i = 0; i < door_container.size(); i++) {
     Entity entity_i = door_container.entities[i];
 
     for (uint j = 0; j < enemy_container.size(); j++) {
@@ -336,14 +454,15 @@ void CollisionSystem::detectDoorCollisions() {
     }
 
     for (uint j = 0; j < player_container.size(); j++) {
-      Entity  entity_j    = player_container.entities[j];
-      Player& player_comp = registry.players.get(entity_j);
+      Entity        entity_j    = player_container.entities[j];
+      const Player& player_comp = registry.players.get(entity_j);
       checkPlayerMeshCollision(entity_j, entity_i, player_comp.collisionMesh);
     }
   }
 }
 
 void CollisionSystem::detectMassCollisions() {
+  PROFILE_SCOPE("collisions.detect_masses");
   ComponentContainer<Mass>&         mass_container = registry.masses;
   ComponentContainer<Interactable>& interactable_container =
       registry.interactable;
@@ -351,12 +470,14 @@ void CollisionSystem::detectMassCollisions() {
 
   for (uint i = 0; i < mass_container.size(); i++) {
     Entity entity_i = mass_container.entities[i];
+    mesh_candidates.clear();
 
     for (uint j = 0; j < interactable_container.size(); j++) {
       Entity entity_j = interactable_container.entities[j];
       if (registry.players.has(entity_i)) {
-        Player& player_comp = registry.players.get(entity_i);
-        checkPlayerMeshCollision(entity_i, entity_j, player_comp.collisionMesh);
+        if (checkPlayerBounds(entity_i, entity_j)) {
+          mesh_candidates.push_back(entity_j);
+        }
       } else {
         checkBoxCollision(entity_i, entity_j);
       }
@@ -368,12 +489,18 @@ void CollisionSystem::detectMassCollisions() {
         continue;
       }
       if (registry.players.has(entity_i)) {
-        Player& player_comp = registry.players.get(entity_i);
-        checkPlayerMeshCollision(entity_i, entity_j, player_comp.collisionMesh);
+        if (checkPlayerBounds(entity_i, entity_j)) {
+          mesh_candidates.push_back(entity_j);
+        }
       } else {
         checkBoxCollision(entity_i, entity_j);
       }
     }
+
+    if (registry.players.has(entity_i)) {
+      checkPlayerMeshCollisions(entity_i,
+                                registry.players.get(entity_i).collisionMesh);
+    }
   }
 }
 
@@ -578,7 +705,7 @@ void CollisionSystem::routePlayerProjCollisions(Entity player_proj,
   }
 
   PlayerProjectile& player_proj_component =
-      registry.playerProjectiles.get(player_proj);
+      registry.playerProjectiles.get_mut(player_proj);
   bool checkWepSwapped = player_proj != player_projectile;
 
   // Remove render projectile if weapons have been swapped or collision just
@@ -642,8 +769,8 @@ void CollisionSystem::resolvePlayerItemCollision(Entity player, Entity item) {
 
   // will add a key if this is in fact one
   if (registry.items.has(item)) {
-    Item&     i     = registry.items.get(item);
-    Objective color = i.item;
+    const Item& i     = registry.items.get(item);
+    Objective   color = i.item;
 
     // We need to route this somewhere because the collect functions take a
     // renderer and this class doesn't have one. Probably doesn't belong in
@@ -658,7 +785,7 @@ void CollisionSystem::resolvePlayerEnemyProjCollision(Entity player,
   // For now it's almost equal to the above, but make a new function just to
   // open it to changes
 
-  EnemyProjectile& proj = registry.enemyProjectiles.get(enemy_proj);
+  const EnemyProjectile& proj = registry.enemyProjectiles.get(enemy_proj);
   if (proj.type == ENTITY_TYPE::SHOCKWAVE &&
       !can_see_entity(registry.positions.get(enemy_proj),
                       registry.positions.get(player))) {
@@ -696,31 +823,9 @@ void CollisionSystem::resolvePlayerInteractableCollision(Entity player,
   if (registry.deathTimers.has(player)) {
     return;
   }
-  if (registry.pressurePlates.has(interactable)) {
-    if (!registry.pressurePlates.get(interactable).active) {
-      registry.renderRequests.get(interactable).used_texture =
-          TEXTURE_ASSET_ID::PRESSURE_PLATE_ON;
-      registry.pressurePlates.get(interactable).active = true;
-      for (Entity& entity : registry.activeDoors.entities) {
-        if (registry.doorConnections.has(entity)) {
-          DoorConnection& door_connection = registry.doorConnections.get(entity);
-          if (door_connection.objective == Objective::PRESSURE_PLATE) {
-            door_connection.locked = false;
-
-            // change the sprite
-            if (registry.renderRequests.has(entity)) {
-              registry.renderRequests.remove(entity);
-
-              level->assign_door_sprite(entity, door_connection);
-            }
-          }
-        }
-      }
-      if (!registry.sounds.has(interactable)) {
-        registry.sounds.insert(interactable,
-                               Sound(SOUND_ASSET_ID::PRESSURE_PLATE));
-      }
-    }
+  if (registry.pressurePlates.has(interactable) &&
+      !registry.pressedPlates.has(interactable)) {
+    registry.pressedPlates.emplace(interactable);
   }
   // will add oxygen to the player if it exists
   modifyOxygen(player, interactable);
@@ -729,12 +834,12 @@ void CollisionSystem::resolvePlayerInteractableCollision(Entity player,
 void CollisionSystem::resolveEnemyPlayerProjCollision(Entity enemy,
                                                       Entity player_proj) {
   PlayerProjectile& playerproj_comp =
-      registry.playerProjectiles.get(player_proj);
+      registry.playerProjectiles.get_mut(player_proj);
 
   if (!registry.motions.has(player_proj)) {
     return;
   }
-  Motion& playerproj_motion = registry.motions.get(player_proj);
+  MotionRef playerproj_motion = registry.motions.get_mut(player_proj);
 
   // cthulhu takes no damage in transition, cannot be stunned
   bool is_cthulhu =
@@ -773,8 +878,8 @@ void CollisionSystem::resolveEnemyPlayerProjCollision(Entity enemy,
       /*detectAndResolveConeAOE(player_proj, enemy, SHRIMP_DAMAGE_ANGLE);*/
       // shrimps dont pierce if they hit a boss
       if (registry.bosses.has(enemy)) {
-        Inventory& inventory      = registry.inventory.get(player);
-        bool       check_wep_swap = player_projectile != player_proj;
+        const Inventory& inventory      = registry.inventory.get(player);
+        bool             check_wep_swap = player_projectile != player_proj;
 
         playerproj_motion.velocity = vec2(0.0f, 0.0f);
         playerproj_comp.is_loaded  = true;
@@ -795,12 +900,12 @@ void CollisionSystem::resolveEnemyPlayerProjCollision(Entity enemy,
   // make enemies that track the player briefly start tracking them regardless
   // of range
   if (registry.trackPlayer.has(enemy)) {
-    TracksPlayer& tracks = registry.trackPlayer.get(enemy);
+    TracksPlayer& tracks = registry.trackPlayer.get_mut(enemy);
     tracks.active_track  = true;
   }
 
   if (registry.bosses.has(enemy)) {
-    Boss& boss = registry.bosses.get(enemy);
+    Boss& boss = registry.bosses.get_mut(enemy);
     // if sharkman hit, instantly charge at player
     if (boss.type == ENTITY_TYPE::SHARKMAN) {
       if (!registry.trackPlayer.has(enemy)) {
@@ -838,7 +943,7 @@ void CollisionSystem::resolveBreakablePlayerProjCollision(Entity breakable,
   }
 
   PlayerProjectile& playerproj_comp =
-      registry.playerProjectiles.get(player_proj);
+      registry.playerProjectiles.get_mut(player_proj);
 
   modifyOxygen(breakable, player_proj);
 
@@ -872,7 +977,7 @@ void CollisionSystem::resolveCanisterPlayerProjCollision(Entity canister,
                                                          Entity player_proj) {
   // hack, convert the canister's oxygen quantity to be damage instead of
   // healing
-  OxygenModifier& oxygen = registry.oxygenModifiers.get(canister);
+  OxygenModifier& oxygen = registry.oxygenModifiers.get_mut(canister);
   oxygen.amount          = OXYGEN_CANISTER_DAMAGE;
   detectAndResolveExplosion(canister, player_proj);
   if (registry.positions.has(canister)) {
@@ -882,7 +987,7 @@ void CollisionSystem::resolveCanisterPlayerProjCollision(Entity canister,
 
   if (registry.playerProjectiles.has(player_proj)) {
     PlayerProjectile& playerproj_comp =
-        registry.playerProjectiles.get(player_proj);
+        registry.playerProjectiles.get_mut(player_proj);
     playerproj_comp.is_loaded = true;
   }
 }
@@ -901,8 +1006,8 @@ void CollisionSystem::detectAndResolveExplosion(Entity proj,
       (registry.consumables.has(proj) &&
        registry.consumables.get(proj).type == ENTITY_TYPE::OXYGEN_CANISTER);
 
-  Position&     playerproj_position = registry.positions.get(proj);
-  AreaOfEffect& playerproj_aoe      = registry.aoe.get(proj);
+  ConstPositionRef    playerproj_position = registry.positions.get(proj);
+  const AreaOfEffect& playerproj_aoe      = registry.aoe.get(proj);
 
   // canister projectiles cannot hurt enemies/breakables,
   // prevents cthulhu from killing itself and tentacles
@@ -911,7 +1016,7 @@ void CollisionSystem::detectAndResolveExplosion(Entity proj,
       if (enemy_check == hit_entity || !registry.positions.has(hit_entity)) {
         continue;
       }
-      Position& enemy_position = registry.positions.get(enemy_check);
+      ConstPositionRef enemy_position = registry.positions.get(enemy_check);
 
       if (circle_box_collides(playerproj_position, playerproj_aoe.radius,
                               enemy_position)) {
@@ -930,7 +1035,7 @@ void CollisionSystem::detectAndResolveExplosion(Entity proj,
           !registry.positions.has(hit_entity)) {
         continue;
       }
-      Position& enemy_position = registry.positions.get(breakable_check);
+      ConstPositionRef enemy_position = registry.positions.get(breakable_check);
 
       if (circle_box_collides(playerproj_position, playerproj_aoe.radius,
                               enemy_position)) {
@@ -941,7 +1046,7 @@ void CollisionSystem::detectAndResolveExplosion(Entity proj,
   }
   // canister explosions hurt the player
   if (is_canister && registry.positions.has(player) && player != hit_entity) {
-    Position& player_position = registry.positions.get(player);
+    ConstPositionRef player_position = registry.positions.get(player);
 
     if (circle_box_collides(playerproj_position, playerproj_aoe.radius,
                             player_position) &&
@@ -959,7 +1064,7 @@ void CollisionSystem::detectAndResolveExplosion(Entity proj,
       continue;
     }
 
-    Consumable& consumable = registry.consumables.get(canister_check);
+    const Consumable& consumable = registry.consumables.get(canister_check);
     if (consumable.type != ENTITY_TYPE::OXYGEN_CANISTER ||
         canister_check == hit_entity || canister_check == proj ||
         !registry.positions.has(hit_entity)) {
@@ -967,7 +1072,7 @@ void CollisionSystem::detectAndResolveExplosion(Entity proj,
     }
 
     // blow up any canisters in explosion radius
-    Position& canister_position = registry.positions.get(canister_check);
+    ConstPositionRef canister_position = registry.positions.get(canister_check);
     if (circle_box_collides(playerproj_position, playerproj_aoe.radius,
                             canister_position)) {
       registry.consumables.remove(canister_check);
@@ -982,9 +1087,10 @@ void CollisionSystem::detectAndResolveConeAOE(Entity proj, Entity enemy,
     if (enemy_check == enemy || !registry.positions.has(enemy)) {
       continue;
     }
-    Position&     playerproj_position = registry.positions.get(proj);
-    AreaOfEffect& playerproj_aoe      = registry.aoe.get(proj);
-    Position&     enemy_position      = registry.positions.get(enemy_check);
+    ConstPositionRef    playerproj_position = registry.positions.get(proj);
+    const AreaOfEffect& playerproj_aoe      = registry.aoe.get(proj);
+    ConstPositionRef    enemy_position      =
+        registry.positions.get(enemy_check);
 
     float circle_angle = playerproj_position.angle;
     vec2  pos_diff     = playerproj_position.position - enemy_position.position;
@@ -1034,10 +1140,10 @@ void CollisionSystem::resolveWallPlayerProjCollision(Entity wall,
       !registry.playerProjectiles.has(player_proj)) {
     return;
   }
-  Motion&           proj_motion = registry.motions.get(player_proj);
+  MotionRef         proj_motion = registry.motions.get_mut(player_proj);
   PlayerProjectile& proj_component =
-      registry.playerProjectiles.get(player_proj);
-  Inventory& inventory = registry.inventory.get(player);
+      registry.playerProjectiles.get_mut(player_proj);
+  const Inventory& inventory = registry.inventory.get(player);
 
   bool check_wep_swap      = player_projectile != player_proj;
   proj_motion.velocity     = vec2(0.f);
@@ -1089,36 +1195,12 @@ void CollisionSystem::resolveMassInteractableCollision(Entity mass,
     return;
   }
 
-  Mass& mass_comp = registry.masses.get(mass);
-  if (registry.pressurePlates.has(interactable)) {
-    PressurePlate& pp = registry.pressurePlates.get(interactable);
-    if (!pp.active && pp.mass_activation <= mass_comp.mass) {
-      registry.renderRequests.get(interactable).used_texture =
-          TEXTURE_ASSET_ID::PRESSURE_PLATE_ON;
-      pp.active = true;
-      if (!registry.sounds.has(interactable)) {
-        registry.sounds.insert(interactable,
-                               Sound(SOUND_ASSET_ID::PRESSURE_PLATE));
-      }
-
-      // Connect to an available door, if we haven't yet.
-      // Exploits the fact that there's only 1 PP per room.
-      for (Entity& entity : registry.activeDoors.entities) {
-        if (registry.doorConnections.has(entity)) {
-          DoorConnection& door_connection = registry.doorConnections.get(entity);
-          if (door_connection.objective == Objective::PRESSURE_PLATE) {
-            door_connection.locked = false;
-
-            // change the sprite
-            if (registry.renderRequests.has(entity)) {
-              registry.renderRequests.remove(entity);
-
-              level->assign_door_sprite(entity, door_connection);
-            }
-          }
-        }
-      }
-    }
+  const Mass& mass_comp = registry.masses.get(mass);
+  if (registry.pressurePlates.has(interactable) &&
+      !registry.pressedPlates.has(interactable) &&
+      registry.pressurePlates.get(interactable).mass_activation <=
+          mass_comp.mass) {
+    registry.pressedPlates.emplace(interactable);
   }
 }
 
@@ -1127,9 +1209,9 @@ void CollisionSystem::resolveWallEnemyCollision(Entity wall, Entity enemy) {
     return;
   }
 
-  Motion&   enemy_motion   = registry.motions.get(enemy);
-  Position& enemy_position = registry.positions.get(enemy);
-  Position& wall_position  = registry.positions.get(wall);
+  MotionRef        enemy_motion   = registry.motions.get_mut(enemy);
+  PositionRef      enemy_position = registry.positions.get_mut(enemy);
+  ConstPositionRef wall_position  = registry.positions.get(wall);
   vec2 wall_dir = normalize(wall_position.position - enemy_position.position);
   vec2 temp_velocity = enemy_motion.velocity;
 
@@ -1159,7 +1241,7 @@ void CollisionSystem::resolveWallEnemyCollision(Entity wall, Entity enemy) {
   }
 
   if (registry.bosses.has(enemy)) {
-    Boss& boss = registry.bosses.get(enemy);
+    Boss& boss = registry.bosses.get_mut(enemy);
     if (boss.type == ENTITY_TYPE::SHARKMAN) {
       // break crates if sharkman hits them while targeting player
       if (registry.breakables.has(wall) && registry.trackPlayer.has(enemy) &&
@@ -1170,8 +1252,8 @@ void CollisionSystem::resolveWallEnemyCollision(Entity wall, Entity enemy) {
           registry.sounds.insert(wall,
                         Sound(SOUND_ASSET_ID::METAL_CRATE_DEATH));
         }
-        Motion& motion = registry.motions.get(enemy);
-        float   speed  = sqrt(dot(motion.velocity, motion.velocity));
+        MotionRef motion = registry.motions.get_mut(enemy);
+        float     speed  = sqrt(dot(motion.velocity, motion.velocity));
         motion.velocity =
             normalize(motion.velocity) * (speed + (float)SHARKMAN_MS_INC);
 
@@ -1187,8 +1269,8 @@ void CollisionSystem::resolveWallEnemyCollision(Entity wall, Entity enemy) {
 }
 
 void CollisionSystem::resolveStopOnWall(Entity wall, Entity entity) {
-  Position& wall_position   = registry.positions.get(wall);
-  Position& entity_position = registry.positions.get(entity);
+  ConstPositionRef wall_position   = registry.positions.get(wall);
+  PositionRef      entity_position = registry.positions.get_mut(entity);
 
   vec4 wall_bounds = get_bounds(wall_position);
 
@@ -1234,7 +1316,7 @@ void CollisionSystem::resolveStopOnWall(Entity wall, Entity entity) {
     // between crate/wall. Resolve by pushing away crate.
     if (abs(overlapX) > overlapThreshold) {
       if (registry.breakables.has(wall) && registry.motions.has(wall)) {
-        Motion& crate_pos = registry.motions.get(wall);
+        MotionRef crate_pos = registry.motions.get_mut(wall);
         crate_pos.velocity.x -= overlapX * overlapPushbackPercent;
       }
     }
@@ -1244,13 +1326,13 @@ void CollisionSystem::resolveStopOnWall(Entity wall, Entity entity) {
     if (registry.players.has(entity)) {
       Player player_comp = registry.players.get(entity);
       if (registry.positions.has(player_comp.collisionMesh)) {
-        registry.positions.get(player_comp.collisionMesh).position.x +=
+        registry.positions.get_mut(player_comp.collisionMesh).position.x +=
             overlapX;
       }
     }
 
     if (registry.motions.has(entity) && !registry.players.has(entity)) {
-      registry.motions.get(entity).velocity.x = 0;
+      registry.motions.get_mut(entity).velocity.x = 0;
     }
   } else {
     // If the entity is above the wall, then we need to push up.
@@ -1261,7 +1343,7 @@ void CollisionSystem::resolveStopOnWall(Entity wall, Entity entity) {
     // between crate/wall. Resolve by pushing away crate.
     if (abs(overlapY) > overlapThreshold) {
       if (registry.breakables.has(wall) && registry.motions.has(wall)) {
-        Motion& crate_pos = registry.motions.get(wall);
+        MotionRef crate_pos = registry.motions.get_mut(wall);
         crate_pos.velocity.y -= overlapY * overlapPushbackPercent;
       }
     }
@@ -1271,22 +1353,22 @@ void CollisionSystem::resolveStopOnWall(Entity wall, Entity entity) {
     if (registry.players.has(entity)) {
       Player player_comp = registry.players.get(entity);
       if (registry.positions.has(player_comp.collisionMesh)) {
-        registry.positions.get(player_comp.collisionMesh).position.y +=
+        registry.positions.get_mut(player_comp.collisionMesh).position.y +=
             overlapY;
       }
     }
 
     if (registry.motions.has(entity) && !registry.players.has(entity)) {
-      registry.motions.get(entity).velocity.y = 0;
+      registry.motions.get_mut(entity).velocity.y = 0;
     }
   }
 }
 
 void CollisionSystem::resolveMassCollision(Entity wall, Entity other) {
-  Motion&   wall_motion  = registry.motions.get(wall);
-  Motion&   other_motion = registry.motions.get(other);
-  Position& wall_pos     = registry.positions.get(wall);
-  Position& other_pos    = registry.positions.get(other);
+  MotionRef        wall_motion  = registry.motions.get_mut(wall);
+  MotionRef        other_motion = registry.motions.get_mut(other);
+  ConstPositionRef wall_pos     = registry.positions.get(wall);
+  ConstPositionRef other_pos    = registry.positions.get(other);
 
   bool is_horizontal_collision = false;
   // Determine if this a horizontal or vertical collision
@@ -1336,9 +1418,9 @@ void CollisionSystem::resolveMassCollision(Entity wall, Entity other) {
 
 void CollisionSystem::resolveDoorPlayerCollision(Entity door, Entity player) {
   if (registry.doorConnections.has(door)) {
-    DoorConnection& doorConnection = registry.doorConnections.get(door);
+    const DoorConnection& doorConnection = registry.doorConnections.get(door);
     DoorConnection& otherDoorConnection =
-        registry.doorConnections.get(doorConnection.exit_door);
+        registry.doorConnections.get_mut(doorConnection.exit_door);
     bool is_boss_room = otherDoorConnection.room_id == "5" ||
                         otherDoorConnection.room_id == "10" ||
                         otherDoorConnection.room_id == "15";
@@ -1359,17 +1441,19 @@ void CollisionSystem::resolveDoorPlayerCollision(Entity door, Entity player) {
     }
   }
 
-  DoorConnection& door_connection = registry.doorConnections.get(door);
-  rt_entity                       = Entity();
-  RoomTransition& roomTransition  = registry.roomTransitions.emplace(rt_entity);
-  roomTransition.door_connection  = door_connection;
+  const DoorConnection& door_connection = registry.doorConnections.get(door);
+  rt_entity                             = Entity();
+  RoomTransition&       roomTransition  =
+      registry.roomTransitions.emplace(rt_entity);
+  roomTransition.door_connection        = door_connection;
 
   room_transitioning = true;
 
   registry.sounds.insert(rt_entity, Sound(SOUND_ASSET_ID::DOOR));
 
-  PlayerProjectile& pp   = registry.playerProjectiles.get(player_projectile);
-  Motion&           pp_m = registry.motions.get(player_projectile);
+  PlayerProjectile& pp   =
+      registry.playerProjectiles.get_mut(player_projectile);
+  MotionRef         pp_m = registry.motions.get_mut(player_projectile);
   pp.is_loaded           = true;
   pp_m.velocity          = {0.f, 0.f};
 }
@@ -21,6 +21,9 @@
 #include "tiny_ecs.hpp"
 #include "tiny_ecs_registry.hpp"
 
+// Player projectiles per job of the projectile collision pass
+#define PROJECTILES_PER_JOB 8
+
 class CollisionSystem {
   private:
   RenderSystem* renderer;
@@ -30,6 +33,7 @@ class CollisionSystem {
   COLLISION END DETECTION
   *********************/
   void handle_collision_end();
+  void handle_pressure_plate_changes();
 
   /********************
   COLLISION DETECTION
@@ -49,6 +53,16 @@ class CollisionSystem {
                                Entity box_bound_entity);
   bool checkPlayerMeshCollision(Entity entity_i, Entity entity_j,
                                 Entity collisionMesh);
+  // The same for many entities: those passing the bounds test are added to
+  // mesh_candidates, then checkPlayerMeshCollisions() runs their mesh tests
+  // in parallel
+  bool checkPlayerBounds(Entity entity_i, Entity entity_j);
+  void checkPlayerMeshCollisions(Entity entity_i, Entity collisionMesh);
+
+  // Scratch space of the parallel detection passes, kept between steps
+  std::vector<std::vector<Entity>> projectile_hits;  // per player projectile
+  std::vector<Entity>              mesh_candidates;
+  std::vector<char>                mesh_hits;  // per candidate, 0 or 1
 
   /********************
   COLLISION RESOLUTION
@@ -85,9 +85,9 @@ bool mesh_collides(Entity mesh, Entity other) {
     return false;
   }
 
-  Position& mesh_pos  = registry.positions.get(mesh);
-  Mesh*     meshPtr   = registry.meshPtrs.get(mesh);
-  Position& other_pos = registry.positions.get(other);
+  ConstPositionRef mesh_pos  = registry.positions.get(mesh);
+  Mesh*            meshPtr   = registry.meshPtrs.get(mesh);
+  ConstPositionRef other_pos = registry.positions.get(other);
 
   vec4 other_bb = get_bounds(other_pos);
 
@@ -96,7 +96,7 @@ Entity createOxygenCanisterPos(RenderSystem* renderer, vec2 position, bool check
   // Reserve an entity
   auto entity = Entity();
 
-  auto& pos    = registry.positions.emplace(entity);
+  auto pos     = registry.positions.emplace(entity);
   pos.angle    = 0.f;
   pos.position = position;
   pos.scale    = OXYGEN_CANISTER_SCALE_FACTOR * OXYGEN_CANISTER_BOUNDING_BOX;
@@ -142,8 +142,8 @@ Entity unlockBossDoors(RenderSystem* renderer, vec2 position,
     if (registry.renderRequests.has(entity) && registry.doorConnections.has(entity) && registry.positions.has(entity)) {
       registry.renderRequests.remove(entity);
 
-      Position&       door_position   = registry.positions.get(entity);
-      DoorConnection& door_connection = registry.doorConnections.get(entity);
+      PositionRef           door_position   = registry.positions.get_mut(entity);
+      const DoorConnection& door_connection = registry.doorConnections.get(entity);
 
       TEXTURE_ASSET_ID texture;
       if (door_connection.direction == Direction::SOUTH || door_connection.direction == Direction::WEST) {
@@ -177,8 +177,8 @@ Entity unlockTutorial(RenderSystem* renderer, vec2 position,
     if (registry.renderRequests.has(entity) && registry.doorConnections.has(entity) && registry.positions.has(entity)) {
       registry.renderRequests.remove(entity);
 
-      Position&       door_position   = registry.positions.get(entity);
-      DoorConnection& door_connection = registry.doorConnections.get(entity);
+      PositionRef           door_position   = registry.positions.get_mut(entity);
+      const DoorConnection& door_connection = registry.doorConnections.get(entity);
 
       TEXTURE_ASSET_ID texture;
       if (door_connection.direction == Direction::SOUTH || door_connection.direction == Direction::WEST) {
@@ -218,7 +218,7 @@ Entity createRedKeyPos(RenderSystem* renderer, vec2 position,
   auto entity = Entity();
 
   float scale_reduction = 0.5f;
-  auto& pos    = registry.positions.emplace(entity);
+  auto pos     = registry.positions.emplace(entity);
   pos.angle    = 0.f;
   pos.position = position;
   pos.scale    = scale_reduction * RED_KEY_SCALE_FACTOR * RED_KEY_BOUNDING_BOX;
@@ -269,7 +269,7 @@ Entity createBlueKeyPos(RenderSystem* renderer, vec2 position, bool checkCollisi
   auto entity = Entity();
 
   float scale_reduction = 0.5f;
-  auto& pos    = registry.positions.emplace(entity);
+  auto pos     = registry.positions.emplace(entity);
   pos.angle    = 0.f;
   pos.position = position;
   pos.scale    = scale_reduction * BLUE_KEY_SCALE_FACTOR * BLUE_KEY_BOUNDING_BOX;
@@ -320,7 +320,7 @@ Entity createYellowKeyPos(RenderSystem* renderer, vec2 position, bool checkColli
   auto entity = Entity();
 
   float scale_reduction = 0.5f;
-  auto& pos    = registry.positions.emplace(entity);
+  auto pos     = registry.positions.emplace(entity);
   pos.angle    = 0.f;
   pos.position = position;
   pos.scale    = scale_reduction * YELLOW_KEY_SCALE_FACTOR * YELLOW_KEY_BOUNDING_BOX;
@@ -376,7 +376,7 @@ Entity createNetDropPos(RenderSystem* renderer, vec2 position,
   // Reserve an entity
   auto entity = Entity();
 
-  auto& pos    = registry.positions.emplace(entity);
+  auto pos     = registry.positions.emplace(entity);
   pos.angle    = 0.f;
   pos.position = position;
   pos.scale    = NET_DROP_SCALE_FACTOR * NET_DROP_BOUNDING_BOX;
@@ -428,7 +428,7 @@ Entity createConcussiveDropPos(RenderSystem* renderer, vec2 position,
   // Reserve an entity
   auto entity = Entity();
 
-  auto& pos    = registry.positions.emplace(entity);
+  auto pos     = registry.positions.emplace(entity);
   pos.angle    = 0.f;
   pos.position = position;
   pos.scale    = CONCUSSIVE_DROP_SCALE_FACTOR * CONCUSSIVE_DROP_BOUNDING_BOX;
@@ -479,7 +479,7 @@ Entity createTorpedoDropPos(RenderSystem* renderer, vec2 position,
   // Reserve an entity
   auto entity = Entity();
 
-  auto& pos    = registry.positions.emplace(entity);
+  auto pos     = registry.positions.emplace(entity);
   pos.angle    = 0.f;
   pos.position = position;
   pos.scale    = TORPEDO_DROP_SCALE_FACTOR * TORPEDO_DROP_BOUNDING_BOX;
@@ -531,7 +531,7 @@ Entity createShrimpDropPos(RenderSystem* renderer, vec2 position,
   // Reserve an entity
   auto entity = Entity();
 
-  auto& pos    = registry.positions.emplace(entity);
+  auto pos     = registry.positions.emplace(entity);
   pos.angle    = 0.f;
   pos.position = position;
   pos.scale    = SHRIMP_DROP_SCALE_FACTOR * SHRIMP_DROP_BOUNDING_BOX;
@@ -23,7 +23,7 @@ bool handle_consumable_collisions(Entity& player, Entity& consumable,
   // TODO: add more affects M2+
   if (registry.weaponDrops.has(consumable)) {
     INVENTORY  type = registry.weaponDrops.get(consumable).type;
-    Inventory& inv  = registry.inventory.get(player);
+    Inventory& inv  = registry.inventory.get_mut(player);
     if (type == INVENTORY::NET) {
       inv.nets++;
       updateInventoryCounter(renderer, INVENTORY::NET);
@@ -139,7 +139,7 @@ void addSharkmanWander() {
   wander.active_dir_cd = SHARKMAN_TRACKING_CD;
   wander.change_dir_cd = SHARKMAN_TRACKING_CD;
 
-  registry.bosses.get(b).is_angry = false;
+  registry.bosses.get_mut(b).is_angry = false;
 
   printf("Sharkman is cooking...\n");
 }
@@ -167,8 +167,8 @@ static void addCthulhuTentacles() {
   if (registry.bosses.entities.size() != 1) {
     return;
   }
-  Entity& b    = registry.bosses.entities[0];
-  Boss&   boss = registry.bosses.get(b);
+  Entity&     b    = registry.bosses.entities[0];
+  const Boss& boss = registry.bosses.get(b);
 
   // it'd be funny if it basically shoots tentacles
   auto& shooter      = registry.shooters.emplace(b);
@@ -185,8 +185,8 @@ static void addCthulhuFireballs() {
   if (registry.bosses.entities.size() != 1) {
     return;
   }
-  Entity& b    = registry.bosses.entities[0];
-  Boss&   boss = registry.bosses.get(b);
+  Entity&     b    = registry.bosses.entities[0];
+  const Boss& boss = registry.bosses.get(b);
 
   auto& shooter      = registry.shooters.emplace(b);
   shooter.type       = RangedEnemies::CTHULHU_FIREBALL;
@@ -202,8 +202,8 @@ static void addCthulhuCanisters() {
   if (registry.bosses.entities.size() != 1) {
     return;
   }
-  Entity& b    = registry.bosses.entities[0];
-  Boss&   boss = registry.bosses.get(b);
+  Entity&     b    = registry.bosses.entities[0];
+  const Boss& boss = registry.bosses.get(b);
 
   auto& shooter      = registry.shooters.emplace(b);
   shooter.type       = RangedEnemies::CTHULHU_CANISTER;
@@ -253,13 +253,13 @@ void addCthulhuRageAI() {
     return;
   }
   Entity& b    = registry.bosses.entities[0];
-  Boss&   boss = registry.bosses.get(b);
+  Boss&   boss = registry.bosses.get_mut(b);
   // heal cthulhu to full, then change ai
-  Oxygen& oxygen = registry.oxygen.get(b);
+  Oxygen& oxygen = registry.oxygen.get_mut(b);
   if (oxygen.level < CTHULHU_HEALTH) {
     if (!boss.is_angry) {
       if (registry.renderRequests.has(b)) {
-        registry.renderRequests.get(b).used_texture =
+        registry.renderRequests.get_mut(b).used_texture =
             TEXTURE_ASSET_ID::CTHULHU_RAGE;
       }
       if (!registry.sounds.has(b)) {
@@ -270,13 +270,13 @@ void addCthulhuRageAI() {
     modifyOxygenAmount(b, CTHULHU_REGEN_AMT);
   } else {
     if (registry.deadlys.has(b)) {
-      registry.deadlys.get(b).type = ENTITY_TYPE::CTHULHU_PHASE2;
+      registry.deadlys.get_mut(b).type = ENTITY_TYPE::CTHULHU_PHASE2;
     }
     oxygen.level       = CTHULHU_HEALTH;
     boss.type          = ENTITY_TYPE::CTHULHU_PHASE2;
     boss.curr_cd       = 0;  // reset cd
     boss.ai_cd         = CTHULHU_AI_CD;
-    boss.ai            = std::vector<std::function<void()>>(
+    boss.ai            = PooledVector<std::function<void()>>(
         {addCthulhuShockwaves, addCthulhuRageProjectiles, addCthulhuTentacles,
               addCthulhuFireballs, addCthulhuCanisters, addCthulhuCanisters});
     if (!registry.musics.has(b)) {
@@ -324,7 +324,7 @@ Entity createCrabBossPos(RenderSystem* renderer, vec2 position,
                          bool checkCollisions) {
   // Reserve an entity
   auto  entity = Entity();
-  auto& pos    = registry.positions.emplace(entity);
+  auto pos     = registry.positions.emplace(entity);
   pos.angle    = 0.f;
   pos.position = position;
   pos.scale    = KRAB_BOSS_SCALE * KRAB_BOSS_BOUNDING_BOX;
@@ -350,7 +350,7 @@ Entity createCrabBossPos(RenderSystem* renderer, vec2 position,
   modifyOxygenCd.default_cd = KRAB_BOSS_ATK_SPD;
 
   // Initialize the position, scale, and physics components
-  auto& motion = registry.motions.emplace(entity);
+  auto motion  = registry.motions.emplace(entity);
   // krab boss starts off moving opposite direction of player
   vec2 direction = pos.position - registry.positions.get(player).position;
   if (direction.x < 0) {
@@ -368,7 +368,7 @@ Entity createCrabBossPos(RenderSystem* renderer, vec2 position,
   addCrabBossWander();
 
   boss.ai_cd = KRAB_BOSS_AI_CD;
-  boss.ai    = std::vector<std::function<void()>>(
+  boss.ai    = PooledVector<std::function<void()>>(
       {addCrabMelee, addCrabMelee, addCrabMelee, addCrabMelee, addCrabMelee,
           addCrabMelee, addCrabMelee, addCrabMelee, addCrabRanged, addCrabRanged,
           addCrabBossWander});
@@ -404,13 +404,13 @@ Entity respawnCrabBoss(RenderSystem* renderer, EntityState es) {
   Entity entity = createCrabBossPos(renderer, es.position.position, false);
 
   // Restore State
-  Position& pos     = registry.positions.get(entity);
+  PositionRef pos   = registry.positions.get_mut(entity);
   pos.angle         = es.position.angle;
   pos.scale         = es.position.scale;
   pos.originalScale = es.position.originalScale;
 
-  Oxygen& o    = registry.oxygen.get(entity);
-  float   diff = es.oxygen - o.level;
+  const Oxygen& o    = registry.oxygen.get(entity);
+  float         diff = es.oxygen - o.level;
 
   // This will also update the health bar
   if (diff < 0) {
@@ -424,7 +424,7 @@ Entity createSharkmanPos(RenderSystem* renderer, vec2 position,
                          bool checkCollisions) {
   // Reserve an entity
   auto  entity = Entity();
-  auto& pos    = registry.positions.emplace(entity);
+  auto pos     = registry.positions.emplace(entity);
   pos.angle    = 0.f;
   pos.position = position;
   pos.scale    = SHARKMAN_SCALE * SHARKMAN_BOUNDING_BOX;
@@ -444,7 +444,7 @@ Entity createSharkmanPos(RenderSystem* renderer, vec2 position,
   modifyOxygenCd.default_cd = SHARKMAN_ATK_SPD;
 
   // Initialize the position, scale, and physics components
-  auto& motion = registry.motions.emplace(entity);
+  auto motion  = registry.motions.emplace(entity);
   // sharkman starts off running opposite direction of player
   vec2 direction = pos.position - registry.positions.get(player).position;
   if (direction.x < 0) {
@@ -463,7 +463,7 @@ Entity createSharkmanPos(RenderSystem* renderer, vec2 position,
 
   boss.ai_cd   = SHARKMAN_AI_CD;
   boss.curr_cd = SHARKMAN_AI_CD;
-  boss.ai      = std::vector<std::function<void()>>(
+  boss.ai      = PooledVector<std::function<void()>>(
       {addSharkmanTarget, addSharkmanWander});
 
   registry.renderRequests.insert(
@@ -497,13 +497,13 @@ Entity respawnSharkman(RenderSystem* renderer, EntityState es) {
   Entity entity = createSharkmanPos(renderer, es.position.position, false);
 
   // Restore State
-  Position& pos     = registry.positions.get(entity);
+  PositionRef pos   = registry.positions.get_mut(entity);
   pos.angle         = es.position.angle;
   pos.scale         = es.position.scale;
   pos.originalScale = es.position.originalScale;
 
-  Oxygen& o    = registry.oxygen.get(entity);
-  float   diff = es.oxygen - o.level;
+  const Oxygen& o    = registry.oxygen.get(entity);
+  float         diff = es.oxygen - o.level;
 
   // This will also update the health bar
   if (diff < 0) {
@@ -517,7 +517,7 @@ Entity createCthulhuPos(RenderSystem* renderer, vec2 position,
                         bool checkCollisions) {
   // Reserve an entity
   auto  entity = Entity();
-  auto& pos    = registry.positions.emplace(entity);
+  auto pos     = registry.positions.emplace(entity);
   pos.angle    = 0.f;
   pos.position = room_center;
   pos.scale    = CTHULHU_SCALE * CTHULHU_BOUNDING_BOX;
@@ -543,7 +543,7 @@ Entity createCthulhuPos(RenderSystem* renderer, vec2 position,
 
   boss.ai_cd   = CTHULHU_AI_CD;
   boss.curr_cd = CTHULHU_AI_CD;
-  boss.ai      = std::vector<std::function<void()>>(
+  boss.ai      = PooledVector<std::function<void()>>(
       {addCthulhuCanisters, addCthulhuTentacles, addCthulhuFireballs});
 
   registry.renderRequests.insert(
@@ -560,13 +560,13 @@ Entity respawnCthulhu(RenderSystem* renderer, EntityState es) {
   Entity entity = createCthulhuPos(renderer, es.position.position, false);
 
   // Restore State
-  Position& pos     = registry.positions.get(entity);
+  PositionRef pos   = registry.positions.get_mut(entity);
   pos.angle         = es.position.angle;
   pos.scale         = es.position.scale;
   pos.originalScale = es.position.originalScale;
 
-  Oxygen& o    = registry.oxygen.get(entity);
-  float   diff = es.oxygen - o.level;
+  const Oxygen& o    = registry.oxygen.get(entity);
+  float         diff = es.oxygen - o.level;
 
   // This will also update the health bar
   if (diff < 0) {
@@ -580,12 +580,12 @@ Entity respawnCthulhuPhase2(RenderSystem* renderer, EntityState es) {
   Entity entity = respawnCthulhu(renderer, es);
 
   // Restore State
-  Deadly& d  = registry.deadlys.get(entity);
+  Deadly& d  = registry.deadlys.get_mut(entity);
   d.type     = ENTITY_TYPE::CTHULHU_PHASE2;
-  Boss& boss = registry.bosses.get(entity);
+  Boss& boss = registry.bosses.get_mut(entity);
   boss.type  = ENTITY_TYPE::CTHULHU_PHASE2;
 
-  registry.renderRequests.get(entity).used_texture =
+  registry.renderRequests.get_mut(entity).used_texture =
       TEXTURE_ASSET_ID::CTHULHU_RAGE;
 
   if (!registry.musics.has(entity)) {
@@ -595,7 +595,7 @@ Entity respawnCthulhuPhase2(RenderSystem* renderer, EntityState es) {
   boss.is_angry = true;
   boss.curr_cd  = 0;  // reset cd
   boss.ai_cd    = CTHULHU_AI_CD;
-  boss.ai       = std::vector<std::function<void()>>(
+  boss.ai       = PooledVector<std::function<void()>>(
       {addCthulhuShockwaves, addCthulhuRageProjectiles, addCthulhuTentacles,
              addCthulhuFireballs, addCthulhuCanisters, addCthulhuCanisters});
 
@@ -606,13 +606,13 @@ Entity respawnCthulhuTrans(RenderSystem* renderer, EntityState es) {
   Entity entity = respawnCthulhu(renderer, es);
 
   // Restore State
-  Deadly& d  = registry.deadlys.get(entity);
+  Deadly& d  = registry.deadlys.get_mut(entity);
   d.type     = ENTITY_TYPE::CTHULHU_TRANS;
-  Boss& boss = registry.bosses.get(entity);
+  Boss& boss = registry.bosses.get_mut(entity);
   boss.type  = ENTITY_TYPE::CTHULHU_TRANS;
 
   // hack, bros ai is healing
-  registry.renderRequests.get(entity).used_texture =
+  registry.renderRequests.get_mut(entity).used_texture =
       TEXTURE_ASSET_ID::CTHULHU_RAGE;
   
   if (!registry.musics.has(entity)) {
@@ -622,7 +622,7 @@ Entity respawnCthulhuTrans(RenderSystem* renderer, EntityState es) {
   boss.is_angry      = true; // no need to replay audio
   boss.curr_cd       = 0;
   boss.ai_cd         = CTHULHU_REGEN_RATE;
-  boss.ai            = std::vector<std::function<void()>>({addCthulhuRageAI});
+  boss.ai            = PooledVector<std::function<void()>>({addCthulhuRageAI});
 
   return entity;
 }
@@ -631,7 +631,7 @@ Entity createTentaclePos(RenderSystem* renderer, vec2 position,
                          bool checkCollisions) {
   // Reserve an entity
   auto  entity = Entity();
-  auto& pos    = registry.positions.emplace(entity);
+  auto pos     = registry.positions.emplace(entity);
   pos.angle    = 0.f;
   pos.position = position;
   pos.scale    = TENTACLE_SCALE * TENTACLE_BOUNDING_BOX;
@@ -660,7 +660,7 @@ Entity createTentaclePos(RenderSystem* renderer, vec2 position,
   stun.duration = TENTACLE_STUN_MS;
 
   // Initialize the position, scale, and physics components
-  auto& motion    = registry.motions.emplace(entity);
+  auto motion     = registry.motions.emplace(entity);
   motion.velocity = {TENTACLE_MS, 0};
 
   // ai
@@ -688,13 +688,13 @@ Entity respawnTentacle(RenderSystem* renderer, EntityState es) {
   Entity entity = createTentaclePos(renderer, es.position.position, false);
 
   // Restore State
-  Position& pos     = registry.positions.get(entity);
+  PositionRef pos   = registry.positions.get_mut(entity);
   pos.angle         = es.position.angle;
   pos.scale         = es.position.scale;
   pos.originalScale = es.position.originalScale;
 
-  Oxygen& o    = registry.oxygen.get(entity);
-  float   diff = es.oxygen - o.level;
+  const Oxygen& o    = registry.oxygen.get(entity);
+  float         diff = es.oxygen - o.level;
 
   // This will also update the health bar
   if (diff < 0) {
@@ -712,12 +712,12 @@ Entity shootShockwave(RenderSystem* renderer, vec2 pos) {
   registry.meshPtrs.emplace(entity, &mesh);
 
   // Setting initial position values
-  Position& position = registry.positions.emplace(entity);
-  position.position  = pos;
-  position.scale     = 0.01f * SHOCKWAVE_BOUNDING_BOX;
+  PositionRef position = registry.positions.emplace(entity);
+  position.position    = pos;
+  position.scale       = 0.01f * SHOCKWAVE_BOUNDING_BOX;
 
   // this is here just so physics_system can see it in step
-  Motion& motion = registry.motions.emplace(entity);
+  registry.motions.emplace(entity);
 
   OxygenModifier& oxyCost = registry.oxygenModifiers.emplace(entity);
   oxyCost.amount          = SHOCKWAVE_DAMAGE;
@@ -743,15 +743,15 @@ Entity shootFireball(RenderSystem* renderer, vec2 pos, vec2 direction) {
   registry.meshPtrs.emplace(entity, &mesh);
 
   // Setting initial position values
-  float     angle    = atan2(direction.y, direction.x);
-  Position& position = registry.positions.emplace(entity);
-  position.position  = pos;
-  position.scale     = FIREBALL_SCALE * FIREBALL_BOUNDING_BOX;
-  position.angle     = angle;
+  float       angle    = atan2(direction.y, direction.x);
+  PositionRef position = registry.positions.emplace(entity);
+  position.position    = pos;
+  position.scale       = FIREBALL_SCALE * FIREBALL_BOUNDING_BOX;
+  position.angle = angle;
 
   // Setting initial motion values
-  Motion& motion  = registry.motions.emplace(entity);
-  motion.velocity = {cos(angle) * FIREBALL_MS, sin(angle) * FIREBALL_MS};
+  MotionRef motion = registry.motions.emplace(entity);
+  motion.velocity  = {cos(angle) * FIREBALL_MS, sin(angle) * FIREBALL_MS};
 
   OxygenModifier& oxyCost = registry.oxygenModifiers.emplace(entity);
   oxyCost.amount          = FIREBALL_DAMAGE;
@@ -778,15 +778,15 @@ Entity shootCanister(RenderSystem* renderer, vec2 pos, vec2 direction,
   registry.meshPtrs.emplace(entity, &mesh);
 
   // Setting initial position values
-  float     angle    = atan2(direction.y, direction.x);
-  Position& position = registry.positions.emplace(entity);
-  position.position  = pos;
+  float       angle    = atan2(direction.y, direction.x);
+  PositionRef position = registry.positions.emplace(entity);
+  position.position    = pos;
   position.scale = OXYGEN_CANISTER_SCALE_FACTOR * OXYGEN_CANISTER_BOUNDING_BOX;
   position.angle = angle;
 
   // Setting initial motion values
-  Motion& motion  = registry.motions.emplace(entity);
-  motion.velocity = {cos(angle), sin(angle)};
+  MotionRef motion = registry.motions.emplace(entity);
+  motion.velocity  = {cos(angle), sin(angle)};
   motion.velocity *= is_angry ? CTHULHU_RAGE_CANISTER_MS : CTHULHU_CANISTER_MS;
 
   OxygenModifier& oxyCost = registry.oxygenModifiers.emplace(entity);
@@ -817,14 +817,15 @@ Entity shootRageProjectile(RenderSystem* renderer, vec2 pos, float angle) {
   registry.meshPtrs.emplace(entity, &mesh);
 
   // Setting initial position values
-  Position& position = registry.positions.emplace(entity);
-  position.position  = pos;
-  position.scale     = CTHULHU_RAGE_PROJ_SCALE * CTHULHU_RAGE_PROJ_BOUNDING_BOX;
-  position.angle     = angle;
+  PositionRef position = registry.positions.emplace(entity);
+  position.position    = pos;
+  position.scale =
+      CTHULHU_RAGE_PROJ_SCALE * CTHULHU_RAGE_PROJ_BOUNDING_BOX;
+  position.angle = angle;
 
   // Setting initial motion values
-  Motion& motion  = registry.motions.emplace(entity);
-  motion.velocity = {cos(angle) * CTHULHU_RAGE_PROJ_MS,
+  MotionRef motion = registry.motions.emplace(entity);
+  motion.velocity  = {cos(angle) * CTHULHU_RAGE_PROJ_MS,
                      sin(angle) * CTHULHU_RAGE_PROJ_MS};
 
   OxygenModifier& oxyCost = registry.oxygenModifiers.emplace(entity);
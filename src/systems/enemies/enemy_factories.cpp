@@ -160,13 +160,13 @@ Entity respawnJelly(RenderSystem* renderer, EntityState es) {
   Entity entity = createJellyPos(renderer, es.position.position, false);
 
   // Restore State
-  Position& pos     = registry.positions.get(entity);
+  PositionRef pos   = registry.positions.get_mut(entity);
   pos.angle         = es.position.angle;
   pos.scale         = es.position.scale;
   pos.originalScale = es.position.originalScale;
 
-  Oxygen& o    = registry.oxygen.get(entity);
-  float   diff = es.oxygen - o.level;
+  const Oxygen& o    = registry.oxygen.get(entity);
+  float         diff = es.oxygen - o.level;
 
   // This will also update the health bar
   if (diff < 0) {
@@ -222,7 +222,7 @@ Entity createFishPos(RenderSystem* renderer, vec2 position,
   modifyOxygenCd.default_cd = FISH_ATK_SPD;
 
   // Initialize the position, scale, and physics components
-  auto& motion        = registry.motions.emplace(entity);
+  auto motion         = registry.motions.emplace(entity);
   motion.velocity     = {-FISH_MS, 0};
   motion.acceleration = {0, 0};
 
@@ -256,13 +256,13 @@ Entity respawnFish(RenderSystem* renderer, EntityState es) {
   Entity entity = createFishPos(renderer, es.position.position, false);
 
   // Restore State
-  Position& pos     = registry.positions.get(entity);
+  PositionRef pos   = registry.positions.get_mut(entity);
   pos.angle         = es.position.angle;
   pos.scale         = es.position.scale;
   pos.originalScale = es.position.originalScale;
 
-  Oxygen& o    = registry.oxygen.get(entity);
-  float   diff = es.oxygen - o.level;
+  const Oxygen& o    = registry.oxygen.get(entity);
+  float         diff = es.oxygen - o.level;
 
   // This will also update the health bar
   if (diff < 0) {
@@ -316,7 +316,7 @@ Entity createSharkPos(RenderSystem* renderer, vec2 position,
   modifyOxygenCd.default_cd = SHARK_ATK_SPD;
 
   // Initialize the position, scale, and physics components
-  auto& motion        = registry.motions.emplace(entity);
+  auto motion         = registry.motions.emplace(entity);
   motion.velocity     = {-SHARK_MS, 0};
   motion.acceleration = {0, 0};
 
@@ -357,13 +357,13 @@ Entity respawnShark(RenderSystem* renderer, EntityState es) {
   Entity entity = createSharkPos(renderer, es.position.position, false);
 
   // Restore State
-  Position& pos     = registry.positions.get(entity);
+  PositionRef pos   = registry.positions.get_mut(entity);
   pos.angle         = es.position.angle;
   pos.scale         = es.position.scale;
   pos.originalScale = es.position.originalScale;
 
-  Oxygen& o    = registry.oxygen.get(entity);
-  float   diff = es.oxygen - o.level;
+  const Oxygen& o    = registry.oxygen.get(entity);
+  float         diff = es.oxygen - o.level;
 
   // This will also update the health bar
   if (diff < 0) {
@@ -418,7 +418,7 @@ Entity createTurtlePos(RenderSystem* renderer, vec2 position,
   modifyOxygenCd.default_cd = TURTLE_ATK_SPD;
 
   // Initialize the position, scale, and physics components
-  auto& motion        = registry.motions.emplace(entity);
+  auto motion         = registry.motions.emplace(entity);
   motion.velocity     = {-TURTLE_MS, 0};
   motion.acceleration = {0, 0};
 
@@ -464,13 +464,13 @@ Entity respawnTurtle(RenderSystem* renderer, EntityState es) {
   Entity entity = createTurtlePos(renderer, es.position.position, false);
 
   // Restore State
-  Position& pos     = registry.positions.get(entity);
+  PositionRef pos   = registry.positions.get_mut(entity);
   pos.angle         = es.position.angle;
   pos.scale         = es.position.scale;
   pos.originalScale = es.position.originalScale;
 
-  Oxygen& o    = registry.oxygen.get(entity);
-  float   diff = es.oxygen - o.level;
+  const Oxygen& o    = registry.oxygen.get(entity);
+  float         diff = es.oxygen - o.level;
 
   // This will also update the health bar
   if (diff < 0) {
@@ -524,7 +524,7 @@ Entity createKrabPos(RenderSystem* renderer, vec2 position,
   modifyOxygenCd.default_cd = KRAB_ATK_SPD;
 
   // Initialize the position, scale, and physics components
-  auto& motion        = registry.motions.emplace(entity);
+  auto motion         = registry.motions.emplace(entity);
   motion.velocity     = {-KRAB_MS, 0};
   motion.acceleration = {0, 0};
 
@@ -573,13 +573,13 @@ Entity respawnKrab(RenderSystem* renderer, EntityState es) {
   Entity entity = createKrabPos(renderer, es.position.position, false);
 
   // Restore State
-  Position& pos     = registry.positions.get(entity);
+  PositionRef pos   = registry.positions.get_mut(entity);
   pos.angle         = es.position.angle;
   pos.scale         = es.position.scale;
   pos.originalScale = es.position.originalScale;
 
-  Oxygen& o    = registry.oxygen.get(entity);
-  float   diff = es.oxygen - o.level;
+  const Oxygen& o    = registry.oxygen.get(entity);
+  float         diff = es.oxygen - o.level;
 
   // This will also update the health bar
   if (diff < 0) {
@@ -627,7 +627,7 @@ Entity createUrchinPos(RenderSystem* renderer, vec2 position,
   d.type    = ENTITY_TYPE::URCHIN;
 
   // Initialize the position, scale, and physics components
-  auto& motion        = registry.motions.emplace(entity);
+  auto motion         = registry.motions.emplace(entity);
   motion.velocity     = {-URCHIN_MS, 0};
   motion.acceleration = {0, 0};
 
@@ -667,13 +667,13 @@ Entity respawnUrchin(RenderSystem* renderer, EntityState es) {
   Entity entity = createUrchinPos(renderer, es.position.position, false);
 
   // Restore State
-  Position& pos     = registry.positions.get(entity);
+  PositionRef pos   = registry.positions.get_mut(entity);
   pos.angle         = es.position.angle;
   pos.scale         = es.position.scale;
   pos.originalScale = es.position.originalScale;
 
-  Oxygen& o    = registry.oxygen.get(entity);
-  float   diff = es.oxygen - o.level;
+  const Oxygen& o    = registry.oxygen.get(entity);
+  float         diff = es.oxygen - o.level;
 
   // This will also update the health bar
   if (diff < 0) {
@@ -691,14 +691,15 @@ Entity launchUrchinNeedle(RenderSystem* renderer, vec2 pos, float angle) {
   registry.meshPtrs.emplace(entity, &mesh);
 
   // Setting initial position values
-  Position& position = registry.positions.emplace(entity);
-  position.position  = pos;
-  position.scale     = URCHIN_NEEDLE_SCALE_FACTOR * URCHIN_NEEDLE_BOUNDING_BOX;
-  position.angle     = angle;
+  PositionRef position = registry.positions.emplace(entity);
+  position.position    = pos;
+  position.scale =
+      URCHIN_NEEDLE_SCALE_FACTOR * URCHIN_NEEDLE_BOUNDING_BOX;
+  position.angle = angle;
 
   // Setting initial motion values
-  Motion& motion  = registry.motions.emplace(entity);
-  motion.velocity = {cos(angle) * URCHIN_NEEDLE_MS,
+  MotionRef motion = registry.motions.emplace(entity);
+  motion.velocity  = {cos(angle) * URCHIN_NEEDLE_MS,
                      sin(angle) * URCHIN_NEEDLE_MS};
 
   OxygenModifier& oxyCost = registry.oxygenModifiers.emplace(entity);
@@ -755,7 +756,7 @@ Entity createSeahorsePos(RenderSystem* renderer, vec2 position,
   d.type    = ENTITY_TYPE::SEAHORSE;
 
   // Initialize the position, scale, and physics components
-  auto& motion        = registry.motions.emplace(entity);
+  auto motion         = registry.motions.emplace(entity);
   motion.velocity     = {-SEAHORSE_MS, 0};
   motion.acceleration = {0, 0};
 
@@ -796,13 +797,13 @@ Entity respawnSeahorse(RenderSystem* renderer, EntityState es) {
   Entity entity = createSeahorsePos(renderer, es.position.position, false);
 
   // Restore State
-  Position& pos     = registry.positions.get(entity);
+  PositionRef pos   = registry.positions.get_mut(entity);
   pos.angle         = es.position.angle;
   pos.scale         = es.position.scale;
   pos.originalScale = es.position.originalScale;
 
-  Oxygen& o    = registry.oxygen.get(entity);
-  float   diff = es.oxygen - o.level;
+  const Oxygen& o    = registry.oxygen.get(entity);
+  float         diff = es.oxygen - o.level;
 
   // This will also update the health bar
   if (diff < 0) {
@@ -820,15 +821,15 @@ Entity fireSeahorseBullet(RenderSystem* renderer, vec2 pos, vec2 direction) {
   registry.meshPtrs.emplace(entity, &mesh);
 
   // Setting initial position values
-  float     angle    = atan2(direction.y, direction.x);
-  Position& position = registry.positions.emplace(entity);
-  position.position  = pos;
+  float       angle    = atan2(direction.y, direction.x);
+  PositionRef position = registry.positions.emplace(entity);
+  position.position    = pos;
   position.scale = SEAHORSE_BULLET_SCALE_FACTOR * SEAHORSE_BULLET_BOUNDING_BOX;
   position.angle = angle;
 
   // Setting initial motion values
-  Motion& motion  = registry.motions.emplace(entity);
-  motion.velocity = {cos(angle) * SEAHORSE_BULLET_MS,
+  MotionRef motion = registry.motions.emplace(entity);
+  motion.velocity  = {cos(angle) * SEAHORSE_BULLET_MS,
                      sin(angle) * SEAHORSE_BULLET_MS};
 
   OxygenModifier& oxyCost = registry.oxygenModifiers.emplace(entity);
@@ -864,7 +865,7 @@ Entity createLobsterPos(RenderSystem* renderer, vec2 position,
   auto entity               = Entity();
   vec2 LOBSTER_SCALE_FACTOR = vec2(LOBSTER_SCALE);
 
-  auto& pos    = registry.positions.emplace(entity);
+  auto pos     = registry.positions.emplace(entity);
   pos.angle    = 0.f;
   pos.position = position;
   pos.scale    = LOBSTER_SCALE_FACTOR * LOBSTER_BOUNDING_BOX;
@@ -894,7 +895,7 @@ Entity createLobsterPos(RenderSystem* renderer, vec2 position,
   modifyOxygenCd.default_cd = LOBSTER_ATK_SPD;
 
   // Initialize the position, scale, and physics components
-  auto& motion        = registry.motions.emplace(entity);
+  auto motion         = registry.motions.emplace(entity);
   motion.velocity     = {-LOBSTER_MS, 0};
   motion.acceleration = {0, 0};
 
@@ -937,13 +938,13 @@ Entity respawnLobster(RenderSystem* renderer, EntityState es) {
   Entity entity = createLobsterPos(renderer, es.position.position, false);
 
   // Restore State
-  Position& pos     = registry.positions.get(entity);
+  PositionRef pos   = registry.positions.get_mut(entity);
   pos.angle         = es.position.angle;
   pos.scale         = es.position.scale;
   pos.originalScale = es.position.originalScale;
 
-  Oxygen& o    = registry.oxygen.get(entity);
-  float   diff = es.oxygen - o.level;
+  const Oxygen& o    = registry.oxygen.get(entity);
+  float         diff = es.oxygen - o.level;
 
   // This will also update the health bar
   if (diff < 0) {
@@ -987,7 +988,7 @@ Entity createSirenPos(RenderSystem* renderer, vec2 position,
   d.type    = ENTITY_TYPE::SIREN;
 
   // Initialize the position, scale, and physics components
-  auto& motion        = registry.motions.emplace(entity);
+  auto motion         = registry.motions.emplace(entity);
   motion.velocity     = {-SIREN_MS, 0};
   motion.acceleration = {0, 0};
 
@@ -1027,13 +1028,13 @@ Entity respawnSiren(RenderSystem* renderer, EntityState es) {
   Entity entity = createSirenPos(renderer, es.position.position, false);
 
   // Restore State
-  Position& pos     = registry.positions.get(entity);
+  PositionRef pos   = registry.positions.get_mut(entity);
   pos.angle         = es.position.angle;
   pos.scale         = es.position.scale;
   pos.originalScale = es.position.originalScale;
 
-  Oxygen& o    = registry.oxygen.get(entity);
-  float   diff = es.oxygen - o.level;
+  const Oxygen& o    = registry.oxygen.get(entity);
+  float         diff = es.oxygen - o.level;
 
   // This will also update the health bar
   if (diff < 0) {
@@ -1051,15 +1052,15 @@ Entity fireSirenHeal(RenderSystem* renderer, Entity& user, vec2 pos, vec2 direct
   registry.meshPtrs.emplace(entity, &mesh);
 
   // Setting initial position values
-  float     angle    = atan2(direction.y, direction.x);
-  Position& position = registry.positions.emplace(entity);
-  position.position  = pos;
-  position.scale     = SIREN_HEAL_SCALE_FACTOR * SIREN_HEAL_BOUNDING_BOX;
-  position.angle     = angle;
+  float       angle    = atan2(direction.y, direction.x);
+  PositionRef position = registry.positions.emplace(entity);
+  position.position    = pos;
+  position.scale       = SIREN_HEAL_SCALE_FACTOR * SIREN_HEAL_BOUNDING_BOX;
+  position.angle = angle;
 
   // Setting initial motion values
-  Motion& motion  = registry.motions.emplace(entity);
-  motion.velocity = {cos(angle) * SIREN_HEAL_MS, sin(angle) * SIREN_HEAL_MS};
+  MotionRef motion = registry.motions.emplace(entity);
+  motion.velocity  = {cos(angle) * SIREN_HEAL_MS, sin(angle) * SIREN_HEAL_MS};
 
   OxygenModifier& oxyCost = registry.oxygenModifiers.emplace(entity);
   oxyCost.amount          = SIREN_HEAL_AMOUNT;
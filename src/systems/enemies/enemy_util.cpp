@@ -5,6 +5,7 @@
 
 #include "components.hpp"
 #include "enemy.hpp"
+#include "hierarchy.hpp"
 #include "misc.hpp"
 #include "oxygen.hpp"
 #include "render_system.hpp"
@@ -17,10 +18,10 @@
  */
 bool update_attack(float elapsed_time_ms) {
   for (Entity& e : registry.modifyOxygenCd.entities) {
-    ModifyOxygenCD& attackCd = registry.modifyOxygenCd.get(e);
-    if (attackCd.curr_cd == 0.f) {
+    if (registry.modifyOxygenCd.get(e).curr_cd == 0.f) {
       continue;
     }
+    ModifyOxygenCD& attackCd = registry.modifyOxygenCd.get_mut(e);
     attackCd.curr_cd         = max(attackCd.curr_cd - elapsed_time_ms, 0.f);
   }
 
@@ -33,7 +34,7 @@ void createEmote(RenderSystem* renderer, Entity& e, EMOTE emote) {
   }
 
   if (registry.emoting.has(e)) {
-    Emoting& temp = registry.emoting.get(e);
+    const Emoting& temp = registry.emoting.get(e);
     registry.remove_all_components_of(temp.child);
     registry.emoting.remove(e);
     // printf("Removing Emote!\n");
@@ -45,7 +46,7 @@ void createEmote(RenderSystem* renderer, Entity& e, EMOTE emote) {
 
   // printf("Creating Emote!\n");
 
-  Position&        entityPos  = registry.positions.get(e);
+  ConstPositionRef entityPos  = registry.positions.get(e);
   Emoting&         curr_emote = registry.emoting.emplace(e);
   Entity           child      = Entity();
   TEXTURE_ASSET_ID emote_texture;
@@ -60,7 +61,7 @@ void createEmote(RenderSystem* renderer, Entity& e, EMOTE emote) {
       break;
   }
 
-  Position& position = registry.positions.emplace(child);
+  PositionRef position = registry.positions.emplace(child);
   // Setting initial positon values
   position.position =
       entityPos.position -
@@ -70,23 +71,15 @@ void createEmote(RenderSystem* renderer, Entity& e, EMOTE emote) {
   position.scale         = EMOTE_SCALE_FACTOR * EMOTE_BOUNDING_BOX;
   position.originalScale = EMOTE_SCALE_FACTOR * EMOTE_BOUNDING_BOX;
 
+  // The emote floats above the entity, following it around
+  LocalTransform local;
+  local.anchor = {0.f, -0.5f};
+  local.offset = {0.f, -(EMOTE_POS)};
+  attachToParent(child, e, local);
+
   Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
   registry.meshPtrs.emplace(child, &mesh);
   registry.renderRequests.insert(
       child,
       {emote_texture, EFFECT_ASSET_ID::TEXTURED, GEOMETRY_BUFFER_ID::SPRITE});
 }
-
-/**
- * @brief update the position values of an entity's health bar depending on
- * entity position
- */
-void updateEmotePos(Entity& enemy) {
-  Position& enemyPos = registry.positions.get(enemy);
-  Emoting&  emote =
-      registry.emoting.get(enemy);
-
-  Position& emotePos = registry.positions.get(emote.child);
-  emotePos.position =
-      enemyPos.position - vec2(0.f, enemyPos.scale.y / 2 + EMOTE_POS);
-}
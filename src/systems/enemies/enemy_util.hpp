@@ -19,4 +19,3 @@ bool update_attack(float elapsed_time_ms);
 #define EMOTE_SCALE_FACTOR vec2(3.f)
 #define EMOTE_BOUNDING_BOX vec2(10.f, 10.f)
 void createEmote(RenderSystem *renderer, Entity &e, EMOTE emote);
-void updateEmotePos(Entity& enemy);
@@ -1,22 +1,25 @@
 #include "damage.hpp"
 
 #include "debuff.hpp"
+#include "ecs_command_buffer.hpp"
 #include "tiny_ecs_registry.hpp"
 
 /**
- * @brief Updates all attacked timers
+ * @brief Updates all attacked timers, expired ones are removed through
+ * commands
  *
  * @return true if successful
  */
-bool update_collision_timers(float elapsed_ms_since_last_update) {
+bool update_collision_timers(float             elapsed_ms_since_last_update,
+                             ECSCommandBuffer& commands) {
   for (Entity entity : registry.attacked.entities) {
     // progress timer
-    Attacked& timer = registry.attacked.get(entity);
+    Attacked& timer = registry.attacked.get_mut(entity);
     timer.timer -= elapsed_ms_since_last_update;
 
     // remove if no longer stunned
     if (timer.timer < 0) {
-      registry.attacked.remove(entity);
+      commands.remove<Attacked>(entity);
     }
   }
   return true;
@@ -27,7 +30,7 @@ void addDamageIndicatorTimer(Entity entity) {
     Attacked& attacked = registry.attacked.emplace(entity);
     attacked.timer     = DEFAULT_COLLISION_INDICATOR_TIMER;
   } else {
-    Attacked& attacked = registry.attacked.get(entity);
+    Attacked& attacked = registry.attacked.get_mut(entity);
     attacked.timer     = DEFAULT_COLLISION_INDICATOR_TIMER;
   }
 }
\ No newline at end of file
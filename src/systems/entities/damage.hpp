@@ -1,13 +1,16 @@
+#include "ecs_command_buffer.hpp"
 #include "tiny_ecs_registry.hpp"
 
 #define DEFAULT_COLLISION_INDICATOR_TIMER 300.f
 
 /**
- * @brief Updates all attacked timers
+ * @brief Updates all attacked timers, expired ones are removed through
+ * commands
  *
  * @return true if successful
  */
-bool update_collision_timers(float elapsed_ms_since_last_update);
+bool update_collision_timers(float             elapsed_ms_since_last_update,
+                             ECSCommandBuffer& commands);
 
 // adds entity to timer if it isn't already in it
 void addDamageIndicatorTimer(Entity entity);
\ No newline at end of file
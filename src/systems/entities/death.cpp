@@ -6,7 +6,7 @@
 bool update_death(float elapsed_ms_since_last_update) {
   for (Entity entity : registry.deathTimers.entities) {
     // progress timer
-    DeathTimer& counter = registry.deathTimers.get(entity);
+    DeathTimer& counter = registry.deathTimers.get_mut(entity);
     counter.counter_ms -= elapsed_ms_since_last_update;
 
     // restart the game once the death timer expired
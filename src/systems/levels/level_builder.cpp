@@ -94,8 +94,8 @@ void LevelBuilder::connect(Direction direction, EditorID r_id, EditorID d1_id,
     }
   } else {
     if (registry.doorConnections.has(door_1) && registry.doorConnections.has(door_2)) {
-      DoorConnection& door_connection1 = registry.doorConnections.get(door_1);
-      DoorConnection& door_connection2 = registry.doorConnections.get(door_2);
+      DoorConnection& door_connection1 = registry.doorConnections.get_mut(door_1);
+      DoorConnection& door_connection2 = registry.doorConnections.get_mut(door_2);
       door_connection1.objective = door_connection2.objective;
       door_connection2.objective = door_connection1.objective;
     }
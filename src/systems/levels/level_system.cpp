@@ -7,9 +7,11 @@
 #include <numeric>
 #include <player_hud.hpp>
 #include <string>
+#include <unordered_set>
 
 #include "common.hpp"
 #include "enemy_factories.hpp"
+#include "hierarchy.hpp"
 #include "level_factories.hpp"
 #include "level_spawn.hpp"
 #include "map_factories.hpp"
@@ -50,7 +52,7 @@ void LevelSystem::activate_walls() {
   RoomBuilder& current_room =
       level->get_room_by_editor_id(current_room_editor_id);
 
-  for (Entity& wall : registry.spaces.get(current_room.entity).walls) {
+  for (Entity wall : registry.spaces.get(current_room.entity).walls) {
     registry.activeWalls.emplace(wall);
     registry.renderRequests.insert(
         wall, {TEXTURE_ASSET_ID::WALL, EFFECT_ASSET_ID::TEXTURED,
@@ -90,7 +92,7 @@ void LevelSystem::assign_door_sprite(Entity& door, DoorConnection& door_connecti
   RoomBuilder& current_room =
       level->get_room_by_editor_id(current_room_editor_id);
   Direction       direction       = door_connection.direction;
-  Position&       door_position   = registry.positions.get(door);
+  PositionRef     door_position   = registry.positions.get_mut(door);
 
   TEXTURE_ASSET_ID texture;
   if (direction == Direction::SOUTH || direction == Direction::WEST) {
@@ -176,9 +178,9 @@ void LevelSystem::activate_doors() {
       level->get_room_by_editor_id(current_room_editor_id);
 
   // Activate the doors.
-  for (Entity& door : registry.spaces.get(current_room.entity).doors) {
+  for (Entity door : registry.spaces.get(current_room.entity).doors) {
     registry.activeDoors.emplace(door);
-    DoorConnection& door_connection = registry.doorConnections.get(door);
+    DoorConnection& door_connection = registry.doorConnections.get_mut(door);
 
     recalculate_current_room_locks(door, door_connection);
     assign_door_sprite(door, door_connection);
@@ -189,10 +191,10 @@ void LevelSystem::activate_floor() {
   RoomBuilder& current_room =
       level->get_room_by_editor_id(current_room_editor_id);
 
-  Entity    floor     = Entity();
-  Position& floor_pos = registry.positions.emplace(floor);
-  floor_pos.position  = {window_width_px / 2, window_height_px / 2};
-  floor_pos.scale     = {window_width_px, window_height_px};
+  Entity      floor     = Entity();
+  PositionRef floor_pos = registry.positions.emplace(floor);
+  floor_pos.position    = {window_width_px / 2, window_height_px / 2};
+  floor_pos.scale       = {window_width_px, window_height_px};
 
   registry.floors.emplace(floor);
 
@@ -220,99 +222,48 @@ void LevelSystem::deactivate_current_room(bool save) {
   // clear, may have entities from a restart
   level->get_room_by_editor_id(current_room_editor_id).saved_entities.clear();
 
-  for (auto& boundary :
+  for (Entity boundary :
        registry.spaces
            .get(level->get_room_by_editor_id(current_room_editor_id).entity)
            .boundaries) {
     deactivate_boundary(boundary);
   }
 
-  while (registry.deadlys.entities.size() > 0) {
-    Entity e = registry.deadlys.entities.back();
-    if (save) {
-      level->get_room_by_editor_id(current_room_editor_id)
-          .saved_entities.push_back(EntitySave(e));
-    }
-    registry.remove_all_components_of(e);
-  }
-
-  while (registry.consumables.entities.size() > 0) {
-    Entity e = registry.consumables.entities.back();
-    if (save) {
-      level->get_room_by_editor_id(current_room_editor_id)
-          .saved_entities.push_back(EntitySave(e));
-    }
-    registry.remove_all_components_of(e);
-  }
-
-  while (registry.items.entities.size() > 0) {
-    Entity e = registry.items.entities.back();
-    if (save) {
-      level->get_room_by_editor_id(current_room_editor_id)
-          .saved_entities.push_back(EntitySave(e));
-    }
-    registry.remove_all_components_of(e);
-  }
-
-  while (registry.interactable.entities.size() > 0) {
-    Entity e = registry.interactable.entities.back();
-    if (save) {
-      level->get_room_by_editor_id(current_room_editor_id)
-          .saved_entities.push_back(EntitySave(e));
-    }
-    registry.remove_all_components_of(e);
-  }
-
-  while (registry.breakables.entities.size() > 0) {
-    Entity e = registry.breakables.entities.back();
-    if (save) {
-      level->get_room_by_editor_id(current_room_editor_id)
-          .saved_entities.push_back(EntitySave(e));
-    }
-    registry.remove_all_components_of(e);
-  }
-
-  while (registry.ambient.entities.size() > 0) {
-    Entity e = registry.ambient.entities.back();
-    if (save) {
-      level->get_room_by_editor_id(current_room_editor_id)
-          .saved_entities.push_back(EntitySave(e));
+  // The room's entities are gathered first and destroyed in one batch, the
+  // saved ones are recorded while all of their components are still around
+  RoomBuilder& current_room =
+      level->get_room_by_editor_id(current_room_editor_id);
+  std::vector<Entity>              removed;
+  std::unordered_set<unsigned int> batched;
+  auto remove_all = [&](const std::vector<Entity>& entities, bool saved) {
+    for (Entity e : entities) {
+      if (!batched.insert(e).second) {
+        continue;
+      }
+      if (saved) {
+        current_room.saved_entities.push_back(EntitySave(e));
+      }
+      removed.push_back(e);
     }
-    registry.remove_all_components_of(e);
-  }
-
-  while (registry.floors.entities.size() > 0) {
-    registry.remove_all_components_of(registry.floors.entities.back());
-  }
-
-  while (registry.bubbles.entities.size() > 0) {
-    registry.remove_all_components_of(registry.bubbles.entities.back());
-  }
-
-  while (registry.drops.entities.size() > 0) {
-    registry.remove_all_components_of(registry.drops.entities.back());
-  }
-
-  while (registry.entityGroups.entities.size() > 0) {
-    registry.remove_all_components_of(registry.entityGroups.entities.back());
-  }
-
-  while (registry.groups.entities.size() > 0) {
-    registry.remove_all_components_of(registry.groups.entities.back());
-  }
-
-  while (registry.bubbles.entities.size() > 0) {
-    registry.remove_all_components_of(registry.bubbles.entities.back());
-  }
-
-  while (registry.explosions.entities.size() > 0) {
-    registry.remove_all_components_of(registry.explosions.entities.back());
-  }
-
-  while (registry.enemyProjectiles.entities.size() > 0) {
-    Entity e = registry.enemyProjectiles.entities.back();
-    registry.remove_all_components_of(e);
-  }
+  };
+
+  remove_all(registry.deadlys.entities, save);
+  remove_all(registry.consumables.entities, save);
+  remove_all(registry.items.entities, save);
+  remove_all(registry.interactable.entities, save);
+  remove_all(registry.breakables.entities, save);
+  remove_all(registry.ambient.entities, save);
+
+  remove_all(registry.floors.entities, false);
+  remove_all(registry.bubbles.entities, false);
+  remove_all(registry.drops.entities, false);
+  remove_all(registry.entityGroups.entities, false);
+  remove_all(registry.groups.entities, false);
+  remove_all(registry.explosions.entities, false);
+  remove_all(registry.enemyProjectiles.entities, false);
+
+  registry.destroy_batch(removed, ROOM_SHRINK_WATERMARK);
+  release_room_memory();
 
   registry.stunned.clear();
   registry.knockedback.clear();
@@ -330,9 +281,9 @@ void LevelSystem::move_player_to_door(Direction direction, Entity& exit_door) {
            .doors) {
     if (door == exit_door) {
       if (registry.positions.has(door)) {
-        Position& door_position = registry.positions.get(door);
+        ConstPositionRef door_position = registry.positions.get(door);
         for (auto& player : registry.players.entities) {
-          Position& player_position = registry.positions.get(player);
+          PositionRef player_position = registry.positions.get_mut(player);
 
           // Offset the player from the door so they don't immediately reswitch
           // rooms. Get the opposite direction of the wall that this door was
@@ -356,18 +307,17 @@ void LevelSystem::move_player_to_door(Direction direction, Entity& exit_door) {
               player_position.position.x += offset;
               break;
           }
-          Player&   player_comp = registry.players.get(player);
-          Position& player_mesh_pos =
-              registry.positions.get(player_comp.collisionMesh);
-          player_mesh_pos.position = player_position.position;
           if (registry.cursors.entities.size() > 0 &&
               registry.positions.has(registry.cursors.entities[0])) {
-            Position& cursor_pos =
-                registry.positions.get(registry.cursors.entities[0]);
+            PositionRef cursor_pos =
+                registry.positions.get_mut(registry.cursors.entities[0]);
             updateWepProjPos(cursor_pos.position);
           } else {
             updateWepProjPos(player_position.position);
           }
+          // physics is paused during the transition, bring the collision mesh
+          // and weapon along with the player
+          updateHierarchy();
         }
       }
     }
@@ -430,7 +380,7 @@ void LevelSystem::collect_key(Objective objective) {
   }
 
   for (const auto& entity : registry.doorConnections.entities) {
-    DoorConnection& door_connection = registry.doorConnections.get(entity);
+    DoorConnection& door_connection = registry.doorConnections.get_mut(entity);
     if (door_connection.locked && door_connection.objective == objective) {
       // Unlock this door, and stop treating it as a wall.
       door_connection.locked = false;
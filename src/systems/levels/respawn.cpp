@@ -11,6 +11,7 @@
 #include "physics.hpp"
 #include "random.hpp"
 #include "render_system.hpp"
+#include "spawning.hpp"
 #include "tiny_ecs_registry.hpp"
 
 const std::unordered_map<
@@ -55,35 +56,35 @@ EntitySave::EntitySave(EntityState es) {
 
 EntitySave::EntitySave(Entity e) {
   if (registry.oxygen.has(e)) {
-    Oxygen& o       = registry.oxygen.get(e);
+    const Oxygen& o = registry.oxygen.get(e);
     this->es.oxygen = o.level;
   } else {
     this->es.oxygen = -1.0;
   }
 
   if (registry.positions.has(e)) {
-    Position& pos     = registry.positions.get(e);
-    this->es.position = pos;
+    ConstPositionRef pos = registry.positions.get(e);
+    this->es.position    = pos;
   } 
 
   // brute force it
   if (registry.deadlys.has(e)) {
-    Deadly& d     = registry.deadlys.get(e);
-    this->es.type = d.type;
+    const Deadly& d = registry.deadlys.get(e);
+    this->es.type   = d.type;
   } else if (registry.consumables.has(e)) {
-    Consumable& c = registry.consumables.get(e);
-    this->es.type = c.type;
+    const Consumable& c = registry.consumables.get(e);
+    this->es.type       = c.type;
   } else if (registry.items.has(e)) {
-    Item& i       = registry.items.get(e);
+    const Item& i = registry.items.get(e);
     this->es.type = i.type;
   } else if (registry.interactable.has(e)) {
-    Interactable& i = registry.interactable.get(e);
-    this->es.type   = i.type;
+    const Interactable& i = registry.interactable.get(e);
+    this->es.type         = i.type;
   } else if (registry.breakables.has(e)) {
-    Breakable& b  = registry.breakables.get(e);
-    this->es.type = b.type;
+    const Breakable& b = registry.breakables.get(e);
+    this->es.type      = b.type;
   } else if (registry.ambient.has(e)) {
-    Ambient& a  = registry.ambient.get(e);
+    const Ambient& a = registry.ambient.get(e);
     this->es.type = a.type;
   } else {
     assert("You're trying to record an EntitySave but it isn't configured" &&
@@ -91,12 +92,13 @@ EntitySave::EntitySave(Entity e) {
   }
 
   if (registry.entityGroups.has(e)) {
-    EntityGroup& eg = registry.entityGroups.get(e);
-    this->es.group  = eg.group;
+    const EntityGroup& eg = registry.entityGroups.get(e);
+    this->es.group        = eg.group;
   }
 }
 
-void EntitySave::respawn(RenderSystem* renderer) {
+void EntitySave::respawn(RenderSystem*    renderer,
+                         RespawnedGroups& respawned_groups) {
   auto respawn_it =
       respawnFnMap.find(this->es.type);
   if (respawn_it == respawnFnMap.end()) {
@@ -109,14 +111,13 @@ void EntitySave::respawn(RenderSystem* renderer) {
 
   // if was in a group, reassign
   if ((unsigned int)this->es.group != 0) {
-    Entity g = Entity(this->es.group);
-    if (!registry.groups.has(g)) {
-      registry.groups.emplace(g);
+    // the saved group id is only a key, its entity was released along with
+    // the room, so map it to a group entity made for this room
+    auto group_it = respawned_groups.find(this->es.group);
+    if (group_it == respawned_groups.end()) {
+      group_it =
+          respawned_groups.emplace(this->es.group, create_pack_group(0)).first;
     }
-    Group&       group = registry.groups.get(g);
-    EntityGroup& eg    = registry.entityGroups.emplace(e);
-    group.members.push_back(e);
-    eg.group         = g;
-    eg.active_dir_cd = randomFloat(0.f, eg.change_dir_cd);
+    join_pack(group_it->second, e);
   }
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <unordered_map>
+
 #include "entity_type.hpp"
 #include "physics.hpp"
 #include "render_system.hpp"
@@ -11,10 +13,14 @@ struct EntityState {
   ENTITY_TYPE  type;
 };
 
+// saved group id -> group entity its members were respawned into, for the
+// room being respawned
+using RespawnedGroups = std::unordered_map<unsigned int, Entity>;
+
 class EntitySave {
   public:
   struct EntityState es;
   EntitySave(Entity e);
   EntitySave(EntityState es);
-  void respawn(RenderSystem* renderer);
+  void respawn(RenderSystem* renderer, RespawnedGroups& respawned_groups);
 };
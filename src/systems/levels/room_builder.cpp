@@ -12,7 +12,7 @@ RoomBuilder::RoomBuilder(): pointer({0, 0}) {
 }
 
 void RoomBuilder::update_bounding_box(Vector &vector) {
-  SpaceBoundingBox &bounding_box = registry.bounding_boxes.get(entity);
+  SpaceBoundingBox &bounding_box = registry.bounding_boxes.get_mut(entity);
   bounding_box.minimum_x = std::min(bounding_box.minimum_x, vector.end.x);
   bounding_box.maximum_x = std::max(bounding_box.maximum_x, vector.end.x);
   bounding_box.minimum_y = std::min(bounding_box.minimum_y, vector.end.y);
@@ -41,12 +41,12 @@ Entity RoomBuilder::make_boundary(int magnitude) {
                         vector_pos_y + ROOM_ORIGIN_POS.y);
 
     // Setting initial position values
-    Position& position_component = registry.positions.emplace(boundary);
-    position_component.position  = position;
-    position_component.angle     = 0.f;
-    position_component.scale     = bounding_box;
+    PositionRef position_component = registry.positions.emplace(boundary);
+    position_component.position    = position;
+    position_component.angle       = 0.f;
+    position_component.scale       = bounding_box;
 
-    Space &space = registry.spaces.get(entity);
+    Space &space = registry.spaces.get_mut(entity);
     space.boundaries.push_back(boundary);
 
     // Update the space's bounding box.
@@ -60,7 +60,7 @@ Entity RoomBuilder::make_boundary(int magnitude) {
 
 RoomBuilder& RoomBuilder::add_wall(int magnitude) {
   if (magnitude != 0) {
-    Space &space = registry.spaces.get(entity);
+    Space &space = registry.spaces.get_mut(entity);
     Entity boundary = make_boundary(magnitude);
     space.walls.push_back(boundary);
   }
@@ -68,7 +68,7 @@ RoomBuilder& RoomBuilder::add_wall(int magnitude) {
 };
 
 RoomBuilder& RoomBuilder::door(EditorID s_id, int magnitude) {
-  Space &space = registry.spaces.get(entity);
+  Space &space = registry.spaces.get_mut(entity);
   Entity boundary = make_boundary(magnitude);
 
   // Add the door to the space, keyed by string.
@@ -95,9 +95,10 @@ vec2 RoomBuilder::get_updated_left_position(int magnitude) {
 }
 
 void RoomBuilder::respawn(RenderSystem* renderer) {
+  RespawnedGroups respawned_groups;
   while (saved_entities.size() > 0) {
     EntitySave es = saved_entities.back();
-    es.respawn(renderer);
+    es.respawn(renderer, respawned_groups);
     saved_entities.pop_back();
   }
 }
@@ -153,8 +154,8 @@ bool RoomBuilder::is_in_room(vec2& position) {
   bool up = false;
   bool down = false;
 
-  for (Entity &entity : registry.spaces.get(entity).boundaries) {
-    Vector &vector = registry.vectors.get(entity);
+  for (Entity entity : registry.spaces.get(entity).boundaries) {
+    const Vector &vector = registry.vectors.get(entity);
     if ((!down || !up) && vector.start.y == vector.end.y) {
       if (position.x >
               (std::min(vector.start.x, vector.end.x) + WALL_THICKNESS) &&
@@ -184,7 +185,7 @@ bool RoomBuilder::is_in_room(vec2& position) {
 };
 
 vec2 RoomBuilder::rejection_sample() {
-  SpaceBoundingBox &box = registry.bounding_boxes.get(entity);
+  SpaceBoundingBox &box = registry.bounding_boxes.get_mut(entity);
   // We generate random coordinates inside the bounding box. Theoretically, this
   // could be slow if the bounding box's area is far larger than a room; think
   // of a case like an 'L'-shaped room. Since randomized levels are only
@@ -1,5 +1,6 @@
 #include "spawning.hpp"
 
+#include <cassert>
 #include <iostream>
 
 #include "random.hpp"
@@ -62,93 +63,37 @@ void execute_config_fixed_rand(
 }
 
 bool remove_all_entities() {
-  while (registry.motions.entities.size() > 0) {
-    registry.remove_all_components_of(registry.motions.entities.back());
-  }
-
-  while (registry.deadlys.entities.size() > 0) {
-    registry.remove_all_components_of(registry.deadlys.entities.back());
-  }
-
-  while (registry.consumables.entities.size() > 0) {
-    registry.remove_all_components_of(registry.consumables.entities.back());
-  }
-
-  while (registry.interactable.entities.size() > 0) {
-    registry.remove_all_components_of(registry.interactable.entities.back());
-  }
-
-  while (registry.playerWeapons.entities.size() > 0) {
-    registry.remove_all_components_of(registry.playerWeapons.entities.back());
-  }
-
-  while (registry.breakables.entities.size() > 0) {
-    registry.remove_all_components_of(registry.breakables.entities.back());
-  }
-
-  while (registry.playerProjectiles.entities.size() > 0) {
-    registry.remove_all_components_of(
-        registry.playerProjectiles.entities.back());
-  }
-
-  while (registry.enemyProjectiles.entities.size() > 0) {
-    registry.remove_all_components_of(
-        registry.enemyProjectiles.entities.back());
-  }
-
-  while (registry.enemySupports.entities.size() > 0) {
-    registry.remove_all_components_of(registry.enemySupports.entities.back());
-  }
-
-  while (registry.oxygenModifiers.entities.size() > 0) {
-    registry.remove_all_components_of(registry.oxygenModifiers.entities.back());
-  }
-
-  while (registry.playersCollisionMeshes.entities.size() > 0) {
-    registry.remove_all_components_of(
-        registry.playersCollisionMeshes.entities.back());
-  }
-
-  while (registry.playerHUD.entities.size() > 0) {
-    registry.remove_all_components_of(registry.playerHUD.entities.back());
-  }
-
-  while (registry.notifications.entities.size() > 0) {
-    registry.remove_all_components_of(registry.notifications.entities.back());
-  }
-
-  while (registry.inventoryCounters.entities.size() > 0) {
-    registry.remove_all_components_of(
-        registry.inventoryCounters.entities.back());
-  }
-
-  while (registry.entityGroups.entities.size() > 0) {
-    registry.remove_all_components_of(registry.entityGroups.entities.back());
-  }
-
-  while (registry.groups.entities.size() > 0) {
-    registry.remove_all_components_of(registry.groups.entities.back());
-  }
-
-  while (registry.bubbles.entities.size() > 0) {
-    registry.remove_all_components_of(registry.bubbles.entities.back());
-  }
-
-  while (registry.textRequests.entities.size() > 0) {
-    registry.remove_all_components_of(registry.textRequests.entities.back());
-  }
-
-  while (registry.ambient.entities.size() > 0) {
-    registry.remove_all_components_of(registry.ambient.entities.back());
-  }
-
-  while (registry.saveStatuses.entities.size() > 0) {
-    registry.remove_all_components_of(registry.saveStatuses.entities.back());
-  }
-
-  while (registry.explosions.entities.size() > 0) {
-    registry.remove_all_components_of(registry.explosions.entities.back());
-  }
+  // Gathered first and destroyed in one batch, entities found in more than
+  // one container are skipped by destroy_batch the second time
+  std::vector<Entity> removed;
+  auto remove_all = [&removed](const std::vector<Entity>& entities) {
+    removed.insert(removed.end(), entities.begin(), entities.end());
+  };
+
+  remove_all(registry.motions.entities);
+  remove_all(registry.deadlys.entities);
+  remove_all(registry.consumables.entities);
+  remove_all(registry.interactable.entities);
+  remove_all(registry.playerWeapons.entities);
+  remove_all(registry.breakables.entities);
+  remove_all(registry.playerProjectiles.entities);
+  remove_all(registry.enemyProjectiles.entities);
+  remove_all(registry.enemySupports.entities);
+  remove_all(registry.oxygenModifiers.entities);
+  remove_all(registry.playersCollisionMeshes.entities);
+  remove_all(registry.playerHUD.entities);
+  remove_all(registry.notifications.entities);
+  remove_all(registry.inventoryCounters.entities);
+  remove_all(registry.entityGroups.entities);
+  remove_all(registry.groups.entities);
+  remove_all(registry.bubbles.entities);
+  remove_all(registry.textRequests.entities);
+  remove_all(registry.ambient.entities);
+  remove_all(registry.saveStatuses.entities);
+  remove_all(registry.explosions.entities);
+
+  registry.destroy_batch(removed, ROOM_SHRINK_WATERMARK);
+  release_room_memory();
 
   registry.stunned.clear();
   registry.knockedback.clear();
@@ -157,6 +102,29 @@ bool remove_all_entities() {
   return true;
 }
 
+void release_room_memory() {
+  assert(registry.groups.size() == 0 &&
+         "room arena released while groups still reference it");
+  room_arena().release();
+}
+
+Entity create_pack_group(int pack_size) {
+  Entity groupEntity = Entity();
+  Group& group       = registry.groups.emplace(groupEntity);
+  // groups go away with the room, so the member list lives in its arena
+  group.members = PooledVector<Entity>(&room_arena());
+  group.members.reserve(pack_size);
+  return groupEntity;
+}
+
+void join_pack(Entity group, Entity member) {
+  EntityGroup& eg = registry.entityGroups.emplace(member);
+  eg.group        = group;
+  // give some variance to things moving in the group
+  eg.active_dir_cd = randomFloat(0.f, eg.change_dir_cd);
+  registry.groups.get_mut(group).members.push_back(member);
+}
+
 void execute_pack_spawning(
     std::function<Entity(RenderSystem* r, vec2 p, bool b)> spawnFn,
     RoomBuilder& room_builder, RenderSystem* renderer, int pack_size) {
@@ -191,8 +159,7 @@ void execute_pack_spawning_area_size(
   tempPosition.position.y -= tempPosition.scale.y * 0.5;
 
   // spawn in pack
-  Entity groupEntity = Entity();
-  Group& group       = registry.groups.emplace(groupEntity);
+  Entity groupEntity = create_pack_group(pack_size);
 
   for (int i = 0; i < pack_size; i++) {
     vec2 loc;
@@ -212,12 +179,7 @@ void execute_pack_spawning_area_size(
         continue;
       }
 
-      // add to group
-      EntityGroup& eg = registry.entityGroups.emplace(e);
-      eg.group        = groupEntity;
-      // give some variance to things moving in the group
-      eg.active_dir_cd = randomFloat(0.f, eg.change_dir_cd);
-      group.members.push_back(e);
+      join_pack(groupEntity, e);
       break;
     }
   }
@@ -16,6 +16,9 @@
 #define MAX_SPAWN_ATTEMPTS 64
 #define MIN_PACK_SHAPE_SIZE 300.f
 #define MAX_PACK_SHAPE_SIZE 500.f
+// Unused components a container keeps room for once a room is torn down, so
+// that spawning the next room does not grow it again
+#define ROOM_SHRINK_WATERMARK 256
 
 /**
  * @brief Takes in a config macro, and spawns enemies in random locations in the
@@ -59,6 +62,19 @@ void execute_pack_spawning_area_size(
     RoomBuilder& room_builder, RenderSystem* renderer, int pack_size,
     float width, float height);
 
+/**
+ * @brief creates the Group of a pack, its member list lives in the room arena
+ * and has room for pack_size members
+ *
+ * @return the group entity
+ */
+Entity create_pack_group(int pack_size);
+
+/**
+ * @brief adds member to the pack of group
+ */
+void join_pack(Entity group, Entity member);
+
 
 /**
  * @brief Takes in a config macro with pre-defined positioned entities, and
@@ -83,3 +99,9 @@ void execute_config_fixed_rand(float chance,
  * @return true if success
  */
 bool remove_all_entities();
+
+/**
+ * @brief hands the room arena's memory back for the next room, only valid
+ * once every room-scoped component (groups) has been destroyed
+ */
+void release_room_memory();
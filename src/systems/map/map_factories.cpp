@@ -112,7 +112,7 @@ Entity createGeyserPos(RenderSystem* renderer, vec2 position,
   // Reserve an entity
   auto entity = Entity();
 
-  auto& pos    = registry.positions.emplace(entity);
+  auto pos     = registry.positions.emplace(entity);
   pos.angle    = 0.f;
   pos.position = position;
   pos.scale    = GEYSER_SCALE_FACTOR * GEYSER_BOUNDING_BOX;
@@ -178,12 +178,12 @@ Entity createCratePos(RenderSystem* renderer, vec2 position,
   // Reserve an entity
   auto entity = Entity();
   // physics and pos
-  Position& pos = registry.positions.emplace(entity);
-  pos.angle     = 0.f;
-  pos.position  = position;
-  pos.scale     = CRATE_SCALE_FACTOR * CRATE_BOUNDING_BOX;
+  PositionRef pos = registry.positions.emplace(entity);
+  pos.angle       = 0.f;
+  pos.position    = position;
+  pos.scale       = CRATE_SCALE_FACTOR * CRATE_BOUNDING_BOX;
 
-  Motion& motion      = registry.motions.emplace(entity);
+  MotionRef motion    = registry.motions.emplace(entity);
   motion.acceleration = {0.f, 0.f};
   motion.velocity     = {0.f, 0.f};
 
@@ -243,8 +243,8 @@ Entity respawnCrate(RenderSystem* renderer, EntityState es) {
     return Entity(0);
   }
 
-  Oxygen& o    = registry.oxygen.get(entity);
-  float   diff = es.oxygen - o.level;
+  const Oxygen& o    = registry.oxygen.get(entity);
+  float         diff = es.oxygen - o.level;
 
   // This will also update the health bar
   if (diff < 0) {
@@ -270,12 +270,12 @@ Entity createRockPos(RenderSystem* renderer, vec2 position,
   // Reserve an entity
   auto entity = Entity();
   // physics and pos
-  Position& pos = registry.positions.emplace(entity);
-  pos.angle     = 0.f;
-  pos.position  = position;
-  pos.scale     = ROCK_SCALE_FACTOR * ROCK_BOUNDING_BOX;
+  PositionRef pos = registry.positions.emplace(entity);
+  pos.angle       = 0.f;
+  pos.position    = position;
+  pos.scale       = ROCK_SCALE_FACTOR * ROCK_BOUNDING_BOX;
 
-  Motion& motion      = registry.motions.emplace(entity);
+  MotionRef motion    = registry.motions.emplace(entity);
   motion.acceleration = {0.f, 0.f};
   motion.velocity     = {0.f, 0.f};
 
@@ -334,10 +334,10 @@ Entity createMetalCratePos(RenderSystem* renderer, vec2 position,
   // Reserve an entity
   auto entity = Entity();
   // physics and pos
-  Position& pos = registry.positions.emplace(entity);
-  pos.angle     = 0.f;
-  pos.position  = position;
-  pos.scale     = METAL_CRATE_SCALE_FACTOR * METAL_CRATE_BOUNDING_BOX;
+  PositionRef pos = registry.positions.emplace(entity);
+  pos.angle       = 0.f;
+  pos.position    = position;
+  pos.scale       = METAL_CRATE_SCALE_FACTOR * METAL_CRATE_BOUNDING_BOX;
 
   if (checkCollisions && !checkSpawnCollisions(entity)) {
     // returns invalid entity, since id's start from 1
@@ -378,13 +378,13 @@ Entity respawnMetalCrate(RenderSystem* renderer, EntityState es) {
   }
 
   // Restore State
-  Position& pos     = registry.positions.get(entity);
+  PositionRef pos   = registry.positions.get_mut(entity);
   pos.angle         = es.position.angle;
   pos.scale         = es.position.scale;
   pos.originalScale = es.position.originalScale;
 
-  Oxygen& o    = registry.oxygen.get(entity);
-  float   diff = es.oxygen - o.level;
+  const Oxygen& o    = registry.oxygen.get(entity);
+  float         diff = es.oxygen - o.level;
 
   // This will also update the health bar
   if (diff < 0) {
@@ -449,7 +449,7 @@ Entity createPressurePlatePos(RenderSystem* renderer, vec2 position,
   // Reserve an entity
   auto entity = Entity();
 
-  auto& pos    = registry.positions.emplace(entity);
+  auto pos     = registry.positions.emplace(entity);
   pos.angle    = 0.f;
   pos.position = position;
   pos.scale    = PRESSURE_PLATE_BOUNDING_BOX * PRESSURE_PLATE_SCALE_FACTOR;
@@ -468,8 +468,7 @@ Entity createPressurePlatePos(RenderSystem* renderer, vec2 position,
   Interactable& i = registry.interactable.emplace(entity);
   i.type          = ENTITY_TYPE::PRESSURE_PLATE;
 
-  PressurePlate& pp = registry.pressurePlates.emplace(entity);
-  pp.active         = false;
+  registry.pressurePlates.emplace(entity);
 
   registry.renderRequests.insert(
       entity, {TEXTURE_ASSET_ID::PRESSURE_PLATE_OFF, EFFECT_ASSET_ID::TEXTURED,
@@ -495,7 +494,7 @@ Entity createShellPos(RenderSystem* renderer, vec2 position,
   // Reserve an entity
   auto entity = Entity();
 
-  auto& pos    = registry.positions.emplace(entity);
+  auto pos     = registry.positions.emplace(entity);
   pos.angle    = randomFloat(0.f, 6.283185);
   pos.position = position;
   pos.scale    = SHELL_BOUNDING_BOX * randomFloat(AMBIENT_MIN_SCALE, AMBIENT_MAX_SCALE);
@@ -542,7 +541,7 @@ Entity createKelpPos(RenderSystem* renderer, vec2 position,
   // Reserve an entity
   auto entity = Entity();
 
-  auto& pos    = registry.positions.emplace(entity);
+  auto pos     = registry.positions.emplace(entity);
   pos.angle    = 0.f;
   pos.position = position;
   pos.scale    = SHELL_BOUNDING_BOX * randomFloat(AMBIENT_MIN_SCALE, AMBIENT_MAX_SCALE);
@@ -589,7 +588,7 @@ Entity createJunkPos(RenderSystem* renderer, vec2 position,
   // Reserve an entity
   auto entity = Entity();
 
-  auto& pos    = registry.positions.emplace(entity);
+  auto pos     = registry.positions.emplace(entity);
   pos.angle    = randomFloat(0.f, 6.283185);
   pos.position = position;
   pos.scale    = SHELL_BOUNDING_BOX * randomFloat(AMBIENT_MIN_SCALE, AMBIENT_MAX_SCALE);
@@ -637,7 +636,7 @@ Entity createBonesPos(RenderSystem* renderer, vec2 position,
   // Reserve an entity
   auto entity = Entity();
 
-  auto& pos    = registry.positions.emplace(entity);
+  auto pos     = registry.positions.emplace(entity);
   pos.angle    = randomFloat(0.f, 6.283185);
   pos.position = position;
   pos.scale    = SHELL_BOUNDING_BOX * randomFloat(AMBIENT_MIN_SCALE, AMBIENT_MAX_SCALE);
@@ -684,7 +683,7 @@ Entity createCoralPos(RenderSystem* renderer, vec2 position,
   // Reserve an entity
   auto entity = Entity();
 
-  auto& pos    = registry.positions.emplace(entity);
+  auto pos     = registry.positions.emplace(entity);
   pos.angle    = randomFloat(0.f, 6.283185);
   pos.position = position;
   pos.scale    = SHELL_BOUNDING_BOX * randomFloat(AMBIENT_MIN_SCALE, AMBIENT_MAX_SCALE);
@@ -5,6 +5,7 @@
 
 #include "boss_factories.hpp"
 #include "enemy_factories.hpp"
+#include "hierarchy.hpp"
 #include "player_factories.hpp"
 #include "tiny_ecs_registry.hpp"
 #include "world_system.hpp"
@@ -21,7 +22,7 @@ void depleteOxygen(Entity& entity) {
   if (!registry.oxygen.has(entity)) {
     return;
   }
-  Oxygen& entity_oxygen = registry.oxygen.get(entity);
+  Oxygen& entity_oxygen = registry.oxygen.get_mut(entity);
   entity_oxygen.level += calcDeltaOxygen(entity_oxygen, entity_oxygen.rate);
   updateHealthBarRender(entity, entity_oxygen, entity_oxygen.rate);
   updateOxygenLvlStatus(entity_oxygen);
@@ -52,7 +53,7 @@ void modifyOxygen(Entity& entity, Entity& oxygenModifier) {
     return;
   }
 
-  Oxygen& entity_oxygen = registry.oxygen.get(entity);
+  Oxygen& entity_oxygen = registry.oxygen.get_mut(entity);
   float   oxyModAmount  = registry.oxygenModifiers.get(oxygenModifier).amount;
   float   deltaOxygen   = calcDeltaOxygen(entity_oxygen, oxyModAmount);
 
@@ -62,7 +63,7 @@ void modifyOxygen(Entity& entity, Entity& oxygenModifier) {
   }
 
   if (registry.lobsters.has(entity)) {
-    Lobster& lobster = registry.lobsters.get(entity);
+    const Lobster& lobster = registry.lobsters.get(entity);
     if (lobster.block_timer > 0) {
       if (!registry.sounds.has(entity)) {
         registry.sounds.insert(entity, Sound(SOUND_ASSET_ID::METAL_CRATE_HIT));
@@ -94,7 +95,7 @@ void modifyOxygen(Entity& entity, Entity& oxygenModifier) {
   if (registry.breakables.has(entity) && !registry.sounds.has(entity)) {
     bool metal = false;
     if (registry.renderRequests.has(entity)) {
-      RenderRequest& request = registry.renderRequests.get(entity);
+      const RenderRequest& request = registry.renderRequests.get(entity);
       metal = request.used_texture == TEXTURE_ASSET_ID::METAL_CRATE;
     }
     if (entity_oxygen.level <= 0) {
@@ -115,7 +116,7 @@ void modifyOxygen(Entity& entity, Entity& oxygenModifier) {
 }
 
 void modifyOxygenAmount(Entity& entity, float amount) {
-  Oxygen& entity_oxygen = registry.oxygen.get(entity);
+  Oxygen& entity_oxygen = registry.oxygen.get_mut(entity);
   float   deltaOxygen   = calcDeltaOxygen(entity_oxygen, amount);
 
   if (!entity_oxygen.isRendered) {
@@ -129,26 +130,6 @@ void modifyOxygenAmount(Entity& entity, float amount) {
   updateDeathStatus(entity, entity_oxygen);
 }
 
-/**
- * @brief update the position values of an entity's health bar depending on
- * entity position
- */
-void updateEnemyHealthBarPos(Entity& enemy) {
-  Position& enemyPos    = registry.positions.get(enemy);
-  Oxygen&   enemyOxygen = registry.oxygen.get(enemy);
-
-  Position& oxygenBarPos = registry.positions.get(enemyOxygen.oxygenBar);
-  Position& backgroundBarPos =
-      registry.positions.get(enemyOxygen.backgroundBar);
-
-  oxygenBarPos.position =
-      enemyPos.position -
-      vec2((oxygenBarPos.originalScale.x - oxygenBarPos.scale.x) / 2,
-           enemyPos.scale.y / 2 + ENEMY_O2_BAR_GAP);
-  backgroundBarPos.position =
-      enemyPos.position - vec2(0.f, enemyPos.scale.y / 2 + ENEMY_O2_BAR_GAP);
-}
-
 ///////////////////////////////////////////////////////////////////////////////
 // HELPERS AND WRAPPERS
 ///////////////////////////////////////////////////////////////////////////////
@@ -175,7 +156,7 @@ float oxygen_drain(float oxygen_deplete_timer,
  */
 bool isModOnCooldown(Entity& oxygenModifier) {
   if (registry.modifyOxygenCd.has(oxygenModifier)) {
-    auto& modifyOxygenCd = registry.modifyOxygenCd.get(oxygenModifier);
+    auto& modifyOxygenCd = registry.modifyOxygenCd.get_mut(oxygenModifier);
     if (modifyOxygenCd.curr_cd > 0.f) {
       return true;
     }
@@ -208,8 +189,8 @@ void updateHealthBarRender(Entity& entity, Oxygen& entity_oxygen,
         registry.positions.has(entity_oxygen.backgroundBar))) {
     return;
   }
-  Position& barPositionComponent =
-      registry.positions.get(entity_oxygen.oxygenBar);
+  PositionRef barPositionComponent =
+      registry.positions.get_mut(entity_oxygen.oxygenBar);
   vec2& barOriginalScale = barPositionComponent.originalScale;
   vec2& barScale         = barPositionComponent.scale;
   vec2& barPosition      = barPositionComponent.position;
@@ -223,6 +204,13 @@ void updateHealthBarRender(Entity& entity, Oxygen& entity_oxygen,
   scaleToChange           = max(0.f, scaleToChange + deltaBarScale);
   positionToChange        = (isPlayer) ? positionToChange - deltaBarScale / 2
                                        : positionToChange + deltaBarScale / 2;
+
+  // enemy bars follow their enemy, keep the bar's left end in place
+  LocalTransform* barLocal =
+      registry.localTransforms.try_get_mut(entity_oxygen.oxygenBar);
+  if (barLocal) {
+    barLocal->offset.x = -(barOriginalScale.x - barScale.x) / 2;
+  }
 }
 
 /**
@@ -280,12 +268,12 @@ void updateDeathStatus(Entity& entity, Oxygen& entity_oxygen) {
         registry.remove_all_components_of(projectile);
       }
       // if cthulhu is angry, he dies, otherwise make him angry
-      Boss& cthulhu = registry.bosses.get(entity);
+      Boss& cthulhu = registry.bosses.get_mut(entity);
       if (cthulhu.is_angry) {
         // remove render and stop attacks to show its dead
         registry.deathTimers.insert(entity, {3000.f});
         registry.renderRequests.remove(entity);
-        registry.shooters.get(entity).cooldown = 10000;
+        registry.shooters.get_mut(entity).cooldown = 10000;
         if (!registry.sounds.has(entity)) {
           registry.sounds.insert(entity,
                                  Sound(SOUND_ASSET_ID::CTHULHU_DEATH, 5000));
@@ -293,13 +281,13 @@ void updateDeathStatus(Entity& entity, Oxygen& entity_oxygen) {
       } else {
         // hack, bros ai is healing
         if (registry.deadlys.has(entity)) {
-          Deadly& d = registry.deadlys.get(entity);
+          Deadly& d = registry.deadlys.get_mut(entity);
           d.type    = ENTITY_TYPE::CTHULHU_TRANS;
         }
         cthulhu.type          = ENTITY_TYPE::CTHULHU_TRANS;
         cthulhu.curr_cd       = 0;
         cthulhu.ai_cd         = CTHULHU_REGEN_RATE;
-        cthulhu.ai = std::vector<std::function<void()>>({addCthulhuRageAI});
+        cthulhu.ai = PooledVector<std::function<void()>>({addCthulhuRageAI});
         //pause music during his transition to phase 2.
         registry.musics.insert(Entity(), MUSIC_ASSET_ID::MUSIC_COUNT);
       }
@@ -309,7 +297,7 @@ void updateDeathStatus(Entity& entity, Oxygen& entity_oxygen) {
         registry.sounds.insert(Entity(), Sound(SOUND_ASSET_ID::ENEMY_DEATH));
       }
       if (registry.bosses.has(entity)) {
-        Boss& boss = registry.bosses.get(entity);
+        const Boss& boss = registry.bosses.get(entity);
         if (boss.type == ENTITY_TYPE::KRAB_BOSS) {
           registry.musics.insert(Entity(), MUSIC_ASSET_ID::INTRO_MUSIC);
         } else if (boss.type == ENTITY_TYPE::SHARKMAN) {
@@ -340,20 +328,27 @@ void createDefaultHealthbar(RenderSystem* renderer, Entity& entity,
   registry.meshPtrs.emplace(backgroundBar, &mesh);
 
   // Get position of entity
-  Position& entityPos = registry.positions.get(entity);
+  ConstPositionRef entityPos = registry.positions.get(entity);
 
   // Setting initial positon values
-  Position& position = registry.positions.emplace(oxygenBar);
+  PositionRef position = registry.positions.emplace(oxygenBar);
   position.position =
       entityPos.position - vec2(0.f, entityPos.scale.y / 2 + ENEMY_O2_BAR_GAP);
   position.angle         = 0.f;
   position.scale         = healthScale * bounding_box;
   position.originalScale = healthScale * bounding_box;
 
-  Position& backgroundPos = registry.positions.emplace(backgroundBar);
-  backgroundPos.position  = position.position;
-  backgroundPos.angle     = 0.f;
-  backgroundPos.scale     = barScale * bounding_box;
+  PositionRef backgroundPos = registry.positions.emplace(backgroundBar);
+  backgroundPos.position    = position.position;
+  backgroundPos.angle       = 0.f;
+  backgroundPos.scale       = barScale * bounding_box;
+
+  // Both bars sit centered above the entity and follow it
+  LocalTransform barLocal;
+  barLocal.anchor = {0.f, -0.5f};
+  barLocal.offset = {0.f, -ENEMY_O2_BAR_GAP};
+  attachToParent(oxygenBar, entity, barLocal);
+  attachToParent(backgroundBar, entity, barLocal);
 
   // Set health bar
   auto& entityOxygen         = registry.oxygen.emplace(entity);
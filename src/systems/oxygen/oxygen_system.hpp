@@ -16,9 +16,6 @@ void modifyOxygen(Entity& entity, Entity& affector);
 
 void modifyOxygenAmount(Entity& entity, float amount);
 
-// update position of enemy health bars
-void updateEnemyHealthBarPos(Entity& enemy);
-
 // wrapper
 float oxygen_drain(float oxygen_deplete_timer,
                    float elapsed_ms_since_last_update);
@@ -0,0 +1,87 @@
+#include "hierarchy.hpp"
+
+#include "tiny_ecs_registry.hpp"
+
+void attachToParent(Entity child, Entity parent, LocalTransform local) {
+  unsigned int depth = registry.parents.has(parent)
+                           ? registry.parents.get(parent).depth + 1
+                           : 0;
+  // Updated in place when already attached to parent, which keeps the
+  // placement order of updateHierarchy for children that are re-attached every
+  // frame. Moving to another parent re-inserts the link, so that the registry
+  // counts the children of both.
+  if (registry.parents.has(child)) {
+    Parent& link = registry.parents.get_mut(child);
+    if (link.parent == parent) {
+      link.depth                              = depth;
+      registry.localTransforms.get_mut(child) = local;
+      return;
+    }
+    detachFromParent(child);
+  }
+  registry.parents.insert(child, {parent, depth});
+  registry.localTransforms.insert(child, local);
+}
+
+void detachFromParent(Entity child) {
+  registry.parents.remove(child);
+  registry.localTransforms.remove(child);
+}
+
+namespace {
+// Orders children by depth, so that every parent is placed before them. Ties
+// are broken by entity, giving both containers the exact same order.
+bool placedBefore(Entity a, Entity b) {
+  unsigned int depth_a = registry.parents.get(a).depth;
+  unsigned int depth_b = registry.parents.get(b).depth;
+  return depth_a < depth_b ||
+         (depth_a == depth_b && a < b);
+}
+
+// True if both containers list the children in the same order, parents first.
+// Removals swap the last child into the gap, so the order has to be checked
+// before every pass.
+bool inPlacementOrder() {
+  auto& parents = registry.parents;
+  auto& locals  = registry.localTransforms;
+  for (size_t i = 0; i < parents.size(); i++) {
+    if (!(parents.entities[i] == locals.entities[i])) return false;
+    if (i > 0 && parents.components[i - 1].depth > parents.components[i].depth)
+      return false;
+  }
+  return true;
+}
+}  // namespace
+
+void updateHierarchy() {
+  auto& parents = registry.parents;
+  auto& locals  = registry.localTransforms;
+  assert(parents.size() == locals.size() &&
+         "Children need both a Parent and a LocalTransform");
+
+  if (!inPlacementOrder()) {
+    parents.sort(placedBefore);
+    locals.sort(placedBefore);
+  }
+
+  // Both containers are walked in lockstep over their dense arrays
+  for (size_t i = 0; i < parents.size(); i++) {
+    Entity       child     = parents.entities[i];
+    Entity       parent    = parents.components[i].parent;
+    unsigned int child_id  = registry.positions.find(child);
+    unsigned int parent_id = registry.positions.find(parent);
+    if (child_id == INVALID_COMPONENT_ID || parent_id == INVALID_COMPONENT_ID) {
+      continue;
+    }
+    const LocalTransform& local      = locals.components[i];
+    ConstPositionRef      parent_pos = registry.positions.at(parent_id);
+    ConstPositionRef      child_pos  = registry.positions.at(child_id);
+    vec2 placed =
+        parent_pos.position + local.offset + local.anchor * parent_pos.scale +
+        local.reach * vec2(cos(child_pos.angle), sin(child_pos.angle));
+    // children of resting parents keep their version, see changed_since
+    if (placed != child_pos.position) {
+      registry.positions.at_mut(child_id).position = placed;
+    }
+  }
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "physics.hpp"
+#include "tiny_ecs.hpp"
+
+// Makes child follow parent at the given LocalTransform. Attaching an entity
+// that already has a parent moves it to the new one.
+void attachToParent(Entity child, Entity parent, LocalTransform local = {});
+
+// Stops child from following its parent, it keeps its current position
+void detachFromParent(Entity child);
+
+// Places every child relative to its parent, parents before their children.
+// Children and parents without a Position are skipped.
+void updateHierarchy();
@@ -0,0 +1,72 @@
+#include "interpolation.hpp"
+
+#include <cassert>
+#include <cmath>
+
+#include "tiny_ecs_registry.hpp"
+
+namespace {
+// Where each entity was before the latest tick, indexed by e.index(). The
+// stored handle tells a captured entity from a later one re-using its index,
+// and from an index that had no position at the capture.
+struct PreviousPosition {
+  unsigned int id = 0;  // entity 0 is never handed out
+  vec2         position;
+  float        angle = 0.f;
+};
+std::vector<PreviousPosition> previous_positions;
+
+float lerpAngle(float from, float to, float alpha) {
+  // go the short way around
+  float delta = to - from;
+  while (delta > M_PI) delta -= 2.f * M_PI;
+  while (delta < -M_PI) delta += 2.f * M_PI;
+  return from + delta * alpha;
+}
+}  // namespace
+
+void capturePreviousPositions() {
+  // assign() reuses the capacity from the previous tick and forgets entities
+  // that lost their position since
+  previous_positions.assign(previous_positions.size(), PreviousPosition());
+  const PositionArrays&      positions = registry.positions.components;
+  const std::vector<Entity>& entities  = registry.positions.entities;
+  for (size_t i = 0; i < entities.size(); i++) {
+    unsigned int index = entities[i].index();
+    if (index >= previous_positions.size()) {
+      previous_positions.resize(index + 1);
+    }
+    PreviousPosition& previous = previous_positions[index];
+    previous.id                = entities[i];
+    previous.position          = positions.position[i];
+    previous.angle             = positions.angle[i];
+  }
+}
+
+Position interpolatedPosition(Entity e, float alpha) {
+  unsigned int i = registry.positions.find(e);
+  assert(i != INVALID_COMPONENT_ID);
+  Position     current = registry.positions.at(i);
+  unsigned int index   = e.index();
+  if (index >= previous_positions.size() ||
+      previous_positions[index].id != (unsigned int)e) {
+    return current;
+  }
+
+  Position previous = current;
+  previous.position = previous_positions[index].position;
+  previous.angle    = previous_positions[index].angle;
+  return blendPositions(previous, current, alpha);
+}
+
+Position blendPositions(const Position& from, const Position& to,
+                        float alpha) {
+  if (glm::distance(from.position, to.position) >
+      INTERPOLATION_SNAP_DISTANCE) {
+    return to;
+  }
+  Position blended = to;
+  blended.position = glm::mix(from.position, to.position, alpha);
+  blended.angle    = lerpAngle(from.angle, to.angle, alpha);
+  return blended;
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "physics.hpp"
+#include "tiny_ecs.hpp"
+
+// Positions further apart than this between two ticks are teleports (room
+// transitions, respawns) and are drawn at the new spot right away
+#define INTERPOLATION_SNAP_DISTANCE 100.f
+
+// Remembers where everything is before a simulation tick, call it right
+// before stepping the systems
+void capturePreviousPositions();
+
+// Where to draw e, alpha of the way from its position before the latest tick
+// to its current one. Entities added during the tick are drawn where they are.
+Position interpolatedPosition(Entity e, float alpha);
+
+// The same blend between two known positions, for when the previous one was
+// looked up earlier (render snapshots). Scale is taken from to.
+Position blendPositions(const Position& from, const Position& to, float alpha);
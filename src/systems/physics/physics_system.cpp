@@ -8,14 +8,18 @@
 #include "boss_factories.hpp"
 #include "consumable_utils.hpp"
 #include "debuff.hpp"
+#include "ecs_command_buffer.hpp"
 #include "enemy_util.hpp"
+#include "hierarchy.hpp"
 #include "map_util.hpp"
 #include "oxygen_system.hpp"
 #include "physics.hpp"
 #include "player_factories.hpp"
+#include "profiler.hpp"
 #include "tiny_ecs_registry.hpp"
 
 void PhysicsSystem::step(float elapsed_ms) {
+  PROFILE_SCOPE("physics.step");
   // Calculate 't value': time loop / loop duration
   float lerp = elapsed_ms / LOOP_DURATION;
 
@@ -23,42 +27,43 @@ void PhysicsSystem::step(float elapsed_ms) {
   if (!registry.deathTimers.has(player)) {
     setPlayerAcceleration();
   } else if (registry.motions.has(player)) {
-    registry.motions.get(player).acceleration = {0.f, 0.f};
+    registry.motions.get_mut(player).acceleration = {0.f, 0.f};
   }
 
   // If dash is on cooldown, we need to decrement the dash cooldown timer
   if (registry.players.get(player).dashCooldownTimer > 0) {
-    Player& player_comp = registry.players.get(player);
+    Player& player_comp = registry.players.get_mut(player);
     player_comp.dashCooldownTimer -= elapsed_ms;
     // change color intensity based on cooldown timer and original cooldown
     // duration
     if (player_comp.dashCooldownTimer <= 0) {
-      registry.colors.get(player_comp.dashIndicator) = vec3(1.0f);
+      registry.colors.get_mut(player_comp.dashIndicator) = vec3(1.0f);
     } else {
       float time_proportion =
           1.0f - (player_comp.dashCooldownTimer / DASH_COOLDOWN_DURATION);
-      registry.colors.get(player_comp.dashIndicator) = vec3(time_proportion);
+      registry.colors.get_mut(player_comp.dashIndicator) =
+          vec3(time_proportion);
     }
   }
 
   // Poof bubbles
-  for (Entity entity : registry.bubbles.entities) {
-    calculateVelocity(entity, lerp);
-    if (registry.motions.has(entity) &&
-        registry.motions.get(entity).velocity.y > 0) {
-      registry.remove_all_components_of(entity);
-    }
-  }
+  registry.view<Bubble, Motion>().each_mut<Motion>(
+      [&](Entity entity, const Bubble& bubble, MotionRef motion) {
+        calculateVelocity(motion, lerp);
+        if (motion.velocity.y > 0) {
+          registry_commands.destroy(entity);
+        }
+      });
 
   // Apply water friction
-  applyWaterFriction(player);
-  for (Entity entity : registry.masses.entities) {
-    if (!registry.players.has(entity)) {
-      registry.motions.get(entity).acceleration = {0.f, 0.f};
-      applyWaterFriction(entity);
-      calculateVelocity(entity, lerp);
-    }
-  }
+  applyWaterFriction(registry.motions.get_mut(player));
+  registry.view<Mass, Motion>(exclude<Player>)
+      .each_mut<Motion>(
+          [&](Entity entity, const Mass& mass, MotionRef motion) {
+            motion.acceleration = {0.f, 0.f};
+            applyWaterFriction(motion);
+            calculateVelocity(motion, lerp);
+          });
 
   // Update player velocity with lerp if player not dashing
   if (!registry.players.get(player).dashing) {
@@ -68,87 +73,72 @@ void PhysicsSystem::step(float elapsed_ms) {
     playerDash(elapsed_ms);
   }
 
-  // Update Entity positions with lerp
-  for (Entity entity : registry.motions.entities) {
-    Motion&   motion   = registry.motions.get(entity);
-    Position& position = registry.positions.get(entity);
-
+  // Update Entity positions with lerp. Resting entities are not written and
+  // keep their version, see changed_since
+  registry.view<Motion, Position>().each([&](Entity           entity,
+                                             ConstMotionRef   motion,
+                                             ConstPositionRef position) {
     if (!debuff_entity_can_move(entity)) {
-      motion.velocity = vec2(0.0f);
+      registry.motions.get_mut(entity).velocity = vec2(0.0f);
     }
 
     if (debuff_entity_knockedback(entity)) {
-      KnockedBack& knockedback = registry.knockedback.get(entity);
-      motion.velocity          = knockedback.knocked_velocity;
+      const KnockedBack& knockedback = registry.knockedback.get(entity);
+      registry.motions.get_mut(entity).velocity = knockedback.knocked_velocity;
     }
 
     if (registry.enemyProjectiles.has(entity) &&
         registry.enemyProjectiles.get(entity).type == ENTITY_TYPE::SHOCKWAVE) {
       // shockwaves don't move, they just expand
-      position.scale += vec2(SHOCKWAVE_GROW_RATE) * lerp;
-    } else {
-      position.position += motion.velocity * lerp;
-    }
-
-    if (registry.players.has(entity)) {
-      Player&   player = registry.players.get(entity);
-      Position& player_mesh_position =
-          registry.positions.get(player.collisionMesh);
-      player_mesh_position.position += motion.velocity * lerp;
-    }
-
-    if (registry.oxygen.has(entity) && entity != player) {
-      // make sure health bars follow moving enemies
-      updateEnemyHealthBarPos(entity);
+      registry.positions.get_mut(entity).scale +=
+          vec2(SHOCKWAVE_GROW_RATE) * lerp;
+    } else if (motion.velocity != vec2(0.f)) {
+      registry.positions.get_mut(entity).position += motion.velocity * lerp;
     }
+  });
 
-    if (registry.emoting.has(entity)) {
-      updateEmotePos(entity);
-    }
-  }
+  // Health bars, emotes, the player's weapon and collision mesh follow the
+  // entities they are attached to
+  updateHierarchy();
 }
 
 void updateWepProjPos(vec2 mouse_pos) {
-  Position& player_comp    = registry.positions.get(player);
-  vec2      player_pos     = player_comp.position;
-  vec2      pos_cursor_vec = mouse_pos - player_pos;
-  vec2      arm_offset     = (player_comp.scale.x < 0)
+  ConstPositionRef player_comp    = registry.positions.get(player);
+  vec2             player_pos     = player_comp.position;
+  vec2             pos_cursor_vec = mouse_pos - player_pos;
+  vec2             arm_offset     = (player_comp.scale.x < 0)
                                  ? vec2(-ARM_OFFSET.x, ARM_OFFSET.y)
                                  : ARM_OFFSET;
   pos_cursor_vec -= arm_offset;
-  float     angle      = atan2(pos_cursor_vec.y, pos_cursor_vec.x);
-  Position& weapon_pos = registry.positions.get(player_weapon);
-  Position& proj_pos   = registry.positions.get(player_projectile);
-  weapon_pos.angle     = (player_comp.scale.x < 0) ? angle + M_PI : angle;
+  float       angle      = atan2(pos_cursor_vec.y, pos_cursor_vec.x);
+  PositionRef weapon_pos = registry.positions.get_mut(player_weapon);
+  PositionRef proj_pos   = registry.positions.get_mut(player_projectile);
+  weapon_pos.angle       = (player_comp.scale.x < 0) ? angle + M_PI : angle;
 
-  float flipped = (player_comp.scale.x < 0) ? -1 : 1;
+  float flipped          = (player_comp.scale.x < 0) ? -1 : 1;
+  vec2  relative_wep_pos = GUN_RELATIVE_POS_FROM_PLAYER;
   switch (wep_type) {
-    case (PROJECTILES::HARPOON):
-      weapon_pos.position =
-          calculate_pos_vec(GUN_RELATIVE_POS_FROM_PLAYER.x * flipped,
-                            player_pos, weapon_pos.angle, arm_offset);
-      break;
     case (PROJECTILES::NET):
-      weapon_pos.position =
-          calculate_pos_vec(NET_GUN_RELATIVE_POS_FROM_PLAYER.x * flipped,
-                            player_pos, weapon_pos.angle, arm_offset);
+      relative_wep_pos = NET_GUN_RELATIVE_POS_FROM_PLAYER;
       break;
     case (PROJECTILES::CONCUSSIVE):
-      weapon_pos.position =
-          calculate_pos_vec(CONCUSSIVE_GUN_RELATIVE_POS_FROM_PLAYER.x * flipped,
-                            player_pos, weapon_pos.angle, arm_offset);
+      relative_wep_pos = CONCUSSIVE_GUN_RELATIVE_POS_FROM_PLAYER;
       break;
     case (PROJECTILES::TORPEDO):
-      weapon_pos.position =
-          calculate_pos_vec(TORPEDO_GUN_RELATIVE_POS_FROM_PLAYER.x * flipped,
-                            player_pos, weapon_pos.angle, arm_offset);
+      relative_wep_pos = TORPEDO_GUN_RELATIVE_POS_FROM_PLAYER;
       break;
     case (PROJECTILES::SHRIMP):
-      weapon_pos.position =
-          calculate_pos_vec(SHRIMP_GUN_RELATIVE_POS_FROM_PLAYER.x * flipped,
-                            player_pos, weapon_pos.angle, arm_offset);
+      relative_wep_pos = SHRIMP_GUN_RELATIVE_POS_FROM_PLAYER;
+      break;
+    case (PROJECTILES::HARPOON):
+    case (PROJECTILES::PROJ_COUNT):
       break;
   }
+  // placed by the hierarchy pass, reaching out along the weapon's angle
+  LocalTransform weapon_local;
+  weapon_local.offset = arm_offset;
+  weapon_local.reach  = relative_wep_pos.x * flipped;
+  attachToParent(player_weapon, player, weapon_local);
 
   if (registry.playerProjectiles.get(player_projectile).is_loaded) {
     vec2 relative_pos = HARPOON_RELATIVE_POS_FROM_GUN;
@@ -181,32 +171,34 @@ void updateWepProjPos(vec2 mouse_pos) {
       proj_pos.scale.x *= -1;
     }
     proj_pos.angle = weapon_pos.angle;
-    proj_pos.position =
-        calculate_pos_vec(relative_pos.x, weapon_pos.position, proj_pos.angle,
-                          {0.f, relative_pos.y});
+
+    LocalTransform proj_local;
+    proj_local.offset = {0.f, relative_pos.y};
+    proj_local.reach  = relative_pos.x;
+    attachToParent(player_projectile, player_weapon, proj_local);
   }
 }
 
 void updatePlayerDirection(vec2 mouse_pos) {
-  Position& player_pos = registry.positions.get(player);
-  bool      mouse_right_face_left =
+  PositionRef player_pos            = registry.positions.get_mut(player);
+  bool        mouse_right_face_left =
       player_pos.position.x < mouse_pos.x && player_pos.scale.x < 0;
   bool mouse_left_face_right =
       player_pos.position.x > mouse_pos.x && player_pos.scale.x > 0;
   if (mouse_right_face_left || mouse_left_face_right) {
-    Player&   player_comp = registry.players.get(player);
-    Position& player_mesh_pos =
-        registry.positions.get(player_comp.collisionMesh);
+    const Player& player_comp = registry.players.get(player);
+    PositionRef player_mesh_pos =
+        registry.positions.get_mut(player_comp.collisionMesh);
 
     player_mesh_pos.scale.x *= -1;
     player_pos.scale.x *= -1;
 
-    Position& weapon = registry.positions.get(player_weapon);
+    PositionRef weapon = registry.positions.get_mut(player_weapon);
     weapon.scale.x *= -1;
     weapon.position.x *= -1;
 
     if (registry.playerProjectiles.get(player_projectile).is_loaded) {
-      Position& projectile = registry.positions.get(player_projectile);
+      PositionRef projectile = registry.positions.get_mut(player_projectile);
       projectile.scale.x *= -1;
       projectile.position.x *= -1;
     }
@@ -214,15 +206,17 @@ void updatePlayerDirection(vec2 mouse_pos) {
 }
 
 void setFiredProjVelo() {
-  PlayerProjectile& proj = registry.playerProjectiles.get(player_projectile);
+  PlayerProjectile& proj =
+      registry.playerProjectiles.get_mut(player_projectile);
   proj.is_loaded         = false;
+  detachFromParent(player_projectile);
   registry.positions.get(player).scale.x < 0 ? proj.is_flipped = true
                                                      : proj.is_flipped = false;
-  float   angle       = registry.positions.get(player_projectile).angle;
-  Motion& proj_motion = registry.motions.get(player_projectile);
-  vec2&   proj_scale  = registry.positions.get(player_projectile).scale;
-  vec2&   proj_original_scale =
-      registry.positions.get(player_projectile).originalScale;
+  float     angle       = registry.positions.get(player_projectile).angle;
+  MotionRef proj_motion = registry.motions.get_mut(player_projectile);
+  vec2&     proj_scale  = registry.positions.get_mut(player_projectile).scale;
+  vec2&     proj_original_scale =
+      registry.positions.get_mut(player_projectile).originalScale;
   float direction = registry.positions.get(player).scale.x /
                     abs(registry.positions.get(player).scale.x);
   switch (proj.type) {
@@ -270,9 +264,9 @@ void setFiredProjVelo() {
 }
 
 void setPlayerAcceleration() {
-  Motion& motion      = registry.motions.get(player);
-  Player& keys        = registry.players.get(player);
-  motion.acceleration = {0.f, 0.f};
+  MotionRef     motion = registry.motions.get_mut(player);
+  const Player& keys   = registry.players.get(player);
+  motion.acceleration  = {0.f, 0.f};
 
   // If player is dashing, double acceleration
   float accel_inc = registry.players.get(player).gliding ? GLIDE_ACCELERATION
@@ -293,7 +287,7 @@ void setPlayerAcceleration() {
 }
 
 void calculatePlayerVelocity(float lerp) {
-  Motion& motion = registry.motions.get(player);
+  MotionRef motion = registry.motions.get_mut(player);
 
   motion.velocity += motion.acceleration * lerp;
 
@@ -324,9 +318,7 @@ void calculatePlayerVelocity(float lerp) {
   }
 }
 
-void calculateVelocity(Entity entity, float lerp) {
-  Motion& motion = registry.motions.get(entity);
-
+void calculateVelocity(MotionRef motion, float lerp) {
   motion.velocity += motion.acceleration * lerp;
 
   if (abs(motion.velocity.x) < abs(motion.acceleration.x * lerp) &&
@@ -340,8 +332,8 @@ void calculateVelocity(Entity entity, float lerp) {
 }
 
 void playerDash(float elapsed_ms) {
-  Motion& motion = registry.motions.get(player);
-  Player& keys   = registry.players.get(player);
+  MotionRef motion = registry.motions.get_mut(player);
+  Player&   keys   = registry.players.get_mut(player);
 
   if (keys.dashTimer > 0) {
     keys.dashTimer -= elapsed_ms;
@@ -378,9 +370,7 @@ void playerDash(float elapsed_ms) {
   }
 }
 
-void applyWaterFriction(Entity entity) {
-  Motion& motion = registry.motions.get(entity);
-
+void applyWaterFriction(MotionRef motion) {
   float water_friction = WATER_FRICTION;
   // Keep this here just in case, but acceleration by friction is NOT
   // proportional to mass, which is why we can use a constant
@@ -403,12 +393,12 @@ Entity createGeyserBubble(RenderSystem* renderer, vec2 position) {
   // Reserve an entity
   auto entity = Entity();
   // physics and pos
-  Position& pos = registry.positions.emplace(entity);
-  pos.angle     = 0.f;
-  pos.position  = position;
-  pos.scale     = BUBBLE_SCALE_FACTOR * BUBBLE_BOUNDING_BOX;
+  PositionRef pos = registry.positions.emplace(entity);
+  pos.angle       = 0.f;
+  pos.position    = position;
+  pos.scale       = BUBBLE_SCALE_FACTOR * BUBBLE_BOUNDING_BOX;
 
-  Motion& motion      = registry.motions.emplace(entity);
+  MotionRef motion    = registry.motions.emplace(entity);
   motion.acceleration = {0.f, WATER_FRICTION};
   motion.velocity     = INITIAL_BUBBLE_VELOCITY;
 
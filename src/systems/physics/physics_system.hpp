@@ -67,9 +67,9 @@ void setPlayerAcceleration();
 
 void calculatePlayerVelocity(float lerp);
 
-void calculateVelocity(Entity entity, float lerp);
+void calculateVelocity(MotionRef motion, float lerp);
 
 
 void playerDash(float elapsed_ms);
 
-void applyWaterFriction(Entity entity);
\ No newline at end of file
+void applyWaterFriction(MotionRef motion);
\ No newline at end of file
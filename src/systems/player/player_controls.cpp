@@ -1,6 +1,7 @@
 #include "player_controls.hpp"
 
 #include "collision_system.hpp"
+#include "hierarchy.hpp"
 #include "oxygen_system.hpp"
 #include "physics_system.hpp"
 #include "player_factories.hpp"
@@ -55,8 +56,8 @@ bool player_movement(int key, int action, int mod) {
     return false;
   }
 
-  Player& keys          = registry.players.get(player);
-  Oxygen& player_oxygen = registry.oxygen.get(player);
+  Player& keys          = registry.players.get_mut(player);
+  Oxygen& player_oxygen = registry.oxygen.get_mut(player);
 
   // WASD Movement Keys
   if (!registry.deathTimers.has(player)) {
@@ -97,16 +98,16 @@ bool player_movement(int key, int action, int mod) {
     }
     // choose correct player texture based on player_texture_num
     if (player_texture_num < 2.f) {
-      registry.renderRequests.get(player).used_texture =
+      registry.renderRequests.get_mut(player).used_texture =
           TEXTURE_ASSET_ID::PLAYER1;
     } else if (player_texture_num < 4.f) {
-      registry.renderRequests.get(player).used_texture =
+      registry.renderRequests.get_mut(player).used_texture =
           TEXTURE_ASSET_ID::PLAYER2;
     } else if (player_texture_num < 6.f) {
-      registry.renderRequests.get(player).used_texture =
+      registry.renderRequests.get_mut(player).used_texture =
           TEXTURE_ASSET_ID::PLAYER3;
     } else {
-      registry.renderRequests.get(player).used_texture =
+      registry.renderRequests.get_mut(player).used_texture =
           TEXTURE_ASSET_ID::PLAYER2;
     }
   }
@@ -114,14 +115,14 @@ bool player_movement(int key, int action, int mod) {
   // Dashing (In case shift is held)
   if (key == GLFW_KEY_LEFT_SHIFT) {
     if (action == GLFW_PRESS) {
-      registry.players.get(player).gliding = true;
-      player_oxygen.rate                   = PLAYER_OXYGEN_RATE * 3;
+      registry.players.get_mut(player).gliding = true;
+      player_oxygen.rate                       = PLAYER_OXYGEN_RATE * 3;
       if (!registry.sounds.has(player)) {
         registry.sounds.insert(Entity(), Sound(SOUND_ASSET_ID::PLAYER_GLIDE));
       }
     } else if (action == GLFW_RELEASE) {
-      registry.players.get(player).gliding = false;
-      player_oxygen.rate                   = PLAYER_OXYGEN_RATE;
+      registry.players.get_mut(player).gliding = false;
+      player_oxygen.rate                       = PLAYER_OXYGEN_RATE;
     }
   }
 
@@ -130,14 +131,14 @@ bool player_movement(int key, int action, int mod) {
         keys.upHeld || keys.downHeld || keys.leftHeld || keys.rightHeld;
     if (action == GLFW_PRESS && atLeastOneKey) {
       if (registry.players.get(player).dashCooldownTimer <= 0) {
-        Player&         player_comp = registry.players.get(player);
+        Player&         player_comp = registry.players.get_mut(player);
         Entity          burstCost   = Entity();
         OxygenModifier& oxyBurstCost =
             registry.oxygenModifiers.emplace(burstCost);
         oxyBurstCost.amount = PLAYER_DASH_COST;
         player_comp.dashing = true;
         if (registry.colors.has(player_comp.dashIndicator)) {
-          registry.colors.get(player_comp.dashIndicator) = vec3(0.1f);
+          registry.colors.get_mut(player_comp.dashIndicator) = vec3(0.1f);
         }
         modifyOxygen(player, burstCost);
       }
@@ -206,7 +207,7 @@ bool player_scroll(double xOffset, double yOffset) {
 
   PROJECTILES new_wep_type = PROJECTILES(curr_wep_type);
 
-  Inventory& inv = registry.inventory.get(player);
+  const Inventory& inv = registry.inventory.get(player);
   if (new_wep_type == PROJECTILES::NET && !inv.nets) {
     wep_type = PROJECTILES::NET;
     return player_scroll(xOffset, yOffset);
@@ -246,7 +247,7 @@ Update inventory based on projectile being fired
 Returns true if had inventory to shoot, returns false if no inventory to shoot.
 */
 bool updateInventory(RenderSystem* renderer, PROJECTILES type) {
-  Inventory& inv = registry.inventory.get(player);
+  Inventory& inv = registry.inventory.get_mut(player);
   switch (type) {
     case PROJECTILES::NET:
       if (!inv.nets) {
@@ -328,10 +329,10 @@ void swapWeps(Entity swapped, Entity swapper, PROJECTILES projectile) {
   // None of this is necessary if the swapper projectile hasn't collided yet
   if (registry.playerProjectiles.get(swapper).is_loaded) {
     // Setting initial positon values
-    Position& position = registry.positions.emplace(swapper);
-    position.scale     = scale;
+    PositionRef position = registry.positions.emplace(swapper);
+    position.scale       = scale;
 
-    Position& player_pos = registry.positions.get(player);
+    ConstPositionRef player_pos = registry.positions.get(player);
     if (player_pos.scale.x < 0) {
       position.scale.x *= -1;
     }
@@ -339,7 +340,7 @@ void swapWeps(Entity swapped, Entity swapper, PROJECTILES projectile) {
     // Setting initial motion values
     // Motion will be used when acting as a projectile and is not loaded into a
     // Gun
-    Motion& motion      = registry.motions.emplace(swapper);
+    MotionRef motion    = registry.motions.emplace(swapper);
     motion.velocity     = {0.f, 0.f};
     motion.acceleration = {0, 0};
 
@@ -376,16 +377,16 @@ void handleGunSwap(Entity swapped, Entity swapper, PROJECTILES projectile) {
   }
 
   // Setting initial position values
-  Position& position = registry.positions.emplace(swapper);
-  position.scale     = scale;
+  PositionRef position = registry.positions.emplace(swapper);
+  position.scale       = scale;
 
-  Position& player_pos = registry.positions.get(player);
+  ConstPositionRef player_pos = registry.positions.get(player);
   if (player_pos.scale.x < 0) {
     position.scale.x *= -1;
   }
 
   // Setting initial motion values
-  Motion& motion      = registry.motions.emplace(swapper);
+  MotionRef motion    = registry.motions.emplace(swapper);
   motion.velocity     = {0.f, 0.f};
   motion.acceleration = {0, 0};
 
@@ -398,7 +399,7 @@ void handleWeaponSwapping(RenderSystem* renderer, int key) {
   if (!registry.inventory.has(player)) {
     return;
   }
-  Inventory& inv = registry.inventory.get(player);
+  const Inventory& inv = registry.inventory.get(player);
 
   // Switch to harpoon gun
   if (key == GLFW_KEY_1 && player_projectile != harpoon) {
@@ -457,6 +458,7 @@ bool destroyGunOrProjectile(Entity entity) {
     registry.motions.remove(entity);
     registry.positions.remove(entity);
     registry.renderRequests.remove(entity);
+    detachFromParent(entity);
     return true;
   }
   return false;
@@ -1,5 +1,6 @@
 #include "player_factories.hpp"
 
+#include "hierarchy.hpp"
 #include "tiny_ecs_registry.hpp"
 
 /********************************************************************************
@@ -17,13 +18,13 @@ Entity createPlayer(RenderSystem* renderer, vec2 pos) {
   registry.meshPtrs.emplace(entity, &mesh);
 
   // Setting initial position values
-  Position& position = registry.positions.emplace(entity);
-  position.position  = pos;
-  position.angle     = 0.f;
-  position.scale     = PLAYER_SCALE_FACTOR * PLAYER_BOUNDING_BOX;
+  PositionRef position = registry.positions.emplace(entity);
+  position.position    = pos;
+  position.angle       = 0.f;
+  position.scale       = PLAYER_SCALE_FACTOR * PLAYER_BOUNDING_BOX;
 
   // Setting initial motion values
-  Motion& motion      = registry.motions.emplace(entity);
+  MotionRef motion    = registry.motions.emplace(entity);
   motion.velocity     = {0.f, 0.f};
   motion.acceleration = {0, 0};
 
@@ -45,12 +46,14 @@ Entity createPlayer(RenderSystem* renderer, vec2 pos) {
   registry.meshPtrs.emplace(collisionEntity, &collisionMesh);
 
   // Setting initial position values
-  Position& collisionMeshPosition = registry.positions.emplace(collisionEntity);
-  collisionMeshPosition.position  = pos;
-  collisionMeshPosition.angle     = 0.f;
-  collisionMeshPosition.scale     = PLAYER_SCALE_FACTOR * PLAYER_BOUNDING_BOX;
+  PositionRef collisionMeshPosition =
+      registry.positions.emplace(collisionEntity);
+  collisionMeshPosition.position = pos;
+  collisionMeshPosition.angle    = 0.f;
+  collisionMeshPosition.scale    = PLAYER_SCALE_FACTOR * PLAYER_BOUNDING_BOX;
 
   registry.playersCollisionMeshes.emplace(collisionEntity);
+  attachToParent(collisionEntity, entity);
   // Uncomment to render the collision mesh.
   // registry.renderRequests.insert(
   //     collisionEntity, {TEXTURE_ASSET_ID::TEXTURE_COUNT,
@@ -78,11 +81,11 @@ Entity createLoadedGun(RenderSystem* renderer, vec2 playerPosition,
   registry.meshPtrs.emplace(entity, &mesh);
 
   // Setting initial position values
-  Position& position = registry.positions.emplace(entity);
-  position.scale     = GUN_SCALE_FACTOR * GUN_BOUNDING_BOX;
+  PositionRef position = registry.positions.emplace(entity);
+  position.scale       = GUN_SCALE_FACTOR * GUN_BOUNDING_BOX;
 
   // Setting initial motion values
-  Motion& motion      = registry.motions.emplace(entity);
+  MotionRef motion    = registry.motions.emplace(entity);
   motion.velocity     = {0.f, 0.f};
   motion.acceleration = {0, 0};
 
@@ -162,13 +165,13 @@ Entity loadHarpoon(RenderSystem* renderer, vec2 gunPosition) {
   registry.meshPtrs.emplace(entity, &mesh);
 
   // Setting initial positon values
-  Position& position = registry.positions.emplace(entity);
-  position.scale     = HARPOON_SCALE_FACTOR * HARPOON_BOUNDING_BOX;
+  PositionRef position = registry.positions.emplace(entity);
+  position.scale       = HARPOON_SCALE_FACTOR * HARPOON_BOUNDING_BOX;
 
   // Setting initial motion values
   // Motion will be used when acting as a projectile and is not loaded into a
   // Gun
-  Motion& motion      = registry.motions.emplace(entity);
+  MotionRef motion    = registry.motions.emplace(entity);
   motion.velocity     = {0.f, 0.f};
   motion.acceleration = {0, 0};
 
@@ -291,9 +294,9 @@ Entity makeExplosion(RenderSystem* renderer, vec2 pos, float expiry_time,
   registry.meshPtrs.emplace(entity, &mesh);
 
   // Setting initial position values
-  Position& position = registry.positions.emplace(entity);
-  position.position  = pos;
-  position.scale     = vec2(0.f);
+  PositionRef position = registry.positions.emplace(entity);
+  position.position    = pos;
+  position.scale       = vec2(0.f);
 
   // Put into Explosions
   Explosion& explosion  = registry.explosions.emplace(entity);
@@ -356,14 +359,14 @@ void createOxygenTank(RenderSystem* renderer, Entity& player, vec2 pos) {
   registry.meshPtrs.emplace(playerBackgroundBar, &mesh);
 
   // Initialize the position, scale, and physics components
-  auto& posComp    = registry.positions.emplace(playerOxygenBar);
+  auto posComp     = registry.positions.emplace(playerOxygenBar);
   posComp.angle    = 0.f;
   posComp.position = pos;
   posComp.scale    = PLAYER_OXYGEN_SCALE_FACTOR * PLAYER_OXYGEN_BOUNDING_BOX;
   posComp.originalScale =
       PLAYER_OXYGEN_SCALE_FACTOR * PLAYER_OXYGEN_BOUNDING_BOX;
 
-  auto& backgroundPos    = registry.positions.emplace(playerBackgroundBar);
+  auto backgroundPos     = registry.positions.emplace(playerBackgroundBar);
   backgroundPos.angle    = 0.f;
   backgroundPos.position = pos + vec2(0.f, -43.f);
   backgroundPos.scale =
@@ -408,7 +411,7 @@ void createDashIndicator(RenderSystem* renderer, Entity& player, vec2 pos) {
   registry.meshPtrs.emplace(dashIndicator, &mesh);
 
   // Initialize the position, scale, and physics components
-  auto& posComp         = registry.positions.emplace(dashIndicator);
+  auto posComp          = registry.positions.emplace(dashIndicator);
   posComp.angle         = 0.f;
   posComp.position      = pos;
   posComp.scale         = PLAYER_SCALE_FACTOR * PLAYER_BOUNDING_BOX * 0.85f;
@@ -421,7 +424,7 @@ void createDashIndicator(RenderSystem* renderer, Entity& player, vec2 pos) {
                       GEOMETRY_BUFFER_ID::SPRITE});
 
   if (registry.players.has(player)) {
-    registry.players.get(player).dashIndicator = dashIndicator;
+    registry.players.get_mut(player).dashIndicator = dashIndicator;
   }
 
   registry.colors.insert(dashIndicator, vec3(1.0f));
@@ -433,7 +436,7 @@ void createDashIndicator(RenderSystem* renderer, Entity& player, vec2 pos) {
  * @param player
  ********************************************************************************/
 Entity& getPlayerWeapon() {
-  return registry.players.get(player).weapon;
+  return registry.players.get_mut(player).weapon;
 }
 
 /********************************************************************************
@@ -443,5 +446,5 @@ Entity& getPlayerWeapon() {
  ********************************************************************************/
 Entity& getPlayerProjectile() {
   Entity& player_weapon = getPlayerWeapon();
-  return registry.playerWeapons.get(player_weapon).projectile;
+  return registry.playerWeapons.get_mut(player_weapon).projectile;
 }
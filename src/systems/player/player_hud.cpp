@@ -27,7 +27,7 @@ void createInventoryHud(RenderSystem* renderer) {
   registry.meshPtrs.emplace(inventoryHud, &mesh);
 
   // Initialize the position and scale
-  auto& inventoryHudPos    = registry.positions.emplace(inventoryHud);
+  auto inventoryHudPos     = registry.positions.emplace(inventoryHud);
   inventoryHudPos.angle    = 0.f;
   inventoryHudPos.position = INVENTORY_HUD_POS;
   inventoryHudPos.scale =
@@ -97,7 +97,7 @@ void createHarpoonCounter(RenderSystem* renderer) {
   registry.meshPtrs.emplace(harpoonCounter, &mesh);
 
   // Initialize the position and scale
-  auto& harpoonCounterPos    = registry.positions.emplace(harpoonCounter);
+  auto harpoonCounterPos     = registry.positions.emplace(harpoonCounter);
   harpoonCounterPos.angle    = 0.f;
   harpoonCounterPos.position = HARPOON_COUNTER_POS;
   harpoonCounterPos.scale =
@@ -112,7 +112,7 @@ void createHarpoonCounter(RenderSystem* renderer) {
 
   // inventory type
   registry.inventoryCounters.emplace(harpoonCounter);
-  registry.inventoryCounters.get(harpoonCounter).inventoryType =
+  registry.inventoryCounters.get_mut(harpoonCounter).inventoryType =
       INVENTORY::HARPOON;
 
   // request rendering
@@ -135,8 +135,9 @@ void updateInventoryCounter(RenderSystem* renderer, INVENTORY inventoryType) {
     if (registry.inventoryCounters.get(inventoryCounterText).inventoryType ==
             inventoryType &&
         registry.textRequests.has(inventoryCounterText)) {
-      registry.textRequests.get(inventoryCounterText).text =
-          getInvCountString(inventoryType);
+      std::string count = getInvCountString(inventoryType);
+      registry.textRequests.get_mut(inventoryCounterText)
+          .text.assign(count.begin(), count.end());
     }
   }
 }
@@ -149,8 +150,8 @@ void updateInventoryCounter(RenderSystem* renderer, INVENTORY inventoryType) {
  * @note guard for player having inventory in updateInventoryCounter(...)
  ********************************************************************************/
 std::string getInvCountString(INVENTORY inventoryType) {
-  Inventory&   playerInventory = registry.inventory.get(player);
-  unsigned int invCount        = 0;
+  const Inventory& playerInventory = registry.inventory.get(player);
+  unsigned int invCount            = 0;
   switch (inventoryType) {
     case INVENTORY::NET:
       invCount = playerInventory.nets;
@@ -199,12 +200,12 @@ void changeSelectedCounterColour(INVENTORY inventoryType) {
     return;
   }
   for (Entity& entity : registry.inventoryCounters.entities) {
-    InventoryCounter& inventoryCounter = registry.inventoryCounters.get(entity);
+    const InventoryCounter& inventoryCounter = registry.inventoryCounters.get(entity);
 
     if (inventoryCounter.inventoryType != inventoryType) {
-      registry.colors.get(entity) = UNSELECTED_COUNTER_TEXT_COLOUR;
+      registry.colors.get_mut(entity) = UNSELECTED_COUNTER_TEXT_COLOUR;
     } else {
-      registry.colors.get(entity) = SELECTED_COUNTER_TEXT_COLOUR;
+      registry.colors.get_mut(entity) = SELECTED_COUNTER_TEXT_COLOUR;
     }
   }
 }
@@ -218,7 +219,7 @@ void collectRedKey(RenderSystem* renderer) {
   if (!registry.inventory.has(player)) {
     return;
   }
-  Inventory& playerInventory = registry.inventory.get(player);
+  Inventory& playerInventory = registry.inventory.get_mut(player);
   Entity     redKey          = Entity();
 
   // Store a reference to the potentially re-used mesh object
@@ -226,7 +227,7 @@ void collectRedKey(RenderSystem* renderer) {
   registry.meshPtrs.emplace(redKey, &mesh);
 
   // Set position values
-  Position& redKeyPos     = registry.positions.emplace(redKey);
+  PositionRef redKeyPos   = registry.positions.emplace(redKey);
   redKeyPos.angle         = 0.f;
   redKeyPos.position      = RED_KEY_POS;
   redKeyPos.scale         = RED_KEY_SCALE_FACTOR * RED_KEY_BOUNDING_BOX;
@@ -257,7 +258,7 @@ void collectBlueKey(RenderSystem* renderer) {
   if (!registry.inventory.has(player)) {
     return;
   }
-  Inventory& playerInventory = registry.inventory.get(player);
+  Inventory& playerInventory = registry.inventory.get_mut(player);
   Entity     blueKey         = Entity();
 
   // Store a reference to the potentially re-used mesh object
@@ -265,7 +266,7 @@ void collectBlueKey(RenderSystem* renderer) {
   registry.meshPtrs.emplace(blueKey, &mesh);
 
   // Set position values
-  Position& blueKeyPos     = registry.positions.emplace(blueKey);
+  PositionRef blueKeyPos   = registry.positions.emplace(blueKey);
   blueKeyPos.angle         = 0.f;
   blueKeyPos.position      = BLUE_KEY_POS;
   blueKeyPos.scale         = BLUE_KEY_SCALE_FACTOR * BLUE_KEY_BOUNDING_BOX;
@@ -296,7 +297,7 @@ void collectYellowKey(RenderSystem* renderer) {
   if (!registry.inventory.has(player)) {
     return;
   }
-  Inventory& playerInventory = registry.inventory.get(player);
+  Inventory& playerInventory = registry.inventory.get_mut(player);
   Entity     yellowKey       = Entity();
 
   // Store a reference to the potentially re-used mesh object
@@ -304,10 +305,10 @@ void collectYellowKey(RenderSystem* renderer) {
   registry.meshPtrs.emplace(yellowKey, &mesh);
 
   // Set position values
-  Position& yellowKeyPos = registry.positions.emplace(yellowKey);
-  yellowKeyPos.angle     = 0.f;
-  yellowKeyPos.position  = YELLOW_KEY_POS;
-  yellowKeyPos.scale     = YELLOW_KEY_SCALE_FACTOR * YELLOW_KEY_BOUNDING_BOX;
+  PositionRef yellowKeyPos = registry.positions.emplace(yellowKey);
+  yellowKeyPos.angle       = 0.f;
+  yellowKeyPos.position    = YELLOW_KEY_POS;
+  yellowKeyPos.scale       = YELLOW_KEY_SCALE_FACTOR * YELLOW_KEY_BOUNDING_BOX;
   yellowKeyPos.originalScale = yellowKeyPos.scale;
 
   // add to keys
@@ -336,7 +337,7 @@ bool isKeyCollected(Objective keyType) {
     printf("Player has no inventory\n");
     return false;
   }
-  Inventory& playerInventory = registry.inventory.get(player);
+  const Inventory& playerInventory = registry.inventory.get(player);
   switch (keyType) {
     case Objective::RED_KEY:
       return playerInventory.redKey;
@@ -370,7 +371,7 @@ void createCommunicationHud(RenderSystem* renderer) {
   registry.meshPtrs.emplace(communicationsHud, &mesh);
 
   // Initialize the position and scale
-  auto& communicationsHudPos    = registry.positions.emplace(communicationsHud);
+  auto communicationsHudPos     = registry.positions.emplace(communicationsHud);
   communicationsHudPos.angle    = 0.f;
   communicationsHudPos.position = COMMUNICATION_HUD_POS;
   communicationsHudPos.scale =
@@ -413,7 +414,7 @@ void createDialogue(RenderSystem* renderer, std::string line1,
   if (isLine1New || isLine2New) {
     registry.sounds.insert(Entity(), Sound(SOUND_ASSET_ID::NOTIFICATION));
     for (Entity entity : registry.notifications.entities) {
-      Notification& notification = registry.notifications.get(entity);
+      Notification& notification = registry.notifications.get_mut(entity);
       if (notification.isCommunicationNotification) {
         notification.notificationTimer = NOTIFICATION_TIMER;
       }
@@ -553,7 +554,7 @@ void overCollectDialogue(RenderSystem* renderer) {
  ********************************************************************************/
 void update_notification_timers(float elapsed_ms_since_last_update) {
   for (Entity entity : registry.notifications.entities) {
-    Notification& notification = registry.notifications.get(entity);
+    Notification& notification = registry.notifications.get_mut(entity);
     notification.notificationTimer =
         max(0.f, notification.notificationTimer - elapsed_ms_since_last_update);
   }
@@ -3,6 +3,7 @@
 
 #include "../ext/stb_image/stb_image.h"
 #include "common.hpp"
+#include "ecs_memory.hpp"
 #include "misc.hpp"
 // Sets the brightness of the screen
 struct ScreenState {
@@ -43,8 +44,8 @@ struct Character {
 };
 
 struct TextRequest {
-  std::string text;
-  float       textScale;
+  PooledString text;
+  float        textScale;
 };
 
 struct SaveStatus {};
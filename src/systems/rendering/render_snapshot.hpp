@@ -0,0 +1,56 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "common.hpp"
+#include "components.hpp"
+#include "physics.hpp"
+
+// One textured mesh to draw, with everything its shader reads copied out of
+// the registry
+struct SpriteDraw {
+  // Where it was before the latest tick and where it is now, blended at draw
+  // time, see interpolation.hpp
+  Position previous;
+  Position current;
+
+  EFFECT_ASSET_ID    effect;
+  GEOMETRY_BUFFER_ID geometry;
+  TEXTURE_ASSET_ID   texture;
+  vec3               color = vec3(1);
+
+  // Shader inputs, only filled in for the effects that use them
+  bool  is_low_oxygen      = false;
+  float damage_timer       = 0.f;
+  bool  is_stunned         = false;
+  bool  is_angry           = false;
+  float notification_timer = 0.f;
+};
+
+struct TextDraw {
+  Position    previous;
+  Position    current;
+  std::string text;
+  float       scale;
+  vec3        color;
+};
+
+// Everything the renderer needs for a frame, taken from the registry after
+// the frame's last simulation tick. Rendering reads only this, so it can run
+// on another thread while the simulation moves on to the next frame.
+struct RenderSnapshot {
+  std::vector<SpriteDraw> sprites;  // in drawing order, back to front
+  std::vector<TextDraw>   texts;
+
+  float darken_screen_factor = -1.f;
+  bool  is_paused            = false;
+  int   framebuffer_width    = 0;
+  int   framebuffer_height   = 0;
+
+  // Keeps the capacity, snapshots are reused from frame to frame
+  void clear() {
+    sprites.clear();
+    texts.clear();
+  }
+};
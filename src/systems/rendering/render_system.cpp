@@ -3,12 +3,53 @@
 
 #include <SDL.h>
 
+#include "interpolation.hpp"
 #include "misc.hpp"
 #include "oxygen_system.hpp"
+#include "profiler.hpp"
 #include "tiny_ecs_registry.hpp"
 
-void RenderSystem::drawTexturedMesh(Entity entity, const mat3& projection) {
-  Position& position = registry.positions.get(entity);
+void RenderSystem::captureSprite(RenderSnapshot& snapshot, Entity entity) {
+  assert(registry.renderRequests.has(entity));
+  const RenderRequest& render_request = registry.renderRequests.get(entity);
+
+  SpriteDraw sprite;
+  sprite.previous = interpolatedPosition(entity, 0.f);
+  sprite.current  = registry.positions.get(entity);
+  sprite.effect   = render_request.used_effect;
+  sprite.geometry = render_request.used_geometry;
+  sprite.texture  = render_request.used_texture;
+  if (registry.colors.has(entity)) {
+    sprite.color = registry.colors.get(entity);
+  }
+
+  if (sprite.effect == EFFECT_ASSET_ID::TEXTURED_OXYGEN) {
+    sprite.is_low_oxygen = registry.lowOxygen.has(entity);
+  } else if (sprite.effect == EFFECT_ASSET_ID::PLAYER ||
+             sprite.effect == EFFECT_ASSET_ID::ENEMY) {
+    // the weapon flashes along with the player holding it
+    Entity owner         = entity == player_weapon ? player : entity;
+    sprite.damage_timer  = registry.attacked.has(owner)
+                               ? registry.attacked.get(owner).timer
+                               : 0.0f;
+    sprite.is_stunned    = registry.stunned.has(owner);
+    // only do angry shader for sharkman
+    sprite.is_angry = registry.bosses.has(entity) &&
+                      registry.bosses.get(entity).type ==
+                          ENTITY_TYPE::SHARKMAN &&
+                      registry.bosses.get(entity).is_angry;
+  } else if (sprite.effect == EFFECT_ASSET_ID::COMMUNICATIONS) {
+    sprite.notification_timer =
+        registry.notifications.has(entity)
+            ? registry.notifications.get(entity).notificationTimer
+            : 0.0f;
+  }
+  snapshot.sprites.push_back(sprite);
+}
+
+void RenderSystem::drawTexturedMesh(const SpriteDraw& sprite, float alpha,
+                                    const mat3& projection) {
+  Position position = blendPositions(sprite.previous, sprite.current, alpha);
   // Transformation code, see Rendering and Transformation in the template
   // specification for more info Incrementally updates transformation matrix,
   // thus ORDER IS IMPORTANT
@@ -17,10 +58,7 @@ void RenderSystem::drawTexturedMesh(Entity entity, const mat3& projection) {
   transform.rotate(position.angle);
   transform.scale(position.scale);
 
-  assert(registry.renderRequests.has(entity));
-  const RenderRequest& render_request = registry.renderRequests.get(entity);
-
-  const GLuint used_effect_enum = (GLuint)render_request.used_effect;
+  const GLuint used_effect_enum = (GLuint)sprite.effect;
   assert(used_effect_enum != (GLuint)EFFECT_ASSET_ID::EFFECT_COUNT);
   const GLuint program = (GLuint)effects[used_effect_enum];
 
@@ -28,9 +66,9 @@ void RenderSystem::drawTexturedMesh(Entity entity, const mat3& projection) {
   glUseProgram(program);
   gl_has_errors();
 
-  assert(render_request.used_geometry != GEOMETRY_BUFFER_ID::GEOMETRY_COUNT);
-  const GLuint vbo = vertex_buffers[(GLuint)render_request.used_geometry];
-  const GLuint ibo = index_buffers[(GLuint)render_request.used_geometry];
+  assert(sprite.geometry != GEOMETRY_BUFFER_ID::GEOMETRY_COUNT);
+  const GLuint vbo = vertex_buffers[(GLuint)sprite.geometry];
+  const GLuint ibo = index_buffers[(GLuint)sprite.geometry];
 
   // Setting vertex and index buffers
   glBindBuffer(GL_ARRAY_BUFFER, vbo);
@@ -38,12 +76,12 @@ void RenderSystem::drawTexturedMesh(Entity entity, const mat3& projection) {
   gl_has_errors();
 
   // Input data location as in the vertex buffer
-  if (render_request.used_effect == EFFECT_ASSET_ID::TEXTURED ||
-      render_request.used_effect == EFFECT_ASSET_ID::TEXTURED_OXYGEN ||
-      render_request.used_effect == EFFECT_ASSET_ID::AMBIENT ||
-      render_request.used_effect == EFFECT_ASSET_ID::PLAYER ||
-      render_request.used_effect == EFFECT_ASSET_ID::ENEMY ||
-      render_request.used_effect == EFFECT_ASSET_ID::COMMUNICATIONS) {
+  if (sprite.effect == EFFECT_ASSET_ID::TEXTURED ||
+      sprite.effect == EFFECT_ASSET_ID::TEXTURED_OXYGEN ||
+      sprite.effect == EFFECT_ASSET_ID::AMBIENT ||
+      sprite.effect == EFFECT_ASSET_ID::PLAYER ||
+      sprite.effect == EFFECT_ASSET_ID::ENEMY ||
+      sprite.effect == EFFECT_ASSET_ID::COMMUNICATIONS) {
     GLint in_position_loc = glGetAttribLocation(program, "in_position");
     GLint in_texcoord_loc = glGetAttribLocation(program, "in_texcoord");
     gl_has_errors();
@@ -60,54 +98,32 @@ void RenderSystem::drawTexturedMesh(Entity entity, const mat3& projection) {
         (void*)sizeof(
             vec3));  // note the stride to skip the preceeding vertex position
 
-    if (render_request.used_effect == EFFECT_ASSET_ID::TEXTURED_OXYGEN) {
+    if (sprite.effect == EFFECT_ASSET_ID::TEXTURED_OXYGEN) {
       GLuint time_uloc = glGetUniformLocation(program, "time");
       GLuint is_low_oxygen_uloc =
           glGetUniformLocation(program, "is_low_oxygen");
       gl_has_errors();
       glUniform1f(time_uloc, (float)(glfwGetTime() * 10.0f));
-      glUniform1i(is_low_oxygen_uloc, registry.lowOxygen.has(entity));
+      glUniform1i(is_low_oxygen_uloc, sprite.is_low_oxygen);
 
       gl_has_errors();
     }
 
-    if (render_request.used_effect == EFFECT_ASSET_ID::PLAYER ||
-        render_request.used_effect == EFFECT_ASSET_ID::ENEMY) {
+    if (sprite.effect == EFFECT_ASSET_ID::PLAYER ||
+        sprite.effect == EFFECT_ASSET_ID::ENEMY) {
       GLuint damage_timer_uloc = glGetUniformLocation(program, "damageTimer");
       GLuint stun_timer_uloc   = glGetUniformLocation(program, "stunned");
       GLuint angry_timer_uloc  = glGetUniformLocation(program, "is_angry");
       gl_has_errors();
-      glUniform1f(damage_timer_uloc, registry.attacked.has(entity)
-                                         ? registry.attacked.get(entity).timer
-                                         : 0.0f);
-      glUniform1f(stun_timer_uloc, registry.stunned.has(entity) ? true : false);
-      if (entity == player_weapon) {
-        glUniform1f(stun_timer_uloc,
-                    registry.stunned.has(player) ? true : false);
-        glUniform1f(damage_timer_uloc, registry.attacked.has(player)
-                                           ? registry.attacked.get(player).timer
-                                           : 0.0f);
-      }
-      // only do angry shader for sharkman
-      if (registry.bosses.has(entity) &&
-          registry.bosses.get(entity).type == ENTITY_TYPE::SHARKMAN) {
-        glUniform1f(angry_timer_uloc, registry.bosses.get(entity).is_angry);
-      } else {
-        glUniform1f(angry_timer_uloc, false);
-      }
-      // glUniform1f(angry_timer_uloc, registry.bosses.has(entity)
-      //                                   ?
-      //                                   registry.bosses.get(entity).is_angry
-      //                                   : false);
+      glUniform1f(damage_timer_uloc, sprite.damage_timer);
+      glUniform1f(stun_timer_uloc, sprite.is_stunned);
+      glUniform1f(angry_timer_uloc, sprite.is_angry);
       gl_has_errors();
-    } else if (render_request.used_effect == EFFECT_ASSET_ID::COMMUNICATIONS) {
+    } else if (sprite.effect == EFFECT_ASSET_ID::COMMUNICATIONS) {
       GLuint notification_timer_uloc =
           glGetUniformLocation(program, "notificationTimer");
       gl_has_errors();
-      glUniform1f(notification_timer_uloc,
-                  registry.notifications.has(entity)
-                      ? registry.notifications.get(entity).notificationTimer
-                      : 0.0f);
+      glUniform1f(notification_timer_uloc, sprite.notification_timer);
       gl_has_errors();
     }
 
@@ -115,14 +131,11 @@ void RenderSystem::drawTexturedMesh(Entity entity, const mat3& projection) {
     glActiveTexture(GL_TEXTURE0);
     gl_has_errors();
 
-    assert(registry.renderRequests.has(entity));
-    GLuint texture_id =
-        texture_gl_handles[(GLuint)registry.renderRequests.get(entity)
-                               .used_texture];
+    GLuint texture_id = texture_gl_handles[(GLuint)sprite.texture];
 
     glBindTexture(GL_TEXTURE_2D, texture_id);
     gl_has_errors();
-  } else if (render_request.used_effect == EFFECT_ASSET_ID::COLLISION_MESH) {
+  } else if (sprite.effect == EFFECT_ASSET_ID::COLLISION_MESH) {
     GLint in_position_loc = glGetAttribLocation(program, "in_position");
     GLint in_color_loc    = glGetAttribLocation(program, "in_color");
     gl_has_errors();
@@ -140,10 +153,8 @@ void RenderSystem::drawTexturedMesh(Entity entity, const mat3& projection) {
   }
 
   // Getting uniform locations for glUniform* calls
-  GLint      color_uloc = glGetUniformLocation(program, "fcolor");
-  const vec3 color =
-      registry.colors.has(entity) ? registry.colors.get(entity) : vec3(1);
-  glUniform3fv(color_uloc, 1, (float*)&color);
+  GLint color_uloc = glGetUniformLocation(program, "fcolor");
+  glUniform3fv(color_uloc, 1, (float*)&sprite.color);
   gl_has_errors();
 
   // Get number of indices from index buffer, which has elements uint16_t
@@ -169,18 +180,14 @@ void RenderSystem::drawTexturedMesh(Entity entity, const mat3& projection) {
 
 // draw the intermediate texture to the screen, with some distortion to simulate
 // water
-void RenderSystem::drawToScreen() {
+void RenderSystem::drawToScreen(const RenderSnapshot& snapshot) {
   // Setting shaders
   // get the water texture, sprite mesh, and program
   glUseProgram(effects[(GLuint)EFFECT_ASSET_ID::WATER]);
   gl_has_errors();
   // Clearing backbuffer
-  int w, h;
-  glfwGetFramebufferSize(window, &w,
-                         &h);  // Note, this will be 2x the resolution given to
-                               // glfwCreateWindow on retina displays
   glBindFramebuffer(GL_FRAMEBUFFER, 0);
-  glViewport(0, 0, w, h);
+  glViewport(0, 0, snapshot.framebuffer_width, snapshot.framebuffer_height);
   glDepthRange(0, 10);
   glClearColor(1.f, 0, 0, 1.0);
   glClearDepth(1.f);
@@ -207,10 +214,9 @@ void RenderSystem::drawToScreen() {
   GLuint dead_timer_uloc =
       glGetUniformLocation(water_program, "darken_screen_factor");
   glUniform1f(time_uloc, (float)(glfwGetTime() * 10.0f));
-  ScreenState& screen = registry.screenStates.get(screen_state_entity);
-  glUniform1f(dead_timer_uloc, screen.darken_screen_factor);
+  glUniform1f(dead_timer_uloc, snapshot.darken_screen_factor);
   GLuint is_paused_uloc = glGetUniformLocation(water_program, "is_paused");
-  glUniform1i(is_paused_uloc, is_paused);
+  glUniform1i(is_paused_uloc, snapshot.is_paused);
   gl_has_errors();
   // Set the vertex position and vertex texture coordinates (both stored in the
   // same VBO)
@@ -232,8 +238,9 @@ void RenderSystem::drawToScreen() {
   gl_has_errors();
 }
 
-void RenderSystem::renderText(std::string text, float x, float y, float scale,
-                              const glm::vec3& color, const glm::mat4& trans) {
+void RenderSystem::renderText(const std::string& text, float x, float y,
+                              float scale, const glm::vec3& color,
+                              const glm::mat4& trans) {
   // activate the shader program
   glEnable(GL_BLEND);
   glUseProgram(font_shaderProgram);
@@ -290,29 +297,28 @@ void RenderSystem::renderText(std::string text, float x, float y, float scale,
 
 // Render our game world
 // http://www.opengl-tutorial.org/intermediate-tutorials/tutorial-14-render-to-texture/
-void RenderSystem::draw() {
-  // Getting size of window
-  int w, h;
-  glfwGetFramebufferSize(window, &w,
-                         &h);  // Note, this will be 2x the resolution given to
-                               // glfwCreateWindow on retina displays
+void RenderSystem::draw(float alpha) {
+  if (headless) {
+    return;
+  }
+  PROFILE_SCOPE("renderer.draw");
+  capture(frame);
+  render(frame, alpha);
+}
 
-  // First render to the custom framebuffer
-  glBindFramebuffer(GL_FRAMEBUFFER, frame_buffer);
-  gl_has_errors();
-  // Clearing backbuffer
-  glViewport(0, 0, w, h);
-  glDepthRange(0.00001, 10);
-  glClearColor(GLfloat(172 / 255), GLfloat(216 / 255), GLfloat(255 / 255), 1.0);
-  glClearDepth(10.f);
-  glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-  glEnable(GL_BLEND);
-  glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-  glDisable(GL_DEPTH_TEST);  // native OpenGL does not work with a depth buffer
-                             // and alpha blending, one would have to sort
-                             // sprites back to front
-  gl_has_errors();
-  mat3 projection_2D = createProjectionMatrix();
+void RenderSystem::capture(RenderSnapshot& snapshot) {
+  PROFILE_SCOPE("renderer.capture");
+  snapshot.clear();
+
+  // Getting size of window
+  glfwGetFramebufferSize(
+      window, &snapshot.framebuffer_width,
+      &snapshot.framebuffer_height);  // Note, this will be 2x the resolution
+                                      // given to glfwCreateWindow on retina
+                                      // displays
+  snapshot.darken_screen_factor =
+      registry.screenStates.get(screen_state_entity).darken_screen_factor;
+  snapshot.is_paused = is_paused;
 
   //////////////////////////////////////////////////////////////////////////////////////
   /*************************************************************************************
@@ -323,112 +329,92 @@ void RenderSystem::draw() {
    *entity albeit iterating through all Sprites in sequence. A good point to
    *optimize
    *************************************************************************************/
-  for (Entity floor : registry.floors.entities) {
-    if (registry.renderRequests.has(floor))
-      drawTexturedMesh(floor, projection_2D);
+  for (Entity floor : registry.view<Floor, RenderRequest>()) {
+    captureSprite(snapshot, floor);
   }
-  for (Entity ambient : registry.ambient.entities) {
-    if (registry.positions.has(ambient)) {
-      drawTexturedMesh(ambient, projection_2D);
-    }
+  for (Entity ambient : registry.view<Ambient, Position>()) {
+    captureSprite(snapshot, ambient);
   }
-  for (Entity interactable : registry.interactable.entities) {
-    if (registry.renderRequests.has(interactable))
-      drawTexturedMesh(interactable, projection_2D);
+  for (Entity interactable : registry.view<Interactable, RenderRequest>()) {
+    captureSprite(snapshot, interactable);
   }
   for (Entity wall : registry.activeWalls.entities) {
     if (registry.renderRequests.has(wall)) {
       if (registry.breakables.has(wall) && registry.oxygen.has(wall)) {
-        Oxygen& wallOxygen = registry.oxygen.get(wall);
+        const Oxygen& wallOxygen = registry.oxygen.get(wall);
         if (registry.renderRequests.has(wallOxygen.backgroundBar) &&
             registry.renderRequests.has(wallOxygen.oxygenBar)) {
-          drawTexturedMesh(wallOxygen.backgroundBar, projection_2D);
-          drawTexturedMesh(wallOxygen.oxygenBar, projection_2D);
+          captureSprite(snapshot, wallOxygen.backgroundBar);
+          captureSprite(snapshot, wallOxygen.oxygenBar);
         }
       }
-      drawTexturedMesh(wall, projection_2D);
+      captureSprite(snapshot, wall);
     }
   }
-  for (Entity door : registry.activeDoors.entities) {
-    if (registry.renderRequests.has(door))
-      drawTexturedMesh(door, projection_2D);
+  for (Entity door : registry.view<ActiveDoor, RenderRequest>()) {
+    captureSprite(snapshot, door);
   }
-  for (Entity item : registry.items.entities) {
-    if (registry.renderRequests.has(item))
-      drawTexturedMesh(item, projection_2D);
+  for (Entity item : registry.view<Item, RenderRequest>()) {
+    captureSprite(snapshot, item);
   }
-  for (Entity consumable : registry.consumables.entities) {
-    if (registry.renderRequests.has(consumable))
-      drawTexturedMesh(consumable, projection_2D);
+  for (Entity consumable : registry.view<Consumable, RenderRequest>()) {
+    captureSprite(snapshot, consumable);
   }
-  for (Entity bubble : registry.bubbles.entities) {
-    if (registry.renderRequests.has(bubble))
-      drawTexturedMesh(bubble, projection_2D);
+  for (Entity bubble : registry.view<Bubble, RenderRequest>()) {
+    captureSprite(snapshot, bubble);
   }
-  for (Entity player : registry.players.entities) {
-    if (registry.renderRequests.has(player))
-      drawTexturedMesh(player, projection_2D);
+  for (Entity player : registry.view<Player, RenderRequest>()) {
+    captureSprite(snapshot, player);
   }
   // Collision mesh rendering
-  for (Entity playerCollisionMesh : registry.playersCollisionMeshes.entities) {
-    if (registry.renderRequests.has(playerCollisionMesh)) {
-      drawTexturedMesh(playerCollisionMesh, projection_2D);
-    }
+  for (Entity playerCollisionMesh :
+       registry.view<PlayerCollisionMesh, RenderRequest>()) {
+    captureSprite(snapshot, playerCollisionMesh);
   }
-  for (Entity projectile : registry.playerProjectiles.entities) {
-    if (registry.renderRequests.has(projectile))
-      drawTexturedMesh(projectile, projection_2D);
+  for (Entity projectile : registry.view<PlayerProjectile, RenderRequest>()) {
+    captureSprite(snapshot, projectile);
   }
-  for (Entity weapon : registry.playerWeapons.entities) {
-    if (registry.renderRequests.has(weapon))
-      drawTexturedMesh(weapon, projection_2D);
+  for (Entity weapon : registry.view<PlayerWeapon, RenderRequest>()) {
+    captureSprite(snapshot, weapon);
   }
-  for (Entity enemy : registry.deadlys.entities) {
-    if (registry.renderRequests.has(enemy))
-      drawTexturedMesh(enemy, projection_2D);
+  for (Entity enemy : registry.view<Deadly, RenderRequest>()) {
+    captureSprite(snapshot, enemy);
   }
   for (Entity enemy : registry.deadlys.entities) {
     if (registry.oxygen.has(enemy)) {
-      Oxygen& enemyOxygen = registry.oxygen.get(enemy);
+      const Oxygen& enemyOxygen = registry.oxygen.get(enemy);
       if (registry.renderRequests.has(enemyOxygen.backgroundBar) &&
           registry.renderRequests.has(enemyOxygen.oxygenBar)) {
-        drawTexturedMesh(enemyOxygen.backgroundBar, projection_2D);
-        drawTexturedMesh(enemyOxygen.oxygenBar, projection_2D);
+        captureSprite(snapshot, enemyOxygen.backgroundBar);
+        captureSprite(snapshot, enemyOxygen.oxygenBar);
       }
       if (registry.emoting.has(enemy)) {
-        Emoting& emote = registry.emoting.get(enemy);
+        const Emoting& emote = registry.emoting.get(enemy);
         if (registry.renderRequests.has(emote.child)) {
-          drawTexturedMesh(emote.child, projection_2D);
+          captureSprite(snapshot, emote.child);
         }
       }
     }
   }
   for (Entity enemySuppProj : registry.enemySupports.entities) {
     if (registry.enemySupports.has(enemySuppProj)) {
-      drawTexturedMesh(enemySuppProj, projection_2D);
+      captureSprite(snapshot, enemySuppProj);
     }
   }
-  for (Entity enemy_proj : registry.enemyProjectiles.entities) {
-    if (registry.renderRequests.has(enemy_proj)) {
-      drawTexturedMesh(enemy_proj, projection_2D);
-    }
+  for (Entity enemy_proj : registry.view<EnemyProjectile, RenderRequest>()) {
+    captureSprite(snapshot, enemy_proj);
   }
-  for (Entity explosion : registry.explosions.entities) {
-    if (registry.renderRequests.has(explosion)) {
-      drawTexturedMesh(explosion, projection_2D);
-    }
+  for (Entity explosion : registry.view<Explosion, RenderRequest>()) {
+    captureSprite(snapshot, explosion);
   }
-  for (Entity playerHUDElement : registry.playerHUD.entities) {
-    if (registry.renderRequests.has(playerHUDElement))
-      drawTexturedMesh(playerHUDElement, projection_2D);
+  for (Entity playerHUDElement : registry.view<PlayerHUD, RenderRequest>()) {
+    captureSprite(snapshot, playerHUDElement);
   }
-  for (Entity cursor : registry.cursors.entities) {
-    if (registry.renderRequests.has(cursor))
-      drawTexturedMesh(cursor, projection_2D);
+  for (Entity cursor : registry.view<GameCursor, RenderRequest>()) {
+    captureSprite(snapshot, cursor);
   }
-  for (Entity overlay : registry.overlays.entities) {
-    if (registry.renderRequests.has(overlay))
-      drawTexturedMesh(overlay, projection_2D);
+  for (Entity overlay : registry.view<Overlay, RenderRequest>()) {
+    captureSprite(snapshot, overlay);
   }
   //////////////////////////////////////////////////////////////////////////////////////
 
@@ -441,36 +427,83 @@ void RenderSystem::draw() {
     for (Entity entity : registry.textRequests.entities) {
       if (!registry.positions.has(entity) || !registry.colors.has(entity))
         continue;
-      processTextRequest(entity);
+      captureText(snapshot, entity);
     }
   }
   for (Entity entity : registry.saveStatuses.entities) {
     if (!registry.positions.has(entity) || !registry.colors.has(entity))
       continue;
-    processTextRequest(entity);
+    captureText(snapshot, entity);
+  }
+}
+
+void RenderSystem::render(const RenderSnapshot& snapshot, float alpha) {
+  PROFILE_SCOPE("renderer.render");
+  // First render to the custom framebuffer
+  glBindFramebuffer(GL_FRAMEBUFFER, frame_buffer);
+  gl_has_errors();
+  // Clearing backbuffer
+  glViewport(0, 0, snapshot.framebuffer_width, snapshot.framebuffer_height);
+  glDepthRange(0.00001, 10);
+  glClearColor(GLfloat(172 / 255), GLfloat(216 / 255), GLfloat(255 / 255), 1.0);
+  glClearDepth(10.f);
+  glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+  glEnable(GL_BLEND);
+  glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+  glDisable(GL_DEPTH_TEST);  // native OpenGL does not work with a depth buffer
+                             // and alpha blending, one would have to sort
+                             // sprites back to front
+  gl_has_errors();
+  mat3 projection_2D = createProjectionMatrix();
+
+  for (const SpriteDraw& sprite : snapshot.sprites) {
+    drawTexturedMesh(sprite, alpha, projection_2D);
+  }
+
+  // Render Fonts
+  for (const TextDraw& text : snapshot.texts) {
+    drawText(text, alpha);
   }
 
   // Truely render to the screen
-  drawToScreen();
+  drawToScreen(snapshot);
 
   // flicker-free display with a double buffer
   glfwSwapBuffers(window);
   gl_has_errors();
 }
 
-void RenderSystem::processTextRequest(Entity& entity) {
-  TextRequest& textRequest = registry.textRequests.get(entity);
-  Position&    position    = registry.positions.get(entity);
-  vec3&        color       = registry.colors.get(entity);
+void RenderSystem::releaseContext() {
+  glfwMakeContextCurrent(nullptr);
+}
+
+void RenderSystem::acquireContext() {
+  glfwMakeContextCurrent(window);
+}
+
+void RenderSystem::captureText(RenderSnapshot& snapshot, Entity entity) {
+  const TextRequest& textRequest = registry.textRequests.get(entity);
+
+  TextDraw text;
+  text.previous = interpolatedPosition(entity, 0.f);
+  text.current  = registry.positions.get(entity);
+  text.text.assign(textRequest.text.begin(), textRequest.text.end());
+  text.scale = textRequest.textScale;
+  text.color = registry.colors.get(entity);
+  snapshot.texts.push_back(std::move(text));
+}
+
+void RenderSystem::drawText(const TextDraw& text, float alpha) {
+  Position position = blendPositions(text.previous, text.current, alpha);
 
   Transform transform;
   transform.translate(position.position);
   transform.rotate(position.angle);
   transform.scale(position.scale);
 
-  renderText(textRequest.text, position.position.x,
-             abs(position.position.y - window_height_px), textRequest.textScale,
-             color, transform.mat);
+  renderText(text.text, position.position.x,
+             abs(position.position.y - window_height_px), text.scale,
+             text.color, transform.mat);
 }
 
 mat3 RenderSystem::createProjectionMatrix() {
@@ -5,6 +5,7 @@
 
 #include "common.hpp"
 #include "components.hpp"
+#include "render_snapshot.hpp"
 #include "tiny_ecs.hpp"
 
 // System responsible for setting up OpenGL and for rendering all the
@@ -198,6 +199,10 @@ class RenderSystem {
   // Initialize the window
   bool init(GLFWwindow* window);
 
+  // Null renderer for runs without a window: only the meshes are loaded, for
+  // the factories and collisions, and draw() does nothing
+  bool init_headless();
+
   template <class T>
   void bindVBOandIBO(GEOMETRY_BUFFER_ID gid, std::vector<T> vertices,
                      std::vector<uint16_t> indices);
@@ -208,6 +213,7 @@ class RenderSystem {
 
   void initializeGlEffects();
 
+  void  loadMeshes();
   void  initializeGlMeshes();
   Mesh& getMesh(GEOMETRY_BUFFER_ID id) {
     return meshes[(int)id];
@@ -225,18 +231,33 @@ class RenderSystem {
   // Destroy resources associated to one or all entities created by the system
   ~RenderSystem();
 
-  // Draw all entities
-  void draw();
+  // Draw all entities, alpha of the way between the last two simulation ticks.
+  // Same as capture() followed by render() on the calling thread.
+  void draw(float alpha = 1.f);
+
+  // Copies what the next frame shows out of the registry. Main thread only,
+  // it reads the registry and the window.
+  void capture(RenderSnapshot& snapshot);
+  // Draws and presents a captured frame. Touches only GL and the snapshot,
+  // so it may run on whichever thread holds the GL context.
+  void render(const RenderSnapshot& snapshot, float alpha);
+
+  // Hand the GL context over to another thread and take it back
+  void releaseContext();
+  void acquireContext();
 
-  void processTextRequest(Entity& entity);
   mat3 createProjectionMatrix();
 
   private:
   // Internal drawing functions for each entity type
-  void drawTexturedMesh(Entity entity, const mat3& projection);
+  void captureSprite(RenderSnapshot& snapshot, Entity entity);
+  void captureText(RenderSnapshot& snapshot, Entity entity);
+  void drawTexturedMesh(const SpriteDraw& sprite, float alpha,
+                        const mat3& projection);
   // void drawTexturedMeshTemp(Entity entity, const mat3& projection);
-  void drawToScreen();
-  void renderText(std::string text, float x, float y, float scale,
+  void drawToScreen(const RenderSnapshot& snapshot);
+  void drawText(const TextDraw& text, float alpha);
+  void renderText(const std::string& text, float x, float y, float scale,
                   const glm::vec3& color, const glm::mat4& trans);
 
   // Window handle
@@ -257,6 +278,12 @@ class RenderSystem {
   GLuint                    font_VBO;
 
   Entity screen_state_entity;
+
+  // Frame captured and rendered by draw()
+  RenderSnapshot frame;
+
+  // Set by init_headless(), there is no GL context to draw into or free
+  bool headless = false;
 };
 
 extern bool is_intro;
@@ -1,8 +1,13 @@
+// gl3w's function pointers are defined here, where they are loaded
+#define GL3W_IMPLEMENTATION
+#include <gl3w.h>
+
 // internal
 #include <array>
 #include <fstream>
 
 #include "../ext/stb_image/stb_image.h"
+#include "jobs.hpp"
 #include "render_system.hpp"
 
 // This creates circular header inclusion, that is quite bad.
@@ -67,6 +72,14 @@ bool RenderSystem::init(GLFWwindow* window_arg) {
   return true;
 }
 
+bool RenderSystem::init_headless() {
+  headless = true;
+  // the world still fades the screen in and out with nothing to show it
+  registry.screenStates.emplace(screen_state_entity);
+  loadMeshes();
+  return true;
+}
+
 bool RenderSystem::fontInit() {
   // setup fonts
   std::string  default_font_filename = fonts_path("Tiny5-Regular.ttf");
@@ -194,26 +207,39 @@ bool RenderSystem::fontInit() {
 void RenderSystem::initializeGlTextures() {
   glGenTextures((GLsizei)texture_gl_handles.size(), texture_gl_handles.data());
 
+  // Decoding is most of the work and runs on the workers, each upload
+  // follows its decode on the main thread, which holds the GL context
+  std::vector<stbi_uc*> pixels(texture_paths.size(), nullptr);
+  TaskGraph             graph;
   for (uint i = 0; i < texture_paths.size(); i++) {
-    const std::string& path       = texture_paths[i];
-    ivec2&             dimensions = texture_dimensions[i];
-
-    stbi_uc* data;
-    data = stbi_load(path.c_str(), &dimensions.x, &dimensions.y, NULL, 4);
-
-    if (data == NULL) {
-      const std::string message = "Could not load the file " + path + ".";
-      fprintf(stderr, "%s", message.c_str());
-      assert(false);
-    }
-    glBindTexture(GL_TEXTURE_2D, texture_gl_handles[i]);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, dimensions.x, dimensions.y, 0,
-                 GL_RGBA, GL_UNSIGNED_BYTE, data);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    gl_has_errors();
-    stbi_image_free(data);
+    TaskGraph::TaskId decode = graph.add([this, &pixels, i] {
+      const std::string& path       = texture_paths[i];
+      ivec2&             dimensions = texture_dimensions[i];
+
+      pixels[i] =
+          stbi_load(path.c_str(), &dimensions.x, &dimensions.y, NULL, 4);
+
+      if (pixels[i] == NULL) {
+        const std::string message = "Could not load the file " + path + ".";
+        fprintf(stderr, "%s", message.c_str());
+        assert(false);
+      }
+    });
+    TaskGraph::TaskId upload = graph.add(
+        [this, &pixels, i] {
+          const ivec2& dimensions = texture_dimensions[i];
+          glBindTexture(GL_TEXTURE_2D, texture_gl_handles[i]);
+          glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, dimensions.x, dimensions.y,
+                       0, GL_RGBA, GL_UNSIGNED_BYTE, pixels[i]);
+          glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+          glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+          gl_has_errors();
+          stbi_image_free(pixels[i]);
+        },
+        TaskGraph::Lane::MAIN);
+    graph.precede(decode, upload);
   }
+  jobs().run(graph);
   gl_has_errors();
 }
 
@@ -244,15 +270,20 @@ void RenderSystem::bindVBOandIBO(GEOMETRY_BUFFER_ID    gid,
   gl_has_errors();
 }
 
-void RenderSystem::initializeGlMeshes() {
+void RenderSystem::loadMeshes() {
   for (uint i = 0; i < mesh_paths.size(); i++) {
-    // Initialize meshes
     GEOMETRY_BUFFER_ID geom_index = mesh_paths[i].first;
     std::string        name       = mesh_paths[i].second;
     Mesh::loadFromOBJFile(name, meshes[(int)geom_index].vertices,
                           meshes[(int)geom_index].vertex_indices,
                           meshes[(int)geom_index].original_size);
+  }
+}
 
+void RenderSystem::initializeGlMeshes() {
+  loadMeshes();
+  for (uint i = 0; i < mesh_paths.size(); i++) {
+    GEOMETRY_BUFFER_ID geom_index = mesh_paths[i].first;
     bindVBOandIBO(geom_index, meshes[(int)geom_index].vertices,
                   meshes[(int)geom_index].vertex_indices);
   }
@@ -334,10 +365,10 @@ void RenderSystem::initializeGlCursor() {
   registry.meshPtrs.emplace(cursor, &mesh);
 
   // Setting initial position values
-  Position& position = registry.positions.emplace(cursor);
-  position.position  = vec2(0.f);
-  position.angle     = 0.f;
-  position.scale     = vec2(32.f);
+  PositionRef position = registry.positions.emplace(cursor);
+  position.position    = vec2(0.f);
+  position.angle       = 0.f;
+  position.scale       = vec2(32.f);
 
   // Make Cursor
   registry.cursors.emplace(cursor);
@@ -349,6 +380,14 @@ void RenderSystem::initializeGlCursor() {
 }
 
 RenderSystem::~RenderSystem() {
+  // remove all entities created by the render system
+  while (registry.renderRequests.entities.size() > 0)
+    registry.remove_all_components_of(registry.renderRequests.entities.back());
+
+  if (headless) {
+    return;
+  }
+
   // Don't need to free gl resources since they last for as long as the program,
   // but it's polite to clean after yourself.
   glDeleteBuffers((GLsizei)vertex_buffers.size(), vertex_buffers.data());
@@ -365,10 +404,6 @@ RenderSystem::~RenderSystem() {
   // delete allocated resources
   glDeleteFramebuffers(1, &frame_buffer);
   gl_has_errors();
-
-  // remove all entities created by the render system
-  while (registry.renderRequests.entities.size() > 0)
-    registry.remove_all_components_of(registry.renderRequests.entities.back());
 }
 
 // Initialize the screen texture from a standard sprite
@@ -513,4 +548,4 @@ std::string readShaderFile(const std::string& filename) {
   std::ostringstream oss;
   oss << ifs.rdbuf();
   return oss.str();
-}
\ No newline at end of file
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+#include "render_thread.hpp"
+
+#include <cassert>
+#include <utility>
+
+#include "profiler.hpp"
+#include "render_system.hpp"
+
+void RenderThread::start(RenderSystem& renderer) {
+  assert(!thread.joinable());
+  this->renderer = &renderer;
+  // a context is current on at most one thread
+  renderer.releaseContext();
+  thread = std::thread(&RenderThread::run, this);
+}
+
+void RenderThread::submit(RenderSnapshot& snapshot, float alpha) {
+  PROFILE_SCOPE("renderer.submit");
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    changed.wait(lock, [this] { return !has_pending; });
+    std::swap(pending, snapshot);
+    pending_alpha = alpha;
+    has_pending   = true;
+  }
+  changed.notify_all();
+}
+
+void RenderThread::stop() {
+  if (!thread.joinable()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  changed.notify_all();
+  thread.join();
+  stopping = false;
+  renderer->acquireContext();
+}
+
+void RenderThread::run() {
+  renderer->acquireContext();
+  RenderSnapshot drawing;
+  float          alpha;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      changed.wait(lock, [this] { return has_pending || stopping; });
+      if (!has_pending) {
+        break;
+      }
+      std::swap(drawing, pending);
+      alpha       = pending_alpha;
+      has_pending = false;
+    }
+    changed.notify_all();
+    renderer->render(drawing, alpha);
+  }
+  renderer->releaseContext();
+}
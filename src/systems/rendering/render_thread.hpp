@@ -0,0 +1,44 @@
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "render_snapshot.hpp"
+
+class RenderSystem;
+
+// Draws frames on a thread of its own, so that GL submission and the wait
+// for vsync overlap with simulating the next frame:
+//
+//   main     sim N | capture N | sim N+1 | capture N+1 | sim N+2 ...
+//   render                     | render N + swap       | render N+1 ...
+//
+// The main thread fills a snapshot and submit()s it, waiting only if the
+// one before hasn't been picked up yet, so the simulation is never more than
+// a frame ahead of the screen. The GL context belongs to the render thread
+// between start() and stop().
+class RenderThread {
+  RenderSystem*           renderer = nullptr;
+  std::thread             thread;
+  std::mutex              mutex;
+  std::condition_variable changed;
+
+  // Submitted but not picked up yet
+  RenderSnapshot pending;
+  float          pending_alpha = 1.f;
+  bool           has_pending   = false;
+  bool           stopping      = false;
+
+  void run();
+
+public:
+  ~RenderThread() { stop(); }
+
+  void start(RenderSystem& renderer);
+  // Queues snapshot for drawing alpha of the way between its last two ticks.
+  // snapshot is swapped out for an older frame's, whose buffers are reused.
+  void submit(RenderSnapshot& snapshot, float alpha);
+  // Draws what is still pending, then hands the context back to the caller
+  void stop();
+};
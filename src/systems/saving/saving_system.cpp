@@ -52,7 +52,7 @@ void init_save_system(LevelBuilder* lb, LevelSystem* ls, RenderSystem* r) {
  * @param j
  * @param position
  */
-static void position_to_json(json& save_file, Position& position) {
+static void position_to_json(json& save_file, const Position& position) {
   save_file["position"] = {{"x", position.position.x},
                            {"y", position.position.y},
                            {"angle", position.angle},
@@ -104,15 +104,15 @@ static bool save_meta_info(json& save_file) {
  * @return
  */
 static bool save_player_info(json& save_file) {
-  Position&  position  = registry.positions.get(player);
-  Inventory& inventory = registry.inventory.get(player);
+  ConstPositionRef position  = registry.positions.get(player);
+  const Inventory& inventory = registry.inventory.get(player);
   position_to_json(save_file["player"], position);
   save_file["player"]["inventory"] = {
       {"nets", inventory.nets},          {"concussors", inventory.concussors},
       {"torpedos", inventory.torpedos},  {"shrimp", inventory.shrimp},
       {"redKey", inventory.redKey},      {"blueKey", inventory.blueKey},
       {"yellowKey", inventory.yellowKey}};
-  Oxygen& oxygen                = registry.oxygen.get(player);
+  const Oxygen& oxygen          = registry.oxygen.get(player);
   save_file["player"]["oxygen"] = oxygen.level;
 
   return true;
@@ -435,9 +435,9 @@ static bool load_player_from_json(json& save_file) {
   registry.positions.insert(player, pos);
 
   // update the weapon
-  Position& weapon  = registry.positions.get(player_weapon);
-  weapon.scale.x    = abs(weapon.scale.x);
-  weapon.position.x = abs(weapon.position.x);
+  PositionRef weapon = registry.positions.get_mut(player_weapon);
+  weapon.scale.x     = abs(weapon.scale.x);
+  weapon.position.x  = abs(weapon.position.x);
   if (pos.position.x < 0) {
     weapon.position.x *= -1;
   }
@@ -447,7 +447,7 @@ static bool load_player_from_json(json& save_file) {
   }
 
   // also update the collision mesh
-  Player& p = registry.players.get(player);
+  const Player& p = registry.players.get(player);
   registry.positions.remove(p.collisionMesh);
   registry.positions.insert(p.collisionMesh, pos);
 
@@ -486,8 +486,8 @@ static bool load_player_from_json(json& save_file) {
   }
 
   // update oxygen
-  Oxygen& oxygen = registry.oxygen.get(player);
-  float   diff   = (float)save_file["oxygen"] - oxygen.level;
+  const Oxygen& oxygen = registry.oxygen.get(player);
+  float         diff   = (float)save_file["oxygen"] - oxygen.level;
 
   // This will also update the health bar
   if (abs(diff) != 0) {
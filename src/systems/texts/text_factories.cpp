@@ -12,7 +12,7 @@ Entity requestText(RenderSystem* renderer, std::string text, float textScale,
   registry.meshPtrs.emplace(entity, &mesh);
 
   // Initialize the position
-  auto& position    = registry.positions.emplace(entity);
+  auto position     = registry.positions.emplace(entity);
   position.angle    = 0.f;
   position.position = textPosition;
   position.scale    = vec2(1.f);
@@ -23,7 +23,7 @@ Entity requestText(RenderSystem* renderer, std::string text, float textScale,
 
   // make text request
   auto& textRequest     = registry.textRequests.emplace(entity);
-  textRequest.text      = text;
+  textRequest.text.assign(text.begin(), text.end());
   textRequest.textScale = textScale;
 
   return entity;
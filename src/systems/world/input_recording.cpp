@@ -0,0 +1,181 @@
+#include "input_recording.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+#define RECORDING_VERSION 1
+
+namespace {
+enum Flags : uint8_t {
+  LOAD_FROM_SAVE = 1 << 0,
+  IS_START       = 1 << 1,
+  IS_INTRO       = 1 << 2,
+};
+
+// Fixed-size little endian fields, independent of the host
+void put(std::ofstream& out, uint32_t value, int bytes) {
+  for (int i = 0; i < bytes; i++) {
+    out.put((char)((value >> (8 * i)) & 0xff));
+  }
+}
+
+void putFloat(std::ofstream& out, float value) {
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  put(out, bits, 4);
+}
+
+bool get(std::ifstream& in, uint32_t& value, int bytes) {
+  value = 0;
+  for (int i = 0; i < bytes; i++) {
+    int c = in.get();
+    if (c == EOF) {
+      return false;
+    }
+    value |= (uint32_t)(uint8_t)c << (8 * i);
+  }
+  return true;
+}
+
+bool getFloat(std::ifstream& in, float& value) {
+  uint32_t bits;
+  if (!get(in, bits, 4)) {
+    return false;
+  }
+  memcpy(&value, &bits, sizeof(value));
+  return true;
+}
+}  // namespace
+
+unsigned int Recording::ticks() const {
+  unsigned int total = 0;
+  for (uint8_t frame : frame_ticks) total += frame;
+  // a session cut short may have input past its last complete frame
+  if (!events.empty() && events.back().tick >= total) {
+    total = events.back().tick + 1;
+  }
+  return total;
+}
+
+bool InputRecorder::open(const std::string& path, const Recording& start) {
+  file.open(path, std::ios::binary | std::ios::trunc);
+  if (!file.is_open()) {
+    fprintf(stderr, "Failed to open recording %s\n", path.c_str());
+    return false;
+  }
+  file.write("BRMR", 4);
+  put(file, RECORDING_VERSION, 2);
+  put(file, start.seed, 4);
+  putFloat(file, start.tick_ms);
+  put(file,
+      (start.load_from_save ? LOAD_FROM_SAVE : 0) |
+          (start.is_start ? IS_START : 0) | (start.is_intro ? IS_INTRO : 0),
+      1);
+  tick = 0;
+  return true;
+}
+
+void InputRecorder::record(const InputEvent& event) {
+  if (!file.is_open()) {
+    return;
+  }
+  switch (event.type) {
+    case InputEvent::Type::KEY:
+    case InputEvent::Type::MOUSE_CLICK:
+      file.put(event.type == InputEvent::Type::KEY ? 'K' : 'C');
+      put(file, tick, 4);
+      put(file, (uint32_t)event.code, 4);
+      put(file, (uint32_t)event.action, 1);
+      put(file, (uint32_t)event.mods, 1);
+      break;
+    case InputEvent::Type::MOUSE_MOVE:
+    case InputEvent::Type::MOUSE_SCROLL:
+      file.put(event.type == InputEvent::Type::MOUSE_MOVE ? 'M' : 'S');
+      put(file, tick, 4);
+      putFloat(file, event.pos.x);
+      putFloat(file, event.pos.y);
+      break;
+  }
+}
+
+void InputRecorder::end_frame(unsigned int ticks, float elapsed_ms) {
+  if (!file.is_open()) {
+    return;
+  }
+  file.put('F');
+  put(file, ticks, 1);
+  putFloat(file, elapsed_ms);
+  // a frame is the unit a crashed session can be replayed up to
+  file.flush();
+}
+
+bool load_recording(const std::string& path, Recording& recording) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in.is_open()) {
+    fprintf(stderr, "Failed to open recording %s\n", path.c_str());
+    return false;
+  }
+
+  char     magic[4];
+  uint32_t version, seed, flags;
+  if (!in.read(magic, 4) || memcmp(magic, "BRMR", 4) != 0 ||
+      !get(in, version, 2) || version != RECORDING_VERSION ||
+      !get(in, seed, 4) || !getFloat(in, recording.tick_ms) ||
+      !get(in, flags, 1)) {
+    fprintf(stderr, "%s is not a recording this build can replay\n",
+            path.c_str());
+    return false;
+  }
+  recording.seed           = seed;
+  recording.load_from_save = flags & LOAD_FROM_SAVE;
+  recording.is_start       = flags & IS_START;
+  recording.is_intro       = flags & IS_INTRO;
+
+  int type;
+  while ((type = in.get()) != EOF) {
+    bool       ok = true;
+    uint32_t   value;
+    InputEvent event;
+    switch (type) {
+      case 'F': {
+        float elapsed_ms;
+        ok = get(in, value, 1) && getFloat(in, elapsed_ms);
+        if (ok) {
+          recording.frame_ticks.push_back((uint8_t)value);
+          recording.frame_ms.push_back(elapsed_ms);
+        }
+        break;
+      }
+      case 'K':
+      case 'C':
+        event.type = type == 'K' ? InputEvent::Type::KEY
+                                 : InputEvent::Type::MOUSE_CLICK;
+        ok = get(in, event.tick, 4) && get(in, value, 4);
+        event.code = (int)value;
+        ok = ok && get(in, value, 1);
+        event.action = (int)value;
+        ok = ok && get(in, value, 1);
+        event.mods = (int)value;
+        break;
+      case 'M':
+      case 'S':
+        event.type = type == 'M' ? InputEvent::Type::MOUSE_MOVE
+                                 : InputEvent::Type::MOUSE_SCROLL;
+        ok = get(in, event.tick, 4) && getFloat(in, event.pos.x) &&
+             getFloat(in, event.pos.y);
+        break;
+      default:
+        ok = false;
+    }
+    if (!ok) {
+      // the last record of a session that crashed may be cut off
+      fprintf(stderr, "%s: stopped reading at a damaged record\n",
+              path.c_str());
+      break;
+    }
+    if (type != 'F') {
+      recording.events.push_back(event);
+    }
+  }
+  return true;
+}
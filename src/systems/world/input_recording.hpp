@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "input_script.hpp"
+
+// Everything a play session depends on besides the code: the level seed, the
+// state the game started in, every input event with the tick it arrived
+// before, and how many ticks each rendered frame ran. Replaying it gives the
+// exact same simulation, windowed or headless.
+struct Recording {
+  unsigned int            seed           = 0;
+  float                   tick_ms        = 0.f;
+  bool                    load_from_save = false;
+  bool                    is_start       = false;
+  bool                    is_intro       = false;
+  std::vector<InputEvent> events;  // in tick order
+
+  // Per rendered frame, the ticks it ran and its wall-clock duration
+  std::vector<uint8_t> frame_ticks;
+  std::vector<float>   frame_ms;
+
+  unsigned int ticks() const;
+};
+
+// Binary layout, little endian:
+//
+//   header  "BRMR" u16 version, u32 seed, f32 tick_ms, u8 flags
+//   frame   u8 'F', u8 ticks, f32 elapsed_ms
+//   input   u8 'K' (key) / 'C' (click), u32 tick, i32 code, u8 action, u8 mods
+//           u8 'M' (move) / 'S' (scroll), u32 tick, f32 x, f32 y
+//
+// Records are written as they happen, a session cut short by a crash can
+// still be replayed up to that point.
+class InputRecorder {
+  std::ofstream file;
+  unsigned int  tick = 0;
+
+public:
+  // Starts a file for a session beginning as described by the header fields
+  // of start (its events and frames are ignored)
+  bool open(const std::string& path, const Recording& start);
+  bool is_open() const { return file.is_open(); }
+
+  // Input delivered before the current tick
+  void record(const InputEvent& event);
+  void end_tick() { tick++; }
+  void end_frame(unsigned int ticks, float elapsed_ms);
+};
+
+// Returns false and prints why if the file isn't a readable recording
+bool load_recording(const std::string& path, Recording& recording);
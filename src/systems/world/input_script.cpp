@@ -0,0 +1,66 @@
+#include "input_script.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+namespace {
+bool parseEvent(const std::string& line, InputEvent& event) {
+  std::istringstream in(line);
+  std::string        type;
+  if (!(in >> event.tick >> type)) {
+    return false;
+  }
+  if (type == "key") {
+    event.type = InputEvent::Type::KEY;
+    in >> event.code >> event.action >> event.mods;
+  } else if (type == "click") {
+    event.type = InputEvent::Type::MOUSE_CLICK;
+    in >> event.code >> event.action >> event.mods;
+  } else if (type == "move") {
+    event.type = InputEvent::Type::MOUSE_MOVE;
+    in >> event.pos.x >> event.pos.y;
+  } else if (type == "scroll") {
+    event.type = InputEvent::Type::MOUSE_SCROLL;
+    in >> event.pos.x >> event.pos.y;
+  } else {
+    return false;
+  }
+  return !in.fail();
+}
+}  // namespace
+
+bool InputScript::load(const std::string& path) {
+  std::ifstream file(path);
+  if (!file.is_open()) {
+    fprintf(stderr, "Failed to open input script %s\n", path.c_str());
+    return false;
+  }
+
+  std::string line;
+  int         line_number = 0;
+  while (std::getline(file, line)) {
+    line_number++;
+    size_t first = line.find_first_not_of(" \t\r");
+    if (first == std::string::npos || line[first] == '#') {
+      continue;
+    }
+    InputEvent event;
+    if (!parseEvent(line, event) ||
+        (!events.empty() && event.tick < events.back().tick)) {
+      fprintf(stderr, "%s:%d: bad input event: %s\n", path.c_str(),
+              line_number, line.c_str());
+      return false;
+    }
+    events.push_back(event);
+  }
+  return true;
+}
+
+std::vector<InputEvent> InputScript::take(unsigned int tick) {
+  std::vector<InputEvent> due;
+  while (next < events.size() && events[next].tick <= tick) {
+    due.push_back(events[next++]);
+  }
+  return due;
+}
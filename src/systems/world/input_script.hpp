@@ -0,0 +1,46 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "common.hpp"
+
+// One window input callback, delivered at the start of a simulation tick
+struct InputEvent {
+  enum class Type { KEY, MOUSE_CLICK, MOUSE_MOVE, MOUSE_SCROLL };
+
+  unsigned int tick = 0;
+  Type         type;
+  int          code   = 0;  // key or mouse button
+  int          action = 0;  // GLFW_PRESS / GLFW_RELEASE
+  int          mods   = 0;
+  vec2         pos    = vec2(0.f);  // cursor position or scroll offset
+};
+
+// Input for runs without a window, read from a text file with one event per
+// line, ordered by tick:
+//
+//   # tick  event   arguments
+//   0       move    640 360
+//   30      key     87 1 0       (key action mods)
+//   90      key     87 0 0
+//   120     click   0 1 0        (button action mods)
+//   125     scroll  0 1          (x y)
+//
+// Blank lines and lines starting with # are ignored.
+class InputScript {
+  std::vector<InputEvent> events;
+  size_t                  next = 0;
+
+public:
+  // Returns false and prints the offending line if the file can't be parsed
+  bool load(const std::string& path);
+
+  void add(const InputEvent& event) { events.push_back(event); }
+
+  // The events of the given tick, in file order. Ticks have to be asked for
+  // in increasing order.
+  std::vector<InputEvent> take(unsigned int tick);
+
+  bool done() const { return next >= events.size(); }
+};
@@ -0,0 +1,227 @@
+#include "simulation.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include "audio_system.hpp"
+#include "damage.hpp"
+#include "debuff.hpp"
+#include "ecs_command_buffer.hpp"
+#include "ecs_scheduler.hpp"
+#include "enemy_util.hpp"
+#include "level_builder.hpp"
+#include "level_system.hpp"
+#include "player_hud.hpp"
+#include "profiler.hpp"
+#include "random.hpp"
+#include "render_system.hpp"
+#include "saving_system.hpp"
+#include "tiny_ecs_registry.hpp"
+
+using Clock = std::chrono::high_resolution_clock;
+
+static bool is_frozen_state() {
+  return is_intro || is_start || is_paused || is_krab_cutscene ||
+         is_sharkman_cutscene || is_cthulhu_cutscene || is_death || is_end ||
+         room_transitioning;
+}
+
+namespace {
+// What the systems of the frame step, set before every run
+struct Frame {
+  WorldSystem*     world      = nullptr;
+  AISystem*        ai         = nullptr;
+  PhysicsSystem*   physics    = nullptr;
+  CollisionSystem* collisions = nullptr;
+  float            tick_ms    = 0.f;
+  bool             frozen     = false;  // as the frame started
+};
+Frame frame;
+}  // namespace
+
+// The systems of a frame. Most of them create and destroy entities or draw
+// random numbers and run on their own, the boids steering and the timers run
+// side by side. The timers used to run in the middle of the world step, none
+// of the systems they now follow touch their components.
+static void add_frame_systems(SystemScheduler& scheduler) {
+  // Debuffs restore velocities and swap weapons on expiry
+  scheduler.add("debuffs", SystemAccess().exclusive(), [](ECSCommandBuffer&) {
+    if (!frame.frozen) update_debuffs(frame.tick_ms);
+  });
+  // Whether the world froze is only known once it has stepped
+  scheduler.add("world", SystemAccess().exclusive(), [](ECSCommandBuffer&) {
+    frame.world->step(frame.tick_ms);
+    registry_commands.flush();
+  });
+  scheduler.add("ai", SystemAccess().exclusive(), [](ECSCommandBuffer&) {
+    if (!is_frozen_state()) frame.ai->step_behaviours(frame.tick_ms);
+  });
+
+  scheduler.add("boids",
+                SystemAccess()
+                    .reads<Group, TracksPlayer, TracksPlayerRanged,
+                           ActiveWall>()
+                    .writes<Position, Motion, EntityGroup>(),
+                [](ECSCommandBuffer&) {
+                  if (!is_frozen_state()) frame.ai->steer_groups(frame.tick_ms);
+                });
+  scheduler.add("attack_cooldowns", SystemAccess().writes<ModifyOxygenCD>(),
+                [](ECSCommandBuffer&) {
+                  if (!frame.frozen) update_attack(frame.tick_ms);
+                });
+  scheduler.add("damage_indicators", SystemAccess().writes<Attacked>(),
+                [](ECSCommandBuffer& commands) {
+                  if (!frame.frozen) {
+                    update_collision_timers(frame.tick_ms, commands);
+                  }
+                });
+  scheduler.add("notifications", SystemAccess().writes<Notification>(),
+                [](ECSCommandBuffer&) {
+                  if (!frame.frozen) update_notification_timers(frame.tick_ms);
+                });
+
+  scheduler.add("ai_attacks", SystemAccess().exclusive(),
+                [](ECSCommandBuffer&) {
+                  if (!is_frozen_state()) frame.ai->step_attacks(frame.tick_ms);
+                });
+  scheduler.add("physics", SystemAccess().exclusive(), [](ECSCommandBuffer&) {
+    if (is_frozen_state()) return;
+    frame.physics->step(frame.tick_ms);
+    registry_commands.flush();
+  });
+  scheduler.add("collisions", SystemAccess().exclusive(),
+                [](ECSCommandBuffer&) {
+                  if (is_frozen_state()) return;
+                  frame.collisions->step(frame.tick_ms);
+                  registry_commands.flush();
+                });
+}
+
+void step_simulation(WorldSystem& world, AISystem& ai, PhysicsSystem& physics,
+                     CollisionSystem& collisions, float tick_ms) {
+  PROFILE_SCOPE("tick");
+  // built on the first frame, the later ones only run it
+  static SystemScheduler scheduler;
+  if (scheduler.size() == 0) {
+    add_frame_systems(scheduler);
+  }
+  // changes from here on are stamped with the new frame
+  registry.advance_frame();
+  frame = {&world, &ai, &physics, &collisions, tick_ms, is_frozen_state()};
+  scheduler.run();
+}
+
+// FNV-1a over every position, in component order. Any divergence between two
+// runs moves something sooner or later.
+static uint32_t state_checksum() {
+  uint32_t hash = 2166136261u;
+  auto     mix  = [&hash](const void* data, size_t bytes) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < bytes; i++) {
+      hash = (hash ^ p[i]) * 16777619u;
+    }
+  };
+  const PositionArrays& positions = registry.positions.components;
+  mix(positions.position.data(), positions.position.size() * sizeof(vec2));
+  mix(positions.angle.data(), positions.angle.size() * sizeof(float));
+  return hash;
+}
+
+int run_headless(const HeadlessOptions& options, HeadlessResult* result) {
+  WorldSystem     world;
+  RenderSystem    renderer;
+  AISystem        ai;
+  PhysicsSystem   physics;
+  AudioSystem     audios;
+  CollisionSystem collisions;
+  LevelSystem     level;
+
+  // straight into the game unless replaying, there is nobody to watch the
+  // menu or the intro
+  Recording session;
+  session.seed    = options.seed;
+  session.tick_ms = 1000.f / SIM_TICK_RATE;
+  unsigned int ticks = options.ticks;
+
+  InputScript input;
+  if (!options.replay_path.empty()) {
+    if (!load_recording(options.replay_path, session)) {
+      return EXIT_FAILURE;
+    }
+    for (const InputEvent& event : session.events) input.add(event);
+    ticks = session.ticks();
+  } else if (!options.input_path.empty() &&
+             !input.load(options.input_path)) {
+    return EXIT_FAILURE;
+  }
+
+  renderer.init_headless();
+  audios.init_headless();
+
+  if (session.seed == 0) {
+    setGlobalRandomSeed();
+  } else {
+    setGlobalSeed(session.seed);
+  }
+  session.seed = getGlobalRandomSeed();
+
+  LevelBuilder level_builder = LevelBuilder();
+  level_builder.generate_random_level();
+
+  init_save_system(&level_builder, &level, &renderer);
+  level.init(&renderer, &level_builder);
+  collisions.init(&renderer, &level);
+  world.init(&renderer, &level);
+  ai.init(&renderer);
+
+  if (session.load_from_save) {
+    load_game_from_file();
+  }
+  is_start = session.is_start;
+  is_intro = session.is_intro;
+
+  InputRecorder recorder;
+  if (!options.record_path.empty() &&
+      !recorder.open(options.record_path, session)) {
+    return EXIT_FAILURE;
+  }
+
+  const float  tick_ms       = session.tick_ms;
+  auto         start         = Clock::now();
+  unsigned int tick          = 0;
+  size_t       peak_entities = registry.positions.size();
+  for (; tick < ticks && !is_end; tick++) {
+    for (const InputEvent& event : input.take(tick)) {
+      recorder.record(event);
+      world.handle_input(event);
+    }
+    step_simulation(world, ai, physics, collisions, tick_ms);
+    audios.step(tick_ms);
+    recorder.end_tick();
+    recorder.end_frame(1, tick_ms);
+    peak_entities = std::max(peak_entities, registry.positions.size());
+  }
+
+  float elapsed_ms =
+      (float)(std::chrono::duration_cast<std::chrono::microseconds>(
+                  Clock::now() - start))
+          .count() /
+      1000;
+  printf("Headless: %u ticks in %.1f ms (%.0f ticks/s), %zu entities\n", tick,
+         elapsed_ms, tick / (elapsed_ms / 1000.f),
+         registry.positions.size());
+  uint32_t checksum = state_checksum();
+  printf("Headless: seed %u, state checksum %08x\n", session.seed, checksum);
+
+  if (result != nullptr) {
+    result->ticks         = tick;
+    result->elapsed_ms    = elapsed_ms;
+    result->entities      = registry.positions.size();
+    result->peak_entities = peak_entities;
+    result->checksum      = checksum;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "ai_system.hpp"
+#include "collision_system.hpp"
+#include "physics_system.hpp"
+#include "world_system.hpp"
+
+// Advances the game by one fixed tick of tick_ms. Shared by the windowed
+// loop in main() and by headless runs, so both simulate exactly the same way.
+void step_simulation(WorldSystem& world, AISystem& ai, PhysicsSystem& physics,
+                     CollisionSystem& collisions, float tick_ms);
+
+struct HeadlessOptions {
+  unsigned int seed  = 0;     // 0 picks a random seed
+  unsigned int ticks = 3600;  // a minute of game time at 60 Hz
+  std::string  input_path;    // optional InputScript, see input_script.hpp
+  std::string  record_path;   // optional, writes the session as a Recording
+  std::string  replay_path;   // optional Recording, overrides all of the above
+};
+
+// What a headless run did, for tools driving it (see bench/perf_check.cpp)
+struct HeadlessResult {
+  unsigned int ticks         = 0;
+  float        elapsed_ms    = 0.f;
+  size_t       entities      = 0;  // with a position, at the end
+  size_t       peak_entities = 0;  // the most at the end of any tick
+  uint32_t     checksum      = 0;
+};
+
+// Plays a level without a window, GL or audio device: a null renderer and null
+// audio stand in for them and the ticks run back to back, as fast as the
+// machine allows. Input comes from the script or the recording, if any.
+// Prints a checksum of the final state, equal across runs of the same
+// recording, and fills in result if given. Returns the exit code.
+int run_headless(const HeadlessOptions& options,
+                 HeadlessResult*        result = nullptr);
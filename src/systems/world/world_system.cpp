@@ -7,6 +7,7 @@
 #include "consumable_utils.hpp"
 #include "death.hpp"
 #include "debuff.hpp"
+#include "ecs_command_buffer.hpp"
 #include "enemy_factories.hpp"
 #include "enemy_util.hpp"
 #include "level_spawn.hpp"
@@ -17,6 +18,7 @@
 #include "player_controls.hpp"
 #include "player_factories.hpp"
 #include "player_hud.hpp"
+#include "profiler.hpp"
 #include "saving_system.hpp"
 #include "spawning.hpp"
 #include "text_factories.hpp"
@@ -42,6 +44,39 @@ static std::stringstream title_ss;
 static int               fps       = 0;
 static float             fps_timer = 0;
 
+// Game state shared between the systems
+bool   krab_boss_encountered = false;
+bool   sharkman_encountered  = false;
+bool   is_intro              = false;
+bool   is_start              = false;
+bool   is_paused             = false;
+bool   is_krab_cutscene      = false;
+bool   is_sharkman_cutscene  = false;
+bool   is_cthulhu_cutscene   = false;
+bool   is_death              = false;
+bool   is_end                = false;
+Entity overlay;
+bool   room_transitioning = false;
+Entity rt_entity;
+
+Entity player;
+
+// Consumable Entities
+Entity      player_weapon;
+Entity      player_projectile;
+Entity      harpoon;
+Entity      net;
+Entity      concussive;
+Entity      torpedo;
+Entity      shrimp;
+PROJECTILES wep_type;
+
+Entity harpoon_gun;
+Entity net_gun;
+Entity concussive_gun;
+Entity torpedo_gun;
+Entity shrimp_gun;
+
 // create the underwater world
 WorldSystem::WorldSystem() : oxygen_timer(PLAYER_OXYGEN_DEPLETE_TIME_MS) {}
 
@@ -50,7 +85,9 @@ WorldSystem::~WorldSystem() {
   registry.clear_all_components();
 
   // Close the window
-  glfwDestroyWindow(window);
+  if (window) {
+    glfwDestroyWindow(window);
+  }
 }
 
 // Debugging
@@ -97,17 +134,34 @@ GLFWwindow* WorldSystem::create_window() {
   // Input is handled using GLFW, for more info see
   // http://www.glfw.org/docs/latest/input_guide.html
   glfwSetWindowUserPointer(window, this);
+  // Everything goes through on_window_input, so that it can be recorded
   auto key_redirect = [](GLFWwindow* wnd, int _0, int _1, int _2, int _3) {
-    ((WorldSystem*)glfwGetWindowUserPointer(wnd))->on_key(_0, _1, _2, _3);
+    InputEvent event;
+    event.type   = InputEvent::Type::KEY;
+    event.code   = _0;
+    event.action = _2;
+    event.mods   = _3;
+    ((WorldSystem*)glfwGetWindowUserPointer(wnd))->on_window_input(event);
   };
   auto cursor_pos_redirect = [](GLFWwindow* wnd, double _0, double _1) {
-    ((WorldSystem*)glfwGetWindowUserPointer(wnd))->on_mouse_move({_0, _1});
+    InputEvent event;
+    event.type = InputEvent::Type::MOUSE_MOVE;
+    event.pos  = {_0, _1};
+    ((WorldSystem*)glfwGetWindowUserPointer(wnd))->on_window_input(event);
   };
   auto mouse_redirect = [](GLFWwindow* wnd, int _0, int _1, int _2) {
-    ((WorldSystem*)glfwGetWindowUserPointer(wnd))->on_mouse_click(_0, _1, _2);
+    InputEvent event;
+    event.type   = InputEvent::Type::MOUSE_CLICK;
+    event.code   = _0;
+    event.action = _1;
+    event.mods   = _2;
+    ((WorldSystem*)glfwGetWindowUserPointer(wnd))->on_window_input(event);
   };
   auto scroll_redirect = [](GLFWwindow* wnd, double _0, double _1) {
-    ((WorldSystem*)glfwGetWindowUserPointer(wnd))->on_mouse_scroll(_0, _1);
+    InputEvent event;
+    event.type = InputEvent::Type::MOUSE_SCROLL;
+    event.pos  = {_0, _1};
+    ((WorldSystem*)glfwGetWindowUserPointer(wnd))->on_window_input(event);
   };
   glfwSetKeyCallback(window, key_redirect);
   glfwSetCursorPosCallback(window, cursor_pos_redirect);
@@ -141,9 +195,7 @@ void WorldSystem::update_fps(float elapsed_ms_since_last_update) {
 
 // Update our game world
 bool WorldSystem::step(float elapsed_ms_since_last_update) {
-  // Updating window title
-  update_fps(elapsed_ms_since_last_update);
-
+  PROFILE_SCOPE("world.step");
   // Remove debug info from the last step
   while (registry.debugComponents.entities.size() > 0)
     registry.remove_all_components_of(registry.debugComponents.entities.back());
@@ -166,18 +218,18 @@ bool WorldSystem::step(float elapsed_ms_since_last_update) {
 
     for (Entity cursor : registry.cursors.entities) {
       if (registry.positions.has(cursor)) {
-        Position& cursor_pos = registry.positions.get(cursor);
-        cursor_pos.position  = vec2((float)mouse_pos.x, (float)mouse_pos.y);
+        PositionRef cursor_pos = registry.positions.get_mut(cursor);
+        cursor_pos.position    = vec2((float)mouse_pos.x, (float)mouse_pos.y);
       }
     }
 
     // Geyser bubbles
     for (Entity entity : registry.geysers.entities) {
-      Geyser& timer = registry.geysers.get(entity);
+      Geyser& timer = registry.geysers.get_mut(entity);
       timer.bubble_timer -= elapsed_ms_since_last_update;
       if (timer.bubble_timer <= 0.f) {
-        timer.bubble_timer = BUBBLE_INTERVAL;
-        Position& pos      = registry.positions.get(entity);
+        timer.bubble_timer   = BUBBLE_INTERVAL;
+        ConstPositionRef pos = registry.positions.get(entity);
         createGeyserBubble(renderer, {pos.position.x + randomFloat(-10.f, 10.f),
                                       pos.position.y});
       }
@@ -185,19 +237,19 @@ bool WorldSystem::step(float elapsed_ms_since_last_update) {
 
     // Torpedo Explosion VFX
     for (Entity entity : registry.explosions.entities) {
-      Explosion& timer = registry.explosions.get(entity);
+      Explosion& timer = registry.explosions.get_mut(entity);
       timer.timer += elapsed_ms_since_last_update;
       if (timer.timer >= timer.expiry_time) {
-        registry.remove_all_components_of(entity);
+        registry_commands.destroy(entity);
       } else {
-        Position& pos = registry.positions.get(entity);
+        PositionRef pos = registry.positions.get_mut(entity);
         pos.scale = vec2(timer.timer / timer.expiry_time) * timer.full_scale;
       }
     }
 
     // Enemy Projectiles
     for (Entity entity : registry.enemyProjectiles.entities) {
-      EnemyProjectile& enemy_proj = registry.enemyProjectiles.get(entity);
+      EnemyProjectile& enemy_proj = registry.enemyProjectiles.get_mut(entity);
       if (enemy_proj.has_timer) {
         enemy_proj.timer -= elapsed_ms_since_last_update;
         if (enemy_proj.timer < 0.f) {
@@ -205,16 +257,11 @@ bool WorldSystem::step(float elapsed_ms_since_last_update) {
             createOxygenCanisterPos(
                 renderer, registry.positions.get(entity).position, false);
           }
-          registry.remove_all_components_of(entity);
+          registry_commands.destroy(entity);
         }
       }
     }
 
-    update_debuffs(elapsed_ms_since_last_update);
-    update_attack(elapsed_ms_since_last_update);
-    update_collision_timers(elapsed_ms_since_last_update);
-    update_notification_timers(elapsed_ms_since_last_update);
-
     // Deplete oxygen when it is time...
     oxygen_timer = oxygen_drain(oxygen_timer, elapsed_ms_since_last_update);
 
@@ -227,7 +274,7 @@ bool WorldSystem::step(float elapsed_ms_since_last_update) {
     float min_counter_ms = 4000.f;
     for (Entity entity : registry.deathTimers.entities) {
       // progress timer
-      DeathTimer& counter = registry.deathTimers.get(entity);
+      DeathTimer& counter = registry.deathTimers.get_mut(entity);
       counter.counter_ms -= elapsed_ms_since_last_update;
       // player or cthulhu death trigger fade to black
       bool is_cthulhu =
@@ -251,22 +298,22 @@ bool WorldSystem::step(float elapsed_ms_since_last_update) {
           } else {
             is_end = true;
             // remove cthulhu
-            registry.remove_all_components_of(entity);
+            registry_commands.destroy(entity);
           }
           overlay_transitioning = true;
           return true;
         } else if (registry.drops.has(entity) &&
                    registry.positions.has(entity)) {
-          Drop&     drop = registry.drops.get(entity);
-          Position& pos  = registry.positions.get(entity);
+          const Drop&      drop = registry.drops.get(entity);
+          ConstPositionRef pos  = registry.positions.get(entity);
 
           auto fn     = drop.dropFn;
           vec2 newPos = pos.position;
-          registry.remove_all_components_of(entity);
+          registry_commands.destroy(entity);
 
           fn(renderer, newPos, false);
         } else {
-          registry.remove_all_components_of(entity);
+          registry_commands.destroy(entity);
         }
       }
     }
@@ -477,10 +524,11 @@ bool WorldSystem::step(float elapsed_ms_since_last_update) {
 
 // Temporary
 void WorldSystem::check_bounds() {
-  Position& player_position      = registry.positions.get(player);
-  Position& player_proj_position = registry.positions.get(player_projectile);
+  PositionRef      player_position = registry.positions.get_mut(player);
+  ConstPositionRef player_proj_position =
+      registry.positions.get(player_projectile);
   PlayerProjectile& player_proj =
-      registry.playerProjectiles.get(player_projectile);
+      registry.playerProjectiles.get_mut(player_projectile);
   float vertical   = player_position.scale.y / 2.0f;
   float horizontal = player_position.scale.x / 2.0f;
 
@@ -736,3 +784,30 @@ void WorldSystem::on_mouse_scroll(double xOffset, double yOffset) {
 void WorldSystem::on_mouse_move(vec2 mouse_position) {
   mouse_pos = mouse_position;
 }
+
+void WorldSystem::on_window_input(const InputEvent& event) {
+  if (replaying_input) {
+    return;
+  }
+  if (recorder) {
+    recorder->record(event);
+  }
+  handle_input(event);
+}
+
+void WorldSystem::handle_input(const InputEvent& event) {
+  switch (event.type) {
+    case InputEvent::Type::KEY:
+      on_key(event.code, 0, event.action, event.mods);
+      break;
+    case InputEvent::Type::MOUSE_CLICK:
+      on_mouse_click(event.code, event.action, event.mods);
+      break;
+    case InputEvent::Type::MOUSE_MOVE:
+      on_mouse_move(event.pos);
+      break;
+    case InputEvent::Type::MOUSE_SCROLL:
+      on_mouse_scroll(event.pos.x, event.pos.y);
+      break;
+  }
+}
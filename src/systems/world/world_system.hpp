@@ -6,6 +6,7 @@
 // stlib
 #include <vector>
 
+#include "input_recording.hpp"
 #include "world_state.hpp"
 #include "level_system.hpp"
 #include "render_system.hpp"
@@ -13,6 +14,12 @@
 // Loop Duration
 #define LOOP_DURATION 500.f
 
+// The simulation advances in fixed ticks of 1000 / SIM_TICK_RATE ms,
+// independent of the frame rate. After a long frame at most
+// MAX_SIM_STEPS_PER_FRAME ticks are run to catch up, the rest is dropped.
+#define SIM_TICK_RATE 60.f
+#define MAX_SIM_STEPS_PER_FRAME 5
+
 // Container for all our entities and game logic. Individual rendering / update
 // is deferred to the relative update() methods
 class WorldSystem {
@@ -34,6 +41,18 @@ class WorldSystem {
   // Should the game be over ?
   bool is_over() const;
 
+  // Shows the frame rate in the window title, once per rendered frame
+  void update_fps(float elapsed_ms_since_last_update);
+
+  // Delivers input as if it came from the window, for runs driven by a
+  // script or a recording instead
+  void handle_input(const InputEvent& event);
+
+  // Input from the window is logged here when set, and dropped altogether
+  // while a recording is replayed
+  InputRecorder* recorder        = nullptr;
+  bool           replaying_input = false;
+
   bool          game_started = false;
   bool          load_from_save = false;
   private:
@@ -42,14 +61,14 @@ class WorldSystem {
   void on_mouse_click(int button, int action, int mods);
   void on_mouse_scroll(double xOffset, double yOffset);
   void on_mouse_move(vec2 pos);
+  void on_window_input(const InputEvent& event);
   void check_bounds();
-  void update_fps(float elapsed_ms_since_last_update);
 
   // restart level
   void restart_game();
 
-  // OpenGL window handle
-  GLFWwindow* window;
+  // OpenGL window handle, null when running headless
+  GLFWwindow* window = nullptr;
 
   // Number of fish eaten by the salmon, displayed in the window title
   unsigned int points;
@@ -19,10 +19,10 @@ Entity createOverlay(RenderSystem* renderer) {
   registry.meshPtrs.emplace(overlay, &mesh);
 
   // Setting initial position values
-  Position& position = registry.positions.emplace(overlay);
-  position.position  = vec2(window_width_px / 2.f, window_height_px / 2.f);
-  position.angle     = 0.f;
-  position.scale     = vec2(window_width_px, window_height_px);
+  PositionRef position = registry.positions.emplace(overlay);
+  position.position    = vec2(window_width_px / 2.f, window_height_px / 2.f);
+  position.angle       = 0.f;
+  position.scale       = vec2(window_width_px, window_height_px);
 
   registry.overlays.emplace(overlay);
 
@@ -81,7 +81,7 @@ void roomTransitionState(RenderSystem* renderer, ScreenState& screen,
                      0.001f * elapsed_ms_since_last_update);
   } else if (screen.darken_screen_factor >= 1.f &&
              registry.roomTransitions.has(rt_entity)) {
-    RoomTransition& roomTransition = registry.roomTransitions.get(rt_entity);
+    RoomTransition& roomTransition = registry.roomTransitions.get_mut(rt_entity);
     //grab room id before it gets updated to next room.
     std::string prev_room_id = level->current_room_editor_id;
     level->enter_room(roomTransition.door_connection);
@@ -0,0 +1,14 @@
+#include "command_line.hpp"
+
+#include <cstdlib>
+#include <limits>
+
+bool parse_uint(const char* arg, unsigned int& out) {
+  char*         end;
+  unsigned long value = std::strtoul(arg, &end, 10);
+  if (*end != '\0' || value > std::numeric_limits<unsigned int>::max()) {
+    return false;
+  }
+  out = static_cast<unsigned int>(value);
+  return true;
+}
@@ -0,0 +1,5 @@
+#pragma once
+// Helpers for reading command line arguments
+
+// Converts a command line argument to an unsigned int, false if it isn't one
+bool parse_uint(const char* arg, unsigned int& out);
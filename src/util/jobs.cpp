@@ -0,0 +1,209 @@
+#include "jobs.hpp"
+
+#include <cassert>
+#include <cstdint>
+
+namespace {
+// Index of the calling thread's queue, set for the workers as they start
+thread_local size_t worker_queue = SIZE_MAX;
+
+thread_local const void* current_owner = nullptr;
+}  // namespace
+
+const void* job_owner() { return current_owner; }
+
+void set_job_owner(const void* owner) { current_owner = owner; }
+
+TaskGraph::TaskId TaskGraph::add(std::function<void()> task, Lane lane) {
+  Task t;
+  t.run  = std::move(task);
+  t.lane = lane;
+  tasks.push_back(std::move(t));
+  return tasks.size() - 1;
+}
+
+void TaskGraph::precede(TaskId before, TaskId after) {
+  assert(before < after && after < tasks.size() &&
+         "tasks can only wait on tasks added before them");
+  tasks[before].successors.push_back(after);
+  tasks[after].predecessors++;
+}
+
+JobSystem::JobSystem(unsigned int worker_count)
+    : main_thread(std::this_thread::get_id()) {
+  for (unsigned int i = 0; i <= worker_count; i++) {
+    queues.emplace_back(new Queue());
+  }
+  for (unsigned int i = 0; i < worker_count; i++) {
+    workers.emplace_back(&JobSystem::work, this, i);
+  }
+}
+
+JobSystem::~JobSystem() {
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex);
+    stopping = true;
+  }
+  wake.notify_all();
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+}
+
+size_t JobSystem::own_queue() const {
+  // the main thread, and any other that isn't a worker, shares the last one
+  return worker_queue == SIZE_MAX ? workers.size() : worker_queue;
+}
+
+void JobSystem::push(std::function<void()> job) {
+  Queue& queue = *queues[own_queue()];
+  {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.jobs.push_back({std::move(job), current_owner});
+  }
+  queued.fetch_add(1, std::memory_order_release);
+  // taking the lock orders this with a worker about to sleep, so it can't
+  // miss the job
+  { std::lock_guard<std::mutex> lock(sleep_mutex); }
+  wake.notify_one();
+}
+
+bool JobSystem::pop(size_t own, Job& job) {
+  // newest of our own first, it is the most likely to be in cache
+  {
+    Queue&                      queue = *queues[own];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.jobs.empty()) {
+      job = std::move(queue.jobs.back());
+      queue.jobs.pop_back();
+      queued.fetch_sub(1, std::memory_order_relaxed);
+      return true;
+    }
+  }
+  // then the oldest of someone else's, the biggest piece of their work
+  for (size_t i = 1; i < queues.size(); i++) {
+    Queue&                      queue = *queues[(own + i) % queues.size()];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.jobs.empty()) {
+      job = std::move(queue.jobs.front());
+      queue.jobs.pop_front();
+      queued.fetch_sub(1, std::memory_order_relaxed);
+      return true;
+    }
+  }
+  return false;
+}
+
+void JobSystem::run_job(Job& job) {
+  const void* outer = current_owner;
+  current_owner     = job.owner;
+  job.run();
+  current_owner = outer;
+}
+
+void JobSystem::work(size_t queue) {
+  worker_queue = queue;
+  Job job;
+  while (true) {
+    if (pop(queue, job)) {
+      run_job(job);
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(sleep_mutex);
+    wake.wait(lock, [this] {
+      return stopping || queued.load(std::memory_order_acquire) > 0;
+    });
+    if (stopping) {
+      return;
+    }
+  }
+}
+
+void JobSystem::wait(const std::atomic<size_t>& remaining) {
+  bool on_main = std::this_thread::get_id() == main_thread;
+  Job  job;
+  while (remaining.load(std::memory_order_acquire) > 0) {
+    if (on_main) {
+      std::unique_lock<std::mutex> lock(main_lane.mutex);
+      if (!main_lane.jobs.empty()) {
+        job = std::move(main_lane.jobs.front());
+        main_lane.jobs.pop_front();
+        lock.unlock();
+        run_job(job);
+        continue;
+      }
+    }
+    if (pop(own_queue(), job)) {
+      run_job(job);
+      continue;
+    }
+    // the last jobs are running elsewhere, they are short
+    std::this_thread::yield();
+  }
+}
+
+void JobSystem::schedule(TaskGraph& graph, TaskGraph::TaskId id) {
+  std::function<void()> job = [this, &graph, id] {
+    graph.tasks[id].run();
+    for (TaskGraph::TaskId next : graph.tasks[id].successors) {
+      if (graph.waiting[next].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        schedule(graph, next);
+      }
+    }
+    graph.remaining.fetch_sub(1, std::memory_order_release);
+  };
+  if (graph.tasks[id].lane == TaskGraph::Lane::MAIN) {
+    run_on_main(std::move(job));
+  } else {
+    push(std::move(job));
+  }
+}
+
+void JobSystem::run(TaskGraph& graph) {
+  assert(std::this_thread::get_id() == main_thread);
+  size_t count = graph.tasks.size();
+  // graphs run every frame keep their counters
+  if (graph.waiting_size != count) {
+    graph.waiting.reset(new std::atomic<unsigned int>[count]);
+    graph.waiting_size = count;
+  }
+  for (size_t i = 0; i < count; i++) {
+    graph.waiting[i].store(graph.tasks[i].predecessors,
+                           std::memory_order_relaxed);
+  }
+  graph.remaining.store(count, std::memory_order_relaxed);
+
+  for (size_t i = 0; i < count; i++) {
+    if (graph.tasks[i].predecessors == 0) {
+      schedule(graph, i);
+    }
+  }
+  wait(graph.remaining);
+}
+
+void JobSystem::run_on_main(std::function<void()> job) {
+  std::lock_guard<std::mutex> lock(main_lane.mutex);
+  main_lane.jobs.push_back({std::move(job), current_owner});
+}
+
+void JobSystem::run_main_jobs() {
+  assert(std::this_thread::get_id() == main_thread);
+  Job job;
+  while (true) {
+    {
+      std::lock_guard<std::mutex> lock(main_lane.mutex);
+      if (main_lane.jobs.empty()) {
+        return;
+      }
+      job = std::move(main_lane.jobs.front());
+      main_lane.jobs.pop_front();
+    }
+    run_job(job);
+  }
+}
+
+JobSystem& jobs() {
+  static JobSystem jobs(std::max(std::thread::hardware_concurrency(), 1u) -
+                        1);
+  return jobs;
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Worker threads shared by every system, so none of them has to start its
+// own. Work is queued per thread: a thread takes its newest job first, and
+// when it runs dry steals the oldest job of another. A thread waiting for
+// jobs to finish runs queued ones meanwhile instead of blocking, e.g.
+//
+//   jobs().parallel_for(0, groups.size(), 4, [&](size_t begin, size_t end) {
+//     for (size_t i = begin; i < end; i++) steer(groups[i]);
+//   });
+//
+// Jobs run in any order and on any thread, they must not touch the same
+// components. Keep PROFILE_SCOPE out of them too, it takes the profiler's lock
+// and chunks are far too short for that. To keep runs deterministic, jobs
+// write to their own slots and the caller merges the results in index order
+// afterwards.
+
+class JobSystem;
+
+// What the calling thread is working for, nullptr if nothing in particular,
+// e.g. the system a SystemScheduler runs. Jobs keep the owner of the thread
+// that queued them wherever they run, so a parallel_for chunk on a worker, or
+// a job some other thread picks up while it waits, still counts as work of
+// whoever queued it.
+const void* job_owner();
+void        set_job_owner(const void* owner);
+
+// Tasks and the order they must run in, run by JobSystem::run()
+class TaskGraph {
+public:
+  using TaskId = size_t;
+
+  // MAIN tasks run on the main thread only, for the likes of GL calls
+  enum class Lane { ANY, MAIN };
+
+  TaskId add(std::function<void()> task, Lane lane = Lane::ANY);
+  // after starts once before has finished. Tasks only wait on tasks added
+  // before them, which rules out cycles.
+  void precede(TaskId before, TaskId after);
+
+  size_t size() const { return tasks.size(); }
+
+private:
+  friend class JobSystem;
+
+  struct Task {
+    std::function<void()> run;
+    Lane                  lane;
+    std::vector<TaskId>   successors;
+    unsigned int          predecessors = 0;
+  };
+  std::vector<Task> tasks;
+
+  // State of a run, predecessors still to finish per task
+  std::unique_ptr<std::atomic<unsigned int>[]> waiting;
+  size_t                                       waiting_size = 0;
+  std::atomic<size_t>                          remaining{0};
+};
+
+class JobSystem {
+  struct Job {
+    std::function<void()> run;
+    const void*           owner;  // of the thread that queued it
+  };
+
+  struct Queue {
+    std::mutex      mutex;
+    std::deque<Job> jobs;
+  };
+
+  std::vector<std::thread>            workers;
+  std::vector<std::unique_ptr<Queue>> queues;  // one per worker, then main's
+  Queue                               main_lane;
+  std::thread::id                     main_thread;
+
+  // Jobs in the queues, workers sleep while there are none
+  std::atomic<size_t>     queued{0};
+  std::mutex              sleep_mutex;
+  std::condition_variable wake;
+  bool                    stopping = false;
+
+  size_t own_queue() const;
+  void   push(std::function<void()> job);
+  bool   pop(size_t queue, Job& job);
+  void   run_job(Job& job);
+  void   work(size_t queue);
+  void   wait(const std::atomic<size_t>& remaining);
+  void   schedule(TaskGraph& graph, TaskGraph::TaskId id);
+
+public:
+  // The constructing thread is the main thread
+  explicit JobSystem(unsigned int worker_count);
+  ~JobSystem();
+
+  JobSystem(const JobSystem&)            = delete;
+  JobSystem& operator=(const JobSystem&) = delete;
+
+  // Threads that run jobs, the calling one included
+  unsigned int thread_count() const {
+    return (unsigned int)workers.size() + 1;
+  }
+
+  // Calls body(chunk_begin, chunk_end) over [begin, end) split into chunks of
+  // at least grain indices, and returns once all are done. Ranges of a
+  // single chunk run right here, small loops don't pay for the handoff.
+  template <class Body>
+  void parallel_for(size_t begin, size_t end, size_t grain, const Body& body);
+
+  // Runs every task of graph and returns once all have finished. A graph
+  // can be run again, e.g. every frame. Main thread only.
+  void run(TaskGraph& graph);
+
+  // Queues a job for the main thread, run the next time it waits on jobs or
+  // calls run_main_jobs()
+  void run_on_main(std::function<void()> job);
+  void run_main_jobs();
+};
+
+// Shared instance with a worker per core besides the main thread, created by
+// the first call (which must come from the main thread)
+JobSystem& jobs();
+
+template <class Body>
+void JobSystem::parallel_for(size_t begin, size_t end, size_t grain,
+                             const Body& body) {
+  if (end <= begin) {
+    return;
+  }
+  // a few chunks per thread balance out uneven ones
+  size_t count = end - begin;
+  size_t chunk = std::max({grain, (size_t)1, count / (thread_count() * 4)});
+  if (count <= chunk || workers.empty()) {
+    body(begin, end);
+    return;
+  }
+
+  std::atomic<size_t> remaining((count - 1) / chunk);
+  for (size_t lo = begin + chunk; lo < end; lo += chunk) {
+    size_t hi = std::min(lo + chunk, end);
+    push([&body, &remaining, lo, hi] {
+      body(lo, hi);
+      remaining.fetch_sub(1, std::memory_order_release);
+    });
+  }
+  body(begin, begin + chunk);
+  wait(remaining);
+}
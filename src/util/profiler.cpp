@@ -0,0 +1,121 @@
+#include "profiler.hpp"
+
+#ifdef BERMUDA_PROFILING
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+unsigned int Profiler::section(const char* name) {
+  std::lock_guard<std::mutex> lock(mutex);
+  for (unsigned int i = 0; i < sections.size(); i++) {
+    if (sections[i].name == name) {
+      return i;
+    }
+  }
+  Section section;
+  section.name = name;
+  section.window.resize(PROFILER_WINDOW);
+  sections.push_back(std::move(section));
+  return (unsigned int)sections.size() - 1;
+}
+
+void Profiler::record(unsigned int id, Clock::time_point start,
+                      Clock::time_point end) {
+  float ms = std::chrono::duration<float, std::milli>(end - start).count();
+  std::lock_guard<std::mutex> lock(mutex);
+  Section&                    section = sections[id];
+  section.window[section.next] = ms;
+  section.next    = (section.next + 1) % PROFILER_WINDOW;
+  section.samples = std::min(section.samples + 1, (unsigned)PROFILER_WINDOW);
+  section.calls++;
+  section.total_ms += ms;
+
+  if (tracing) {
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+    trace.push_back({id, std::this_thread::get_id(),
+                     duration_cast<microseconds>(start - epoch).count(),
+                     duration_cast<microseconds>(end - start).count()});
+  }
+}
+
+void Profiler::start_trace() {
+  std::lock_guard<std::mutex> lock(mutex);
+  tracing = true;
+  // about a minute of frames without growing
+  trace.reserve(64 * 1024);
+}
+
+bool Profiler::write_trace(const std::string& path) const {
+  std::ofstream file(path);
+  if (!file.is_open()) {
+    fprintf(stderr, "Failed to write trace %s\n", path.c_str());
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(mutex);
+  // Chrome's trace event format, one complete ("X") event per scope. Threads
+  // are numbered in the order they first show up, so the game loop is
+  // track 1.
+  std::vector<std::thread::id> threads;
+  file << "{\"traceEvents\":[\n";
+  for (size_t i = 0; i < trace.size(); i++) {
+    const TraceEvent& event = trace[i];
+    size_t tid = std::find(threads.begin(), threads.end(), event.thread) -
+                 threads.begin();
+    if (tid == threads.size()) {
+      threads.push_back(event.thread);
+    }
+    file << "{\"name\":\"" << sections[event.section].name
+         << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << tid + 1
+         << ",\"ts\":" << event.start_us
+         << ",\"dur\":" << event.duration_us << "}"
+         << (i + 1 < trace.size() ? ",\n" : "\n");
+  }
+  file << "],\"displayTimeUnit\":\"ms\"}\n";
+  return true;
+}
+
+std::vector<ProfileStats> Profiler::stats() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  std::vector<ProfileStats> result;
+  std::vector<float>        sorted;
+  for (const Section& section : sections) {
+    if (section.samples == 0) {
+      continue;
+    }
+    sorted.assign(section.window.begin(),
+                  section.window.begin() + section.samples);
+    std::sort(sorted.begin(), sorted.end());
+
+    float total = 0.f;
+    for (float ms : sorted) total += ms;
+
+    ProfileStats stats;
+    stats.name     = section.name;
+    stats.samples  = section.samples;
+    stats.min_ms   = sorted.front();
+    stats.avg_ms   = total / sorted.size();
+    stats.p99_ms   = sorted[(sorted.size() - 1) * 99 / 100];
+    stats.calls    = section.calls;
+    stats.total_ms = section.total_ms;
+    result.push_back(stats);
+  }
+  return result;
+}
+
+void Profiler::print_stats() const {
+  printf("%-24s %8s %8s %8s  (last %d samples, ms)\n", "section", "min",
+         "avg", "p99", PROFILER_WINDOW);
+  for (const ProfileStats& stats : this->stats()) {
+    printf("%-24s %8.3f %8.3f %8.3f\n", stats.name, stats.min_ms,
+           stats.avg_ms, stats.p99_ms);
+  }
+}
+
+Profiler& profiler() {
+  static Profiler profiler;
+  return profiler;
+}
+
+#endif
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Scoped timing of the game loop's systems, e.g.
+//
+//   void PhysicsSystem::step(float elapsed_ms) {
+//     PROFILE_SCOPE("physics.step");
+//     ...
+//
+// Every section keeps its last PROFILER_WINDOW durations for min/avg/p99
+// stats along with a running total, and optionally records each scope as a
+// Chrome trace event (open the file in chrome://tracing or ui.perfetto.dev).
+// Scopes may be recorded from any thread, e.g. the render thread's draws, and
+// each thread gets its own track in the trace.
+//
+// Built with BERMUDA_PROFILING, otherwise PROFILE_SCOPE expands to nothing
+// and none of this is compiled in.
+
+#define PROFILER_WINDOW 240  // samples, 4 seconds at 60 Hz
+
+struct ProfileStats {
+  const char*  name;
+  unsigned int samples;  // in the window
+  float        min_ms;
+  float        avg_ms;
+  float        p99_ms;
+  unsigned int calls;     // since the start
+  double       total_ms;  // since the start
+};
+
+#ifdef BERMUDA_PROFILING
+
+class Profiler {
+  using Clock = std::chrono::steady_clock;
+
+  struct Section {
+    const char*        name;
+    std::vector<float> window;  // ring of the last durations in ms
+    unsigned int       next     = 0;
+    unsigned int       samples  = 0;
+    unsigned int       calls    = 0;
+    double             total_ms = 0.0;
+  };
+
+  struct TraceEvent {
+    unsigned int    section;
+    std::thread::id thread;
+    long long       start_us;
+    long long       duration_us;
+  };
+
+  mutable std::mutex      mutex;  // guards everything below
+  std::vector<Section>    sections;
+  std::vector<TraceEvent> trace;
+  bool                    tracing = false;
+  Clock::time_point       epoch   = Clock::now();
+
+public:
+  // Id of the section with this name, creating it on first use. Names are
+  // compared by address, pass string literals.
+  unsigned int section(const char* name);
+
+  Clock::time_point now() const { return Clock::now(); }
+  void record(unsigned int section, Clock::time_point start,
+              Clock::time_point end);
+
+  // Keeps every scope from now on for write_trace()
+  void start_trace();
+  bool write_trace(const std::string& path) const;
+
+  std::vector<ProfileStats> stats() const;
+  void                      print_stats() const;
+};
+
+Profiler& profiler();
+
+// Times its own lifetime into a section
+class ProfileScope {
+  unsigned int                          section;
+  std::chrono::steady_clock::time_point start;
+
+public:
+  explicit ProfileScope(unsigned int section)
+      : section(section), start(profiler().now()) {}
+  ~ProfileScope() { profiler().record(section, start, profiler().now()); }
+};
+
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+// The section is looked up once per call site
+#define PROFILE_SCOPE(name)                                        \
+  static const unsigned int PROFILE_CONCAT(profile_section_,       \
+                                           __LINE__) =             \
+      profiler().section(name);                                    \
+  ProfileScope PROFILE_CONCAT(profile_scope_, __LINE__)(           \
+      PROFILE_CONCAT(profile_section_, __LINE__))
+
+#else
+
+#define PROFILE_SCOPE(name)
+
+#endif